@@ -24,7 +24,7 @@ set( configENABLE_BACKWARD_COMPATIBILITY      0U)
 
 set( configUSE_TICK_HOOK                      0U)
 set( configUSE_16_BIT_TICKS                   0U)
-set( configUSE_TICKLESS_IDLE                  0U)
+set( configUSE_TICKLESS_IDLE                  2U)
 set( configCPU_CLOCK_HZ                       "SystemCoreClock" )
 set( configTICK_RATE_HZ                       1000)
 
@@ -16,7 +16,7 @@ option( HAL_CRC_MODULE_ENABLED "Enable HAL CRC" OFF )
 option( HAL_PWR_MODULE_ENABLED "Enable HAL PWR" ON )
 option( HAL_FIREWALL_MODULE_ENABLED "Enable HAL FIREWALL" OFF )
 option( HAL_TIM_MODULE_ENABLED "Enable HAL TIM" ON )
-option( HAL_LPTIM_MODULE_ENABLED "Enable HAL LPTIM" OFF )
+option( HAL_LPTIM_MODULE_ENABLED "Enable HAL LPTIM" ON )
 option( HAL_IWDG_MODULE_ENABLED "Enable HAL IWDG" OFF )
 option( HAL_WWDG_MODULE_ENABLED "Enable HAL WWDG" OFF )
 option( HAL_SRAM_MODULE_ENABLED "Enable HAL SRAM" ON )    
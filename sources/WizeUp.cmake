@@ -14,6 +14,8 @@ add_compile_definitions(DUMP_CORE_HAS_TRACE=1)
 add_compile_definitions(DUMP_CORE_HAS_FAULT_STATUS_REGISTER=1)
 add_compile_definitions(L6VERS=L6VER_WIZE_REV_1_2)
 #add_compile_definitions(HAS_LPOWER=1)
+# Second radio on SPI2 (the board variant gives its pinout, see pin_cfg.h)
+#add_compile_definitions(HAS_SECOND_RADIO=1 ADF7030_1_NUM_DEV=2)
 
 add_compile_options(-Wall -ffunction-sections -fdata-sections -fstack-usage)
 
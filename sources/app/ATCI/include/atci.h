@@ -73,6 +73,7 @@
 #define FC_TX_PWR_m12dB_ID		0x02
 #define FC_PA_EN_ID				0x10
 #define FC_RSSI_CAL_ID			0x20
+#define FC_LINK_ADAPT_ID		0x30
 #define FC_ADF7030_CAL_ID		0xFC
 
 #define FC_TX_PWR_CFG_NB_VAL	3
@@ -141,6 +142,9 @@ typedef enum{
 	CMD_ATPING,
 	CMD_ATFC,
 	CMD_ATTEST,
+	CMD_ATNOISE,
+	CMD_ATBURST,
+	CMD_ATPER,
 
 	NB_AT_CMD //used to get number of commands
 }atci_cmd_code_t;
@@ -48,6 +48,9 @@
 #include "crypto.h"
 #include "storage.h"
 #include "phy_layer_private.h"
+#include "adf7030-1_phy_conv.h"
+#include "phy_server.h"
+#include "link_adapt.h"
 #include "phy_test.h"
 
 #include "FreeRTOS.h"
@@ -77,6 +80,9 @@ atci_status_t Exec_ATSEND_Cmd(atci_cmd_t *atciCmdData);
 atci_status_t Exec_ATPING_Cmd(atci_cmd_t *atciCmdData);
 atci_status_t Exec_ATFC_Cmd(atci_cmd_t *atciCmdData);
 atci_status_t Exec_ATTEST_Cmd(atci_cmd_t *atciCmdData);
+atci_status_t Exec_ATNOISE_Cmd(atci_cmd_t *atciCmdData);
+atci_status_t Exec_ATBURST_Cmd(atci_cmd_t *atciCmdData);
+atci_status_t Exec_ATPER_Cmd(atci_cmd_t *atciCmdData);
 
 
 /*=========================================================================================================
@@ -116,6 +122,9 @@ void Atci_Task(void const *argument)
 	Atci_Exec_Cmd[CMD_ATPING] = Exec_ATPING_Cmd;
 	Atci_Exec_Cmd[CMD_ATFC] = Exec_ATFC_Cmd;
 	Atci_Exec_Cmd[CMD_ATTEST] = Exec_ATTEST_Cmd;
+	Atci_Exec_Cmd[CMD_ATNOISE] = Exec_ATNOISE_Cmd;
+	Atci_Exec_Cmd[CMD_ATBURST] = Exec_ATBURST_Cmd;
+	Atci_Exec_Cmd[CMD_ATPER] = Exec_ATPER_Cmd;
 
 	EX_PHY_SetCpy();
 	//Loop
@@ -219,9 +228,9 @@ void Atci_Task(void const *argument)
 				Atci_Debug_Str("Sleep");
 				CLEAR_BIT(SysTick->CTRL, SysTick_CTRL_ENABLE_Msk);
 		        bPaState = Phy_GetPa();
-				Phy_OnOff(&sPhyDev, 0);
+				PhySrv_OnOff(&sPhyDev, 0);
 				BSP_LowPower_Enter(LP_STOP2_MODE);
-				Phy_OnOff(&sPhyDev, 1);
+				PhySrv_OnOff(&sPhyDev, 1);
 		        Phy_SetPa(bPaState);
 		        SET_BIT(SysTick->CTRL, SysTick_CTRL_ENABLE_Msk);
 #else
@@ -676,6 +685,10 @@ atci_status_t Exec_ATIDENT_Cmd(atci_cmd_t *atciCmdData)
 					return ATCI_ERR;
 				}
 				Atci_Debug_Param_Data("Write IDENT succeed", atciCmdData);/////////
+#if PHY_USE_ADDR_FILT
+				// Received frames are now filtered on the new address
+				Phy_SetAddrFilt(&sPhyDev, atciCmdData->params[0].data);
+#endif
 
 				return ATCI_OK;
 			}
@@ -901,6 +914,10 @@ atci_status_t Exec_ATPING_Cmd(atci_cmd_t *atciCmdData)
  *					- RSSI calibration (Apply Carrier at mid band frequency with -77dbm level): <id>
  *						<id> = 0x20
  *						There is no parameter, read will return an error
+ *					- Uplink modulation and TX power adaptation enable: <id>,<value_1>  (<value_1> is 8 bits integer)
+ *						<id> = 0x30
+ *						<value_1> = 0 -> RF_UPLINK_MOD and TX_POWER are left to the user (link history only)
+ *						<value_1> = 1 -> RF_UPLINK_MOD and TX_POWER are set from the link history
  *					- Auto-Calibration: <id>
  *						<id> = 0xFC
  *						There is no parameter, read will return an error
@@ -1037,13 +1054,45 @@ atci_status_t Exec_ATFC_Cmd(atci_cmd_t *atciCmdData)
 
 
 
+			case FC_LINK_ADAPT_ID:
+
+				if(atciCmdData->cmdType == AT_CMD_READ_WITH_PARAM) //read command
+				{
+					Atci_Cmd_Param_Init(atciCmdData);
+					atciCmdData->params[0].size = PARAM_INT8;
+					Atci_Add_Cmd_Param_Resp(atciCmdData);
+					atciCmdData->params[1].size = PARAM_INT8;
+					Atci_Add_Cmd_Param_Resp(atciCmdData);
+
+					*(atciCmdData->params[1].val8) = LinkAdapt_IsEnabled();
+
+					Atci_Resp_Data("ATFC", atciCmdData);
+				}
+				else if(atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET)//write command
+				{
+					status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+					if(status != ATCI_OK)
+						return status;
+					if(atciCmdData->cmdType != AT_CMD_WITH_PARAM)
+						return ATCI_ERR_INV_NB_PARAM;
+
+					Atci_Debug_Param_Data("Set Fact Cfg. (LINK ADAPT)", atciCmdData);/////////
+
+					LinkAdapt_Enable(*(atciCmdData->params[1].val8));
+				}
+				else
+					return ATCI_ERR_INV_NB_PARAM;
+
+				return ATCI_OK;
+
+
 			case FC_RSSI_CAL_ID:
 
 				if(atciCmdData->cmdType == AT_CMD_WITH_PARAM) //write command
 				{
 					Atci_Debug_Param_Data("Set Fact Cfg. (CAL RSSI)", atciCmdData);/////////
 
-					if(Phy_RssiCalibrate(&sPhyDev, -77) != PHY_STATUS_OK)
+					if(PhySrv_RssiCalibrate(&sPhyDev, -77) != PHY_STATUS_OK)
 						return ATCI_ERR;
 				}
 				else
@@ -1058,7 +1107,7 @@ atci_status_t Exec_ATFC_Cmd(atci_cmd_t *atciCmdData)
 				{
 					Atci_Debug_Param_Data("Set Fact Cfg. (CAL ADF7030)", atciCmdData);/////////
 
-					if(Phy_AutoCalibrate(&sPhyDev) != PHY_STATUS_OK)
+					if(PhySrv_AutoCalibrate(&sPhyDev) != PHY_STATUS_OK)
 						return ATCI_ERR;
 				}
 				else
@@ -1148,6 +1197,234 @@ atci_status_t Exec_ATTEST_Cmd(atci_cmd_t *atciCmdData)
 }
 
 
+/*!--------------------------------------------------------------------------------------------------------
+ * @brief		Execute ATNOISE command (noise sweep over all channels)
+ * 				This command is a write only command:
+ * 					"ATNOISE" -> measure noise on all channels with the current modulation
+ * 					"ATNOISE=<modulation>" -> measure noise on all channels with the given modulation
+ * 				Response format:
+ * 					"+ATNOISE:<modulation>,<noise>"
+ * 				Fields:
+ * 					<modulation> = 0x00 -> WM2400, 0x01 -> WM4800, 0x02 -> WM6400
+ * 					<noise> array of one byte per channel, from channel 100 to 150 (same unit as the RSSI)
+ *
+ * @param[I/O]	atciCmdData ("atci_cmd_t" structure)
+ *
+ * @return		status: ATCI_OK if succeed, else error code (ATCI_INV_NB_PARAM_ERR ... ATCI_INV_CMD_LEN_ERR or ATCI_ERR)
+ *-------------------------------------------------------------------------------------------------------*/
+atci_status_t Exec_ATNOISE_Cmd(atci_cmd_t *atciCmdData)
+{
+	atci_status_t status;
+	phy_mod_e eModulation;
+
+	eModulation = sPhyDev.eModulation;
+	if(atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET)
+	{
+		//get modulation
+		Atci_Cmd_Param_Init(atciCmdData);
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+		if(status != ATCI_OK)
+			return status;
+
+		if(atciCmdData->cmdType != AT_CMD_WITH_PARAM)
+			return ATCI_ERR_INV_NB_PARAM;
+
+		if(*(atciCmdData->params[0].val8) >= PHY_NB_MOD)
+			return ATCI_ERR_INV_PARAM_VAL;
+		eModulation = (phy_mod_e)(*(atciCmdData->params[0].val8));
+	}
+	else if(atciCmdData->cmdType != AT_CMD_WITHOUT_PARAM)
+		return ATCI_ERR_INV_NB_PARAM;
+
+	Atci_Cmd_Param_Init(atciCmdData);
+	atciCmdData->params[0].size = PARAM_INT8;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[1].size = PHY_NB_CH;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+
+	*(atciCmdData->params[0].val8) = (uint8_t)eModulation;
+	if(PhySrv_NoiseSweep(&sPhyDev, eModulation, atciCmdData->params[1].data) != PHY_STATUS_OK)
+		return ATCI_ERR;
+
+	Atci_Resp_Data("ATNOISE", atciCmdData);
+
+	return ATCI_OK;
+}
+
+/*!--------------------------------------------------------------------------------------------------------
+ * @brief		Execute ATBURST command (send a burst of numbered test frames)
+ * 				This command is a write only command:
+ * 					"ATBURST=<channel>,<modulation>,<nb>,<len>,<fill>,<gap>" -> send the burst
+ * 				Response format:
+ * 					"+ATBURST:<sent>,<duration>,<min_period>"
+ * 				Fields:
+ * 					<channel> = 0x00 -> channel 100 ... 0x05 -> channel 150
+ * 					<modulation> = 0x00 -> WM2400, 0x01 -> WM4800, 0x02 -> WM6400
+ * 					<nb> number of frames (16 bits integer, 1 to PHY_TEST_NB_MAX)
+ * 					<len> frame length, CRC included (8 bits integer, PHY_TEST_FRM_MIN_SZ to 255)
+ * 					<fill> payload filling byte (8 bits integer)
+ * 					<gap> time between frames in ms (16 bits integer), 0 -> frames are sent back to back
+ * 					<sent> number of sent frames (16 bits integer)
+ * 					<duration> time from the first frame request to the last TX complete in ms (32 bits integer)
+ * 					<min_period> minimum time between two TX complete in ms (32 bits integer)
+ * 				The command fails (no response) while the radio is in use.
+ *
+ * @param[I/O]	atciCmdData ("atci_cmd_t" structure)
+ *
+ * @return		status: ATCI_OK if succeed, else error code (ATCI_INV_NB_PARAM_ERR ... ATCI_INV_CMD_LEN_ERR or ATCI_ERR)
+ *-------------------------------------------------------------------------------------------------------*/
+atci_status_t Exec_ATBURST_Cmd(atci_cmd_t *atciCmdData)
+{
+	atci_status_t status;
+	phy_burst_t sBurst;
+	phy_burst_res_t sRes;
+	int32_t i32Ret;
+
+	if(atciCmdData->cmdType != AT_CMD_WITH_PARAM_TO_GET)
+		return ATCI_ERR_INV_NB_PARAM;
+
+	Atci_Cmd_Param_Init(atciCmdData);
+	status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+	if((status == ATCI_OK) && (atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET))
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+	if((status == ATCI_OK) && (atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET))
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT16);
+	if((status == ATCI_OK) && (atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET))
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+	if((status == ATCI_OK) && (atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET))
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+	if((status == ATCI_OK) && (atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET))
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT16);
+	if(status != ATCI_OK)
+		return status;
+
+	if((atciCmdData->cmdType != AT_CMD_WITH_PARAM) || (atciCmdData->nbParams != 6))
+		return ATCI_ERR_INV_NB_PARAM;
+
+	sBurst.eChannel = *(atciCmdData->params[0].val8);
+	sBurst.eModulation = *(atciCmdData->params[1].val8);
+	sBurst.u16Nb = *(atciCmdData->params[2].val16);
+	sBurst.u8Len = *(atciCmdData->params[3].val8);
+	sBurst.u8Fill = *(atciCmdData->params[4].val8);
+	sBurst.u16Gap = *(atciCmdData->params[5].val16);
+	if((sBurst.eChannel >= PHY_NB_CH) || (sBurst.eModulation >= PHY_NB_MOD)
+		|| (sBurst.u16Nb == 0) || (sBurst.u16Nb > PHY_TEST_NB_MAX) || (sBurst.u8Len < PHY_TEST_FRM_MIN_SZ))
+		return ATCI_ERR_INV_PARAM_VAL;
+
+	Atci_Debug_Param_Data("Burst", atciCmdData);/////////
+
+	i32Ret = EX_PHY_Burst(&sBurst, &sRes);
+	if(i32Ret == PHY_STATUS_BUSY)
+		return ATCI_ERR; // the radio is in use
+	status = (i32Ret == PHY_STATUS_OK)?(ATCI_OK):(ATCI_ERR);
+
+	// give the result, even on partial burst
+	Atci_Cmd_Param_Init(atciCmdData);
+	atciCmdData->params[0].size = PARAM_INT16;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[1].size = PARAM_INT32;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[2].size = PARAM_INT32;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+
+	*(atciCmdData->params[0].val16) = sRes.u16Sent;
+	*(atciCmdData->params[1].val32) = sRes.u32Duration;
+	*(atciCmdData->params[2].val32) = sRes.u32MinPeriod;
+
+	Atci_Resp_Data("ATBURST", atciCmdData);
+
+	return status;
+}
+
+/*!--------------------------------------------------------------------------------------------------------
+ * @brief		Execute ATPER command (receive a burst of test frames and give the packet error rate)
+ * 				This command is a write only command:
+ * 					"ATPER=<channel>,<modulation>,<time>" -> listen until the last frame of a burst or time out
+ * 				Response format:
+ * 					"+ATPER:<nb>,<rcv>,<missed>,<crc_err>,<dup>,<rssi>"
+ * 				Fields:
+ * 					<channel> = 0x00 -> channel 100 ... 0x05 -> channel 150
+ * 					<modulation> = 0x00 -> WM2400, 0x01 -> WM4800, 0x02 -> WM6400
+ * 					<time> maximum listen time in s (16 bits integer)
+ * 					<nb> number of frames of the burst, as given by the sender (16 bits integer, 0 if none received)
+ * 					<rcv> number of distinct received frames (16 bits integer)
+ * 					<missed> number of not received frames (16 bits integer)
+ * 					<crc_err> number of frames rejected on bad CRC (16 bits integer, always 0 in WM6400)
+ * 					<dup> number of received duplicated frames (16 bits integer)
+ * 					<rssi> array of 3 bytes : minimum, average and maximum RSSI of the received frames
+ * 				The command fails while the radio is in use.
+ *
+ * @param[I/O]	atciCmdData ("atci_cmd_t" structure)
+ *
+ * @return		status: ATCI_OK if succeed, else error code (ATCI_INV_NB_PARAM_ERR ... ATCI_INV_CMD_LEN_ERR or ATCI_ERR)
+ *-------------------------------------------------------------------------------------------------------*/
+atci_status_t Exec_ATPER_Cmd(atci_cmd_t *atciCmdData)
+{
+	atci_status_t status;
+	phy_per_res_t sRes;
+	char aRssiStr[PHY_CONV_QDBM_STR_SZ];
+	uint8_t eChannel, eModulation;
+	uint16_t u16Time;
+
+	if(atciCmdData->cmdType != AT_CMD_WITH_PARAM_TO_GET)
+		return ATCI_ERR_INV_NB_PARAM;
+
+	Atci_Cmd_Param_Init(atciCmdData);
+	status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+	if((status == ATCI_OK) && (atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET))
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT8);
+	if((status == ATCI_OK) && (atciCmdData->cmdType == AT_CMD_WITH_PARAM_TO_GET))
+		status = Atci_Buf_Get_Cmd_Param(atciCmdData, PARAM_INT16);
+	if(status != ATCI_OK)
+		return status;
+
+	if((atciCmdData->cmdType != AT_CMD_WITH_PARAM) || (atciCmdData->nbParams != 3))
+		return ATCI_ERR_INV_NB_PARAM;
+
+	eChannel = *(atciCmdData->params[0].val8);
+	eModulation = *(atciCmdData->params[1].val8);
+	u16Time = *(atciCmdData->params[2].val16);
+	if((eChannel >= PHY_NB_CH) || (eModulation >= PHY_NB_MOD) || (u16Time == 0))
+		return ATCI_ERR_INV_PARAM_VAL;
+
+	Atci_Debug_Param_Data("PER", atciCmdData);/////////
+
+	if(EX_PHY_Per(eChannel, eModulation, (uint32_t)u16Time * 1000, &sRes) != PHY_STATUS_OK)
+		return ATCI_ERR;
+
+	if (sRes.u16Rcv)
+	{
+		PHY_CONV_QdBmToStr(sRes.i16RssiQdBm, aRssiStr);
+		Atci_Debug_Printf("PER RSSI %s dBm, FERR %ld Hz", aRssiStr, (long)sRes.i32FerrHz);
+	}
+
+	Atci_Cmd_Param_Init(atciCmdData);
+	atciCmdData->params[0].size = PARAM_INT16;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[1].size = PARAM_INT16;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[2].size = PARAM_INT16;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[3].size = PARAM_INT16;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[4].size = PARAM_INT16;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+	atciCmdData->params[5].size = 3;
+	Atci_Add_Cmd_Param_Resp(atciCmdData);
+
+	*(atciCmdData->params[0].val16) = sRes.u16Nb;
+	*(atciCmdData->params[1].val16) = sRes.u16Rcv;
+	*(atciCmdData->params[2].val16) = sRes.u16Missed;
+	*(atciCmdData->params[3].val16) = sRes.u16CrcErr;
+	*(atciCmdData->params[4].val16) = sRes.u16Dup;
+	atciCmdData->params[5].data[0] = sRes.u8RssiMin;
+	atciCmdData->params[5].data[1] = sRes.u8RssiAvg;
+	atciCmdData->params[5].data[2] = sRes.u8RssiMax;
+
+	Atci_Resp_Data("ATPER", atciCmdData);
+
+	return ATCI_OK;
+}
 
 /************************************************** EOF **************************************************/
 
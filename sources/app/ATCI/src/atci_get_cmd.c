@@ -178,6 +178,12 @@ atci_status_t Atci_Get_Cmd_Code(atci_cmd_t *atciCmdData)
 		atciCmdData->cmdCode = CMD_ATFC;
 	else if(strcmp(atciCmdData->cmdCodeStr, "ATTEST") == 0)
 		atciCmdData->cmdCode = CMD_ATTEST;
+	else if(strcmp(atciCmdData->cmdCodeStr, "ATNOISE") == 0)
+		atciCmdData->cmdCode = CMD_ATNOISE;
+	else if(strcmp(atciCmdData->cmdCodeStr, "ATBURST") == 0)
+		atciCmdData->cmdCode = CMD_ATBURST;
+	else if(strcmp(atciCmdData->cmdCodeStr, "ATPER") == 0)
+		atciCmdData->cmdCode = CMD_ATPER;
 	else
 	{
 		return ATCI_ERR_UNKNOWN_CMD;
@@ -30,17 +30,56 @@
 extern "C" {
 #endif
 
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
 #include "phy_test.h"
 
 #include "platform.h"
+#include "bsp.h"
 #include "bsp_pwrlines.h"
 #include "default_device_config.h"
+#include "phy_server.h"
+#include "adf7030-1_phy_conv.h"
 
 extern phydev_t sPhyDev;
 
+/*!
+ * @brief Maximum time to wait for one frame TX complete (ms)
+ */
+#define PHY_TEST_TX_TMO 2000
+
+/*!
+ * @brief This hold the burst and packet error rate test context
+ */
+static struct {
+	SemaphoreHandle_t  hSem;      /*!< Given on each frame event */
+	StaticSemaphore_t  xSemBuf;   /*!< Semaphore static buffer */
+	volatile uint16_t  u16Evt;    /*!< Number of TX (or RX) complete */
+	volatile TickType_t xLast;    /*!< Time of the last TX complete (in RTOS ticks) */
+	volatile TickType_t xMinPeriod; /*!< Minimum time between two TX complete (in RTOS ticks) */
+	void (*pfEvtCb)(void *pCbParam, uint32_t eEvt); /*!< Saved PHY event callback */
+	void               *pCbParam; /*!< Saved PHY event callback parameter */
+	uint8_t            bRun;      /*!< A test is running */
+	union {
+		uint8_t        aFrame[PHY_RX_FRAME_MAX_SZ]; /*!< Frame buffer (TX) */
+		phy_rx_frame_t sRx;       /*!< Frame record (RX) */
+	};
+	uint8_t            aSeen[(PHY_TEST_NB_MAX + 7) / 8]; /*!< Received sequence numbers */
+} sTest;
+
 static void _phy_sport_cpy_cb_(void *pCBParam, void *pArg);
 static void _phy_sport_cb_(void *pCBParam, void *pArg);
 static void _test_set_io(uint8_t eType, uint8_t bEnable);
+static void _test_evt_cb_(void *pCbParam, uint32_t eEvt);
+static int32_t _test_wait_(uint16_t u16Nb, uint32_t u32Tmo);
+static int32_t _test_start_(void);
+static void _test_end_(void);
+static int32_t _test_req_(uint8_t eReq, uint8_t eChannel, uint8_t eModulation);
+static int32_t _test_ioctl_(uint32_t eCtl, uint32_t u32Arg);
 
 static void _phy_sport_cpy_cb_(void *pCBParam, void *pArg)
 {
@@ -163,11 +202,11 @@ phy_test_mode_e EX_PHY_Test(phy_test_mode_e eMode, uint8_t eType)
 
 	if (eMode)
 	{
-		eStatus = sPhyDev.pIf->pfInit(&sPhyDev);
+		eStatus = PhySrv_OnOff(&sPhyDev, 1);
 	}
 	else
 	{
-		eStatus = sPhyDev.pIf->pfUnInit(&sPhyDev);
+		eStatus = PhySrv_OnOff(&sPhyDev, 0);
 	}
 
 
@@ -180,10 +219,10 @@ phy_test_mode_e EX_PHY_Test(phy_test_mode_e eMode, uint8_t eType)
 			_test_set_io(eType, 1);
 			eTestSport.bGpioClk = 1;
 			eTestSport.bGpioData = 1;
-			eStatus = sPhyDev.pIf->pfIoctl(&sPhyDev, PHY_CMD_SPORT, eTestSport.testSport);
+			eStatus = _test_ioctl_(PHY_CMD_SPORT, eTestSport.testSport);
 		}
 		eTestModeInfo.eTestMode = eMode;
-		eStatus |= sPhyDev.pIf->pfIoctl(&sPhyDev, PHY_CMD_TEST, eTestModeInfo.testMode);
+		eStatus |= _test_ioctl_(PHY_CMD_TEST, eTestModeInfo.testMode);
 	}
 
 	if ( (!eMode) || (eStatus != PHY_STATUS_OK) )
@@ -195,13 +234,383 @@ phy_test_mode_e EX_PHY_Test(phy_test_mode_e eMode, uint8_t eType)
 			_test_set_io(eType, 0);
 			eTestSport.bGpioClk = 0;
 			eTestSport.bGpioData = 0;
-			eStatus = sPhyDev.pIf->pfIoctl(&sPhyDev, PHY_CMD_SPORT, eTestSport.testSport);
+			eStatus = _test_ioctl_(PHY_CMD_SPORT, eTestSport.testSport);
 		}
 		eTestModeInfo.eTestMode = PHY_TST_MODE_NONE;
-		eStatus |= sPhyDev.pIf->pfIoctl(&sPhyDev, PHY_CMD_TEST, eTestModeInfo.testMode);
+		eStatus |= _test_ioctl_(PHY_CMD_TEST, eTestModeInfo.testMode);
 	}
 	return eTestModeInfo.eTestMode;
 }
+/*!
+ * @brief  Send a burst of numbered test frames
+ *
+ * With no gap, each frame is staged into the radio while the previous one is
+ * on air, then chained on its TX complete, so the spacing is the minimum
+ * achievable one. The radio CRC is enabled while sending, so the frames pass
+ * the EX_PHY_Per check (the given CRC bytes are replaced, except in WM6400),
+ * then it is restored. The PHY event callback is taken over during the burst,
+ * so it is refused while the radio is in use. Requests go straight to the PHY server,
+ * so the link adaptation doesn't see the test frames. Times are taken from the
+ * RTOS tick (kept across the low power modes), so with its resolution.
+ *
+ * @param [in]  pBurst Pointer on the burst set point
+ * @param [out] pRes   Pointer on the result
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     All frames have been sent
+ * - PHY_STATUS_BUSY   The radio is in use (or a test is already running)
+ * - PHY_STATUS_ERROR  Invalid set point, or some frames have not been sent (see pRes)
+ */
+int32_t EX_PHY_Burst(const phy_burst_t *pBurst, phy_burst_res_t *pRes)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = &sPhyDev, .eReq = PHY_SRV_REQ_SEND, .ePrio = PHY_SRV_PRIO_HIGH,
+		.pBuf = sTest.aFrame, .u8Len = 0
+	};
+	int32_t i32Ret = PHY_STATUS_OK;
+	TickType_t xStart;
+	uint16_t u16Seq;
+	uint8_t bCrcOfl;
+
+	if ( !(pBurst && pRes)
+		|| (pBurst->eChannel >= PHY_NB_CH) || (pBurst->eModulation >= PHY_NB_MOD)
+		|| (pBurst->u8Len < PHY_TEST_FRM_MIN_SZ)
+		|| (pBurst->u16Nb == 0) || (pBurst->u16Nb > PHY_TEST_NB_MAX) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if ( _test_start_() )
+	{
+		return PHY_STATUS_BUSY;
+	}
+
+	memset(sTest.aFrame, pBurst->u8Fill, pBurst->u8Len);
+	sTest.aFrame[0] = pBurst->u8Len - 1;
+	sTest.aFrame[1] = PHY_TEST_FRM_MARK_0;
+	sTest.aFrame[2] = PHY_TEST_FRM_MARK_1;
+	sTest.aFrame[5] = (uint8_t)(pBurst->u16Nb >> 8);
+	sTest.aFrame[6] = (uint8_t)(pBurst->u16Nb);
+	sReq.u8Len = pBurst->u8Len;
+
+	// Let the radio compute the CRC
+	bCrcOfl = Phy_GetCrcOffload(&sPhyDev);
+	Phy_SetCrcOffload(&sPhyDev, 1);
+
+	sTest.xMinPeriod = portMAX_DELAY;
+	xStart = xTaskGetTickCount();
+	sTest.xLast = xStart;
+	for (u16Seq = 0; u16Seq < pBurst->u16Nb; u16Seq++)
+	{
+		sTest.aFrame[3] = (uint8_t)(u16Seq >> 8);
+		sTest.aFrame[4] = (uint8_t)(u16Seq);
+		// wait for room (one frame on air and one staged at most)
+		if ( (u16Seq > 1) && _test_wait_(u16Seq - 1, PHY_TEST_TX_TMO) )
+		{
+			i32Ret = PHY_STATUS_ERROR;
+			break;
+		}
+		i32Ret = PhySrv_Call(&sReq);
+		if (i32Ret == PHY_STATUS_BUSY)
+		{
+			// can't be staged, so wait for the one on air
+			if ( _test_wait_(u16Seq, PHY_TEST_TX_TMO) )
+			{
+				i32Ret = PHY_STATUS_ERROR;
+				break;
+			}
+			i32Ret = PhySrv_Call(&sReq);
+		}
+		if (i32Ret == PHY_STATUS_OK)
+		{
+			i32Ret = _test_req_(PHY_SRV_REQ_TX, pBurst->eChannel, pBurst->eModulation);
+		}
+		if (i32Ret != PHY_STATUS_OK)
+		{
+			break;
+		}
+		if (pBurst->u16Gap)
+		{
+			if ( _test_wait_(u16Seq + 1, PHY_TEST_TX_TMO) )
+			{
+				i32Ret = PHY_STATUS_ERROR;
+				break;
+			}
+			vTaskDelay( pdMS_TO_TICKS(pBurst->u16Gap) );
+		}
+	}
+	// wait for the last frames
+	if ( _test_wait_(u16Seq, PHY_TEST_TX_TMO) )
+	{
+		i32Ret = PHY_STATUS_ERROR;
+	}
+
+	pRes->u16Sent = sTest.u16Evt;
+	pRes->u32Duration = (sTest.xLast - xStart) * portTICK_PERIOD_MS;
+	pRes->u32MinPeriod = (sTest.xMinPeriod != portMAX_DELAY)?(sTest.xMinPeriod * portTICK_PERIOD_MS):(0);
+
+	Phy_SetCrcOffload(&sPhyDev, bCrcOfl);
+	_test_end_();
+	return (pRes->u16Sent == pBurst->u16Nb)?(i32Ret):(PHY_STATUS_ERROR);
+}
+
+/*!
+ * @brief  Receive a burst of numbered test frames and compute the packet error rate
+ *
+ * The address filter is disabled and the radio CRC check is enabled while
+ * listening (the CRC check is not available in WM6400), then both are restored.
+ * The listen ends on the last frame of the burst or on time out. The PHY event
+ * callback is taken over, so it is refused while the radio is in use. Requests
+ * and frames go straight to the PHY server and the PHY, so the link adaptation
+ * doesn't see the test frames.
+ *
+ * @param [in]  eChannel    Channel (see phy_chan_e)
+ * @param [in]  eModulation Modulation (see phy_mod_e)
+ * @param [in]  u32Time     Maximum listen time (ms)
+ * @param [out] pRes        Pointer on the result
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     The test is done (see pRes)
+ * - PHY_STATUS_BUSY   The radio is in use (or a test is already running)
+ * - PHY_STATUS_ERROR  Invalid parameter, or enable to listen
+ */
+int32_t EX_PHY_Per(uint8_t eChannel, uint8_t eModulation, uint32_t u32Time, phy_per_res_t *pRes)
+{
+	int32_t i32Ret;
+	uint32_t u32CrcErr, u32RssiSum = 0;
+	int32_t i32QdBmSum = 0, i32FerrSum = 0;
+	TickType_t xStart, xElapsed, xTime;
+	uint16_t u16Seq, u16Nb;
+	uint8_t aAddr[PHY_ADDR_FILT_SZ];
+	uint8_t u8Rssi, bCrcOfl, bAddrFilt, bLast = 0;
+
+	if ( !pRes || (eChannel >= PHY_NB_CH) || (eModulation >= PHY_NB_MOD) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if ( _test_start_() )
+	{
+		return PHY_STATUS_BUSY;
+	}
+	memset(pRes, 0, sizeof(phy_per_res_t));
+	memset(sTest.aSeen, 0, sizeof(sTest.aSeen));
+	pRes->u8RssiMin = 0xFF;
+
+	// Take all frames, checked by the radio
+	bAddrFilt = Phy_GetAddrFilt(&sPhyDev, aAddr);
+	Phy_SetAddrFilt(&sPhyDev, NULL);
+	bCrcOfl = Phy_GetCrcOffload(&sPhyDev);
+	Phy_SetCrcOffload(&sPhyDev, 1);
+	u32CrcErr = Phy_GetCrcErrNb(&sPhyDev);
+
+	xTime = pdMS_TO_TICKS(u32Time);
+	xStart = xTaskGetTickCount();
+	i32Ret = _test_req_(PHY_SRV_REQ_RX, eChannel, eModulation);
+	while ( (i32Ret == PHY_STATUS_OK) && !bLast )
+	{
+		xElapsed = xTaskGetTickCount() - xStart;
+		if (xElapsed >= xTime)
+		{
+			break;
+		}
+		xSemaphoreTake(sTest.hSem, xTime - xElapsed);
+		while (Phy_GetRxFrame(&sPhyDev, &sTest.sRx) == PHY_STATUS_OK)
+		{
+			if ( (sTest.sRx.u8Len < PHY_TEST_FRM_MIN_SZ)
+				|| (sTest.sRx.aPayload[1] != PHY_TEST_FRM_MARK_0) || (sTest.sRx.aPayload[2] != PHY_TEST_FRM_MARK_1) )
+			{
+				// not a test frame
+				continue;
+			}
+			u16Seq = ((uint16_t)sTest.sRx.aPayload[3] << 8) | sTest.sRx.aPayload[4];
+			u16Nb = ((uint16_t)sTest.sRx.aPayload[5] << 8) | sTest.sRx.aPayload[6];
+			if ( (u16Nb == 0) || (u16Nb > PHY_TEST_NB_MAX) || (u16Seq >= u16Nb) )
+			{
+				continue;
+			}
+			pRes->u16Nb = u16Nb;
+			if ( sTest.aSeen[u16Seq >> 3] & (1 << (u16Seq & 0x7)) )
+			{
+				pRes->u16Dup++;
+				continue;
+			}
+			sTest.aSeen[u16Seq >> 3] |= (1 << (u16Seq & 0x7));
+			pRes->u16Rcv++;
+			u8Rssi = PHY_CONV_Signed11ToRssi(sTest.sRx.u16Rssi);
+			u32RssiSum += u8Rssi;
+			i32QdBmSum += PHY_CONV_Signed11ToQdBm(sTest.sRx.u16Rssi);
+			i32FerrSum += PHY_CONV_AfcFreqErrToHz(sTest.sRx.u16Ferr);
+			pRes->u8RssiMin = (u8Rssi < pRes->u8RssiMin)?(u8Rssi):(pRes->u8RssiMin);
+			pRes->u8RssiMax = (u8Rssi > pRes->u8RssiMax)?(u8Rssi):(pRes->u8RssiMax);
+			if (u16Seq == u16Nb - 1)
+			{
+				bLast = 1;
+			}
+		}
+		// listen again (no-op if already re-armed, busy if still listening)
+		if (!bLast)
+		{
+			i32Ret = _test_req_(PHY_SRV_REQ_RX, eChannel, eModulation);
+			i32Ret = (i32Ret == PHY_STATUS_BUSY)?(PHY_STATUS_OK):(i32Ret);
+		}
+	}
+	_test_ioctl_(PHY_CTL_CMD_READY, 0);
+
+	pRes->u16CrcErr = (uint16_t)(Phy_GetCrcErrNb(&sPhyDev) - u32CrcErr);
+	pRes->u16Missed = pRes->u16Nb - pRes->u16Rcv;
+	if (pRes->u16Rcv)
+	{
+		pRes->u8RssiAvg = (uint8_t)(u32RssiSum / pRes->u16Rcv);
+		pRes->i16RssiQdBm = (int16_t)(i32QdBmSum / pRes->u16Rcv);
+		pRes->i32FerrHz = i32FerrSum / pRes->u16Rcv;
+	}
+	else
+	{
+		pRes->u8RssiMin = 0;
+	}
+
+	Phy_SetCrcOffload(&sPhyDev, bCrcOfl);
+	Phy_SetAddrFilt(&sPhyDev, (bAddrFilt)?(aAddr):(NULL));
+	_test_end_();
+	return (i32Ret == PHY_STATUS_OK)?(PHY_STATUS_OK):(PHY_STATUS_ERROR);
+}
+
+/*!
+ * @static
+ * @brief  PHY event callback, while a burst or PER test is running
+ *
+ * @param [in] pCbParam Pointer on call-back parameter (unused)
+ * @param [in] eEvt     The PHY event
+ *
+ * @return None
+ */
+static void _test_evt_cb_(void *pCbParam, uint32_t eEvt)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	TickType_t xNow;
+	(void)pCbParam;
+	if (eEvt == PHYDEV_EVT_TX_COMPLETE)
+	{
+		xNow = xTaskGetTickCountFromISR();
+		if ( sTest.u16Evt && ( (xNow - sTest.xLast) < sTest.xMinPeriod ) )
+		{
+			sTest.xMinPeriod = xNow - sTest.xLast;
+		}
+		sTest.xLast = xNow;
+	}
+	else if (eEvt != PHYDEV_EVT_RX_COMPLETE)
+	{
+		return;
+	}
+	sTest.u16Evt++;
+	xSemaphoreGiveFromISR(sTest.hSem, &xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*!
+ * @static
+ * @brief  Wait until the given number of TX complete
+ *
+ * @param [in] u16Nb  Number of TX complete to wait for
+ * @param [in] u32Tmo Maximum time between two TX complete (ms)
+ *
+ * @return 0 on success, 1 on time out
+ */
+static int32_t _test_wait_(uint16_t u16Nb, uint32_t u32Tmo)
+{
+	while ( (int16_t)(sTest.u16Evt - u16Nb) < 0 )
+	{
+		if ( xSemaphoreTake(sTest.hSem, pdMS_TO_TICKS(u32Tmo)) != pdTRUE )
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*!
+ * @static
+ * @brief  Take the PHY event callback over, if the radio is not in use
+ *
+ * @return 0 on success, 1 if the radio is in use or a test is already running
+ */
+static int32_t _test_start_(void)
+{
+	int32_t i32Ret = 1;
+	taskENTER_CRITICAL();
+	if ( !sTest.bRun && !Phy_IsBusy(&sPhyDev) )
+	{
+		sTest.bRun = 1;
+		i32Ret = 0;
+	}
+	taskEXIT_CRITICAL();
+	if (i32Ret == 0)
+	{
+		sTest.hSem = xSemaphoreCreateBinaryStatic(&sTest.xSemBuf);
+		sTest.u16Evt = 0;
+		taskENTER_CRITICAL();
+		sTest.pfEvtCb = sPhyDev.pfEvtCb;
+		sTest.pCbParam = sPhyDev.pCbParam;
+		sPhyDev.pfEvtCb = _test_evt_cb_;
+		sPhyDev.pCbParam = NULL;
+		taskEXIT_CRITICAL();
+	}
+	return i32Ret;
+}
+
+/*!
+ * @static
+ * @brief  Give the PHY event callback back
+ *
+ * @return None
+ */
+static void _test_end_(void)
+{
+	taskENTER_CRITICAL();
+	sPhyDev.pfEvtCb = sTest.pfEvtCb;
+	sPhyDev.pCbParam = sTest.pCbParam;
+	taskEXIT_CRITICAL();
+	vSemaphoreDelete(sTest.hSem);
+	sTest.bRun = 0;
+}
+
+/*!
+ * @static
+ * @brief  Request a TX or a RX, through the PHY server (as the Wize stack does)
+ *
+ * @param [in] eReq        The request (PHY_SRV_REQ_TX or PHY_SRV_REQ_RX)
+ * @param [in] eChannel    Channel (see phy_chan_e)
+ * @param [in] eModulation Modulation (see phy_mod_e)
+ *
+ * @return Status (see pfTx, pfRx)
+ */
+static int32_t _test_req_(uint8_t eReq, uint8_t eChannel, uint8_t eModulation)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = &sPhyDev, .eReq = eReq,
+		.ePrio = (eReq == PHY_SRV_REQ_TX)?(PHY_SRV_PRIO_HIGH):(PHY_SRV_PRIO_NORMAL),
+		.eChannel = eChannel, .eModulation = eModulation
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @static
+ * @brief  Send a control to the Phy device, through the PHY server (low priority)
+ *
+ * @param [in] eCtl   The control id
+ * @param [in] u32Arg The control argument
+ *
+ * @return Status (see pfIoctl)
+ */
+static int32_t _test_ioctl_(uint32_t eCtl, uint32_t u32Arg)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = &sPhyDev, .eReq = PHY_SRV_REQ_IOCTL, .ePrio = PHY_SRV_PRIO_LOW,
+		.eCtl = eCtl, .u32Arg = u32Arg
+	};
+	return PhySrv_Call(&sReq);
+}
+
 void EX_PHY_SetCpy(void)
 {
 #ifdef HAS_CPY_PIN
@@ -37,8 +37,62 @@ extern "C" {
 
 #include "phy_layer_private.h"
 
+#ifndef PHY_TEST_NB_MAX
+/*!
+ * @brief Maximum number of frames in one burst (the receiver hold one bit per frame)
+ */
+#define PHY_TEST_NB_MAX 2048
+#endif
+
+/*!
+ * @brief Test frame : L-field, marker (2 bytes), sequence number and number of frames (16 bits, BE), then payload and CRC
+ */
+#define PHY_TEST_FRM_MARK_0 0x50
+#define PHY_TEST_FRM_MARK_1 0x54
+#define PHY_TEST_FRM_HDR_SZ 7
+#define PHY_TEST_FRM_MIN_SZ (PHY_TEST_FRM_HDR_SZ + PHY_CRC_SZ)
+
+/*!
+ * @brief This define the burst transmission test set point
+ */
+typedef struct {
+	uint8_t  eChannel;    /*!< Channel (see phy_chan_e) */
+	uint8_t  eModulation; /*!< Modulation (see phy_mod_e) */
+	uint8_t  u8Len;       /*!< Frame length, CRC included (PHY_TEST_FRM_MIN_SZ to PHY_RX_FRAME_MAX_SZ) */
+	uint8_t  u8Fill;      /*!< Payload fill byte */
+	uint16_t u16Nb;       /*!< Number of frames (1 to PHY_TEST_NB_MAX) */
+	uint16_t u16Gap;      /*!< Gap between frames (ms), 0 : back-to-back */
+} phy_burst_t;
+
+/*!
+ * @brief This hold the burst transmission test result
+ */
+typedef struct {
+	uint16_t u16Sent;      /*!< Number of sent frames */
+	uint32_t u32Duration;  /*!< Time from the first TX request to the last TX complete (ms) */
+	uint32_t u32MinPeriod; /*!< Minimum time between two TX complete, i.e. air time plus spacing (ms) */
+} phy_burst_res_t;
+
+/*!
+ * @brief This hold the packet error rate test result
+ */
+typedef struct {
+	uint16_t u16Nb;       /*!< Number of frames of the burst (from the received frames), 0 : none received */
+	uint16_t u16Rcv;      /*!< Number of received frames */
+	uint16_t u16Missed;   /*!< Number of missed frames */
+	uint16_t u16CrcErr;   /*!< Number of frames dropped on bad CRC */
+	uint16_t u16Dup;      /*!< Number of duplicated frames */
+	uint8_t  u8RssiMin;   /*!< Minimum RSSI (same unit as PHY_CTL_GET_RSSI) */
+	uint8_t  u8RssiAvg;   /*!< Average RSSI */
+	uint8_t  u8RssiMax;   /*!< Maximum RSSI */
+	int16_t  i16RssiQdBm; /*!< Average RSSI (in 1/4 dBm) */
+	int32_t  i32FerrHz;   /*!< Average AFC frequency error (in Hz) */
+} phy_per_res_t;
+
 phy_test_mode_e EX_PHY_Test(phy_test_mode_e eMode, uint8_t eType);
 void EX_PHY_SetCpy(void);
+int32_t EX_PHY_Burst(const phy_burst_t *pBurst, phy_burst_res_t *pRes);
+int32_t EX_PHY_Per(uint8_t eChannel, uint8_t eModulation, uint32_t u32Time, phy_per_res_t *pRes);
 
 #ifdef __cplusplus
 }
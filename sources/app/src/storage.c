@@ -54,6 +54,7 @@ PERM_SECTION(".param") uint8_t a_ParamValue[PARAM_DEFAULT_SZ];
 
 extern phy_power_t aPhyPower[PHY_NB_PWR];
 extern int16_t i16RssiOffsetCal;
+extern phydev_t sPhyDev;
 
 const device_id_t sDefaultDevId =
 {
@@ -177,10 +178,13 @@ void Storage_Init(uint8_t bForce)
 void Storage_SetDefault(void)
 {
 	WizeApi_SetDeviceId(&sDefaultDevId);
+#if PHY_USE_ADDR_FILT
+	Phy_SetAddrFilt(&sPhyDev, (const uint8_t *)&sDefaultDevId);
+#endif
 	memcpy(aPhyPower, aDefaultPhyPower, sizeof(phy_power_t)*PHY_NB_PWR);
 	Phy_SetPa(bDefaultPaState);
 	i16RssiOffsetCal = i16DefaultRssiOffsetCal;
-	Phy_ClrCal();
+	Phy_ClrCal(&sPhyDev);
 	Param_Init(a_ParamDefault);
 	memcpy(_a_Key_, sDefaultKey, sizeof(_a_Key_));
 }
@@ -194,7 +198,7 @@ uint8_t Storage_Store(void)
 	memcpy(&(store_special.aPhyPower), aPhyPower, sizeof(phy_power_t)*PHY_NB_PWR);
 	store_special.bPaState = Phy_GetPa();
 	store_special.i16PhyRssiOffset = i16RssiOffsetCal;
-	Phy_GetCal(store_special.aPhyCalRes);
+	Phy_GetCal(&sPhyDev, store_special.aPhyCalRes);
 
 	sStorageArea.u32SrcAddr[0] = (uint32_t)(&store_special);
 	sStorageArea.u32SrcAddr[1] = (uint32_t)(a_ParamValue);
@@ -237,10 +241,13 @@ uint8_t Storage_Get(void)
 
 	// Init special
 	WizeApi_SetDeviceId( &(store_special.sDeviceInfo) );
+#if PHY_USE_ADDR_FILT
+	Phy_SetAddrFilt(&sPhyDev, (const uint8_t *)&(store_special.sDeviceInfo) );
+#endif
 	memcpy(aPhyPower, store_special.aPhyPower, sizeof(phy_power_t)*PHY_NB_PWR);
 	Phy_SetPa(store_special.bPaState);
 	i16RssiOffsetCal = store_special.i16PhyRssiOffset;
-	Phy_SetCal(store_special.aPhyCalRes);
+	Phy_SetCal(&sPhyDev, store_special.aPhyCalRes);
 	return 0;
 }
 
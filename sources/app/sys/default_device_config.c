@@ -43,6 +43,34 @@ KEEP_VAR(const adf7030_1_gpio_reset_info_t DEFAULT_GPIO_RESET) =
     .u16Pin = ADF7030_1_RESET_GPIO_PIN
 };
 
+KEEP_VAR(const adf7030_1_gpio_trig_info_t DEFAULT_GPIO_TRIG[ADF7030_1_NUM_TRIG_PIN]) =
+{
+    {
+        /*! Host GPIO port to which the trigger pin is connected */
+        .u32Port = ADF7030_1_TRIG0_GPIO_PORT,
+        /*! Host GPIO pin within the GPIO port */
+        .u16Pin = ADF7030_1_TRIG0_GPIO_PIN,
+        /*! PHY Radio GPIO pin */
+        .ePhyPin = ADF7030_1_TRIG0_GPIO_PHY_PIN,
+        /*! PHY Radio Command to execute on trigger */
+        .nTrigCmd = 0,
+        /*! Current trigger status */
+        .eTrigStatus = 0
+    },
+    {
+        /*! Host GPIO port to which the trigger pin is connected */
+        .u32Port = ADF7030_1_TRIG1_GPIO_PORT,
+        /*! Host GPIO pin within the GPIO port */
+        .u16Pin = ADF7030_1_TRIG1_GPIO_PIN,
+        /*! PHY Radio GPIO pin */
+        .ePhyPin = ADF7030_1_TRIG1_GPIO_PHY_PIN,
+        /*! PHY Radio Command to execute on trigger */
+        .nTrigCmd = 0,
+        /*! Current trigger status */
+        .eTrigStatus = 0
+    }
+};
+
 KEEP_VAR(const adf7030_1_gpio_int_info_t DEFAULT_GPIO_INT[ADF7030_1_NUM_INT_PIN]) =
 {
     {
@@ -79,6 +107,82 @@ KEEP_VAR(const adf7030_1_gpio_int_info_t DEFAULT_GPIO_INT[ADF7030_1_NUM_INT_PIN]
     }
 };
 
+#ifdef HAS_SECOND_RADIO
+/* Second device configuration (same radio GPIOs, on its own host pins) */
+
+KEEP_VAR(const adf7030_1_gpio_reset_info_t AUX_GPIO_RESET) =
+{
+    /*! Host GPIO port to which the interrupt pin is connected */
+    .u32Port = ADF7030_2_RESET_GPIO_PORT,
+    /*! Host GPIO pin within the GPIO port */
+    .u16Pin = ADF7030_2_RESET_GPIO_PIN
+};
+
+KEEP_VAR(const adf7030_1_gpio_trig_info_t AUX_GPIO_TRIG[ADF7030_1_NUM_TRIG_PIN]) =
+{
+    {
+        /*! Host GPIO port to which the trigger pin is connected */
+        .u32Port = ADF7030_2_TRIG0_GPIO_PORT,
+        /*! Host GPIO pin within the GPIO port */
+        .u16Pin = ADF7030_2_TRIG0_GPIO_PIN,
+        /*! PHY Radio GPIO pin */
+        .ePhyPin = ADF7030_1_TRIG0_GPIO_PHY_PIN,
+        /*! PHY Radio Command to execute on trigger */
+        .nTrigCmd = 0,
+        /*! Current trigger status */
+        .eTrigStatus = 0
+    },
+    {
+        /*! Host GPIO port to which the trigger pin is connected */
+        .u32Port = ADF7030_2_TRIG1_GPIO_PORT,
+        /*! Host GPIO pin within the GPIO port */
+        .u16Pin = ADF7030_2_TRIG1_GPIO_PIN,
+        /*! PHY Radio GPIO pin */
+        .ePhyPin = ADF7030_1_TRIG1_GPIO_PHY_PIN,
+        /*! PHY Radio Command to execute on trigger */
+        .nTrigCmd = 0,
+        /*! Current trigger status */
+        .eTrigStatus = 0
+    }
+};
+
+KEEP_VAR(const adf7030_1_gpio_int_info_t AUX_GPIO_INT[ADF7030_1_NUM_INT_PIN]) =
+{
+    {
+        /*! GPIO port to which the interrupt pin is connected */
+        .u32Port = ADF7030_2_INT0_GPIO_PORT,
+        /*! GPIO pin within the GPIO port */
+        .u16Pin = ADF7030_2_INT0_GPIO_PIN,
+        /*! PHY Radio GPIO pin */
+        .ePhyPin = ADF7030_1_INT0_GPIO_PHY_PIN,
+        /*! Radio PHY interrupt mask configuration */
+        .nIntMap = 0,
+        /*! Last IRQ status */
+        .nIntStatus = 0,
+		/*! Interrupt Call back*/
+		.pfIntCb = NULL,
+		/*! Interrupt Call back parameter*/
+		.pIntCbParam = NULL
+    },
+    {
+        /*! GPIO port to which the interrupt pin is connected */
+        .u32Port = ADF7030_2_INT1_GPIO_PORT,
+        /*! GPIO pin within the GPIO port */
+        .u16Pin = ADF7030_2_INT1_GPIO_PIN,
+        /*! PHY Radio GPIO pin */
+        .ePhyPin = ADF7030_1_INT1_GPIO_PHY_PIN,
+        /*! Radio PHY interrupt mask configuration */
+        .nIntMap = 0,
+        /*! Last IRQ status */
+        .nIntStatus = 0,
+		/*! Interrupt Call back*/
+		.pfIntCb = NULL,
+		/*! Interrupt Call back parameter*/
+		.pIntCbParam = NULL
+    }
+};
+#endif
+
 #ifdef __cplusplus
 }
 #endif
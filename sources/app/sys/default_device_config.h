@@ -85,6 +85,22 @@ extern "C" {
 #define ADF7030_1_SPORT_DATA_GPIO_PIN       ADF7030_GPIO1_Pin
 #define ADF7030_1_SPORT_DATA_GPIO_PHY_PIN   ADF7030_1_GPIO1
 
+#ifdef HAS_SECOND_RADIO
+/* Second adf7030-1, same wiring on its own pins (see pin_cfg.h) */
+#define ADF7030_2_RESET_GPIO_PORT      (uint32_t)ADF7030_2_RST_GPIO_Port
+#define ADF7030_2_RESET_GPIO_PIN       ADF7030_2_RST_Pin
+
+#define ADF7030_2_INT0_GPIO_PORT       (uint32_t)ADF7030_2_GPIO3_GPIO_Port
+#define ADF7030_2_INT0_GPIO_PIN        ADF7030_2_GPIO3_Pin
+#define ADF7030_2_INT1_GPIO_PORT       (uint32_t)ADF7030_2_GPIO5_GPIO_Port
+#define ADF7030_2_INT1_GPIO_PIN        ADF7030_2_GPIO5_Pin
+
+#define ADF7030_2_TRIG0_GPIO_PORT      (uint32_t)ADF7030_2_GPIO2_GPIO_Port
+#define ADF7030_2_TRIG0_GPIO_PIN       ADF7030_2_GPIO2_Pin
+#define ADF7030_2_TRIG1_GPIO_PORT      (uint32_t)ADF7030_2_GPIO4_GPIO_Port
+#define ADF7030_2_TRIG1_GPIO_PIN       ADF7030_2_GPIO4_Pin
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,503 @@
+/**
+  * @file: link_adapt.c
+  * @brief: This file implement the uplink modulation and TX power adaptation.
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "parameters_cfg.h"
+#include "parameters.h"
+
+#include "link_adapt.h"
+
+/*
+ * One history is kept per uplink channel (the "link"). An exchange starts on
+ * each uplink (LinkAdapt_OnTx), then its listen window is opened by the next
+ * RX request (LinkAdapt_OnRx), within LINK_ADAPT_XCH_TMO. The frames received
+ * in this window are its response, and give the downlink RSSI. The window ends
+ * when the Wize stack stops listening (LinkAdapt_OnRxEnd), which closes the
+ * exchange : frames already received but not yet read still count. An
+ * exchange fails when its window ends without any response, or when only CRC
+ * failed frames have been received.
+ *
+ * The settings are ordered from the most robust to the cheapest one : level 0
+ * is WM2400 at full TX power, then each modulation from the slowest to the
+ * fastest, with its TX power from the highest to the lowest. The selected
+ * setting is the cheapest one for which the downlink RSSI average stays
+ * LINK_ADAPT_MARGIN above the modulation sensitivity, once the TX power
+ * back-off is taken into account.
+ * After LINK_ADAPT_FAIL_NB failed exchanges, the setting falls back to a more
+ * robust one, and is held for LINK_ADAPT_HOLD_NB good exchanges.
+ *
+ * The decision is exposed (and applied by the Wize stack on the next uplink)
+ * through the RF_UPLINK_MOD and TX_POWER parameters.
+ */
+
+/*!
+ * @brief Convert a level in dBm to the Wize RSSI unit (0.5 dB, 0 is -147.5 dBm)
+ */
+#define LINK_ADAPT_DBM_TO_RSSI(dbm) ( 2 * (dbm) + 295 )
+
+/*!
+ * @brief Power back-off between two TX power entries (in dB)
+ */
+#define LINK_ADAPT_PWR_STEP 6
+
+/*!
+ * @brief Modulation sensitivity (in dBm)
+ */
+static const int16_t aLinkSens[PHY_NB_MOD] = {
+	[PHY_WM2400] = -110,
+	[PHY_WM4800] = -107,
+	[PHY_WM6400] = -102,
+};
+
+/*!
+ * @brief This struct hold the link adaptation context
+ */
+static struct {
+	link_adapt_hist_t aHist[PHY_NB_CH]; /*!< History of each link */
+	phydev_t  *pPhydev;   /*!< Phy device of the current exchange */
+	TickType_t xTxTime;   /*!< Start time of the current exchange */
+	uint32_t   u32CrcErr; /*!< CRC failed frames counter at the start of the current exchange */
+	uint8_t    eLink;     /*!< Link of the current exchange (PHY_NB_CH : none) */
+	uint8_t    bListen;   /*!< The listen window of the current exchange is opened */
+	uint8_t    u8Pend;    /*!< Frames received in the ended listen window, not yet read */
+	uint8_t    bRcv;      /*!< A response has been received in the current exchange */
+	uint8_t    bEnable;   /*!< Write the decisions into the parameters */
+} sLinkAdapt;
+
+static int16_t _lvl_req(uint8_t u8Level);
+static uint8_t _lvl_best(uint16_t u16Rssi);
+static void _decide(link_adapt_hist_t *pHist);
+static void _fail(link_adapt_hist_t *pHist);
+static void _close(void);
+static void _apply(uint8_t eLink);
+
+/******************************************************************************/
+
+/*!
+ * @brief  This function initialize the link adaptation
+ *
+ * All links start with the most robust setting.
+ *
+ * @return      None
+ */
+void LinkAdapt_Setup(void)
+{
+	memset(&sLinkAdapt, 0, sizeof(sLinkAdapt));
+	sLinkAdapt.eLink = PHY_NB_CH;
+	sLinkAdapt.bEnable = LINK_ADAPT_ENABLE;
+}
+
+/*!
+ * @brief  This function enable or disable the link adaptation
+ *
+ * When disabled, the history is still updated but the RF_UPLINK_MOD and
+ * TX_POWER parameters are left untouched.
+ *
+ * @param [in]  bEnable 1 to enable, 0 to disable
+ *
+ * @return      None
+ */
+void LinkAdapt_Enable(uint8_t bEnable)
+{
+	sLinkAdapt.bEnable = (bEnable)?(1):(0);
+}
+
+/*!
+ * @brief  This function tell if the link adaptation is enabled
+ *
+ * @return      1 if enabled, 0 otherwise
+ */
+uint8_t LinkAdapt_IsEnabled(void)
+{
+	return sLinkAdapt.bEnable;
+}
+
+/*!
+ * @brief  This function start a new exchange, on uplink
+ *
+ * The previous exchange is closed. The decision of the link is written into the
+ * parameters, if not already.
+ *
+ * @param [in]  pPhydev  Pointer on the Phy device instance
+ * @param [in]  eChannel The uplink channel
+ *
+ * @return      None
+ */
+void LinkAdapt_OnTx(phydev_t *pPhydev, phy_chan_e eChannel)
+{
+	uint32_t u32CrcErr;
+
+	if ( (pPhydev == NULL) || (eChannel >= PHY_NB_CH) )
+	{
+		return;
+	}
+	u32CrcErr = Phy_GetCrcErrNb(pPhydev);
+
+	taskENTER_CRITICAL();
+	_close();
+	sLinkAdapt.pPhydev = pPhydev;
+	sLinkAdapt.eLink = (uint8_t)eChannel;
+	sLinkAdapt.bListen = 0;
+	sLinkAdapt.u8Pend = 0;
+	sLinkAdapt.bRcv = 0;
+	sLinkAdapt.xTxTime = xTaskGetTickCount();
+	sLinkAdapt.u32CrcErr = u32CrcErr;
+	taskEXIT_CRITICAL();
+
+	_apply((uint8_t)eChannel);
+}
+
+/*!
+ * @brief  This function open the listen window of the current exchange, on RX
+ *
+ * The exchange is dropped if its window is not opened within LINK_ADAPT_XCH_TMO.
+ *
+ * @param [in]  pPhydev  Pointer on the Phy device instance
+ *
+ * @return      None
+ */
+void LinkAdapt_OnRx(phydev_t *pPhydev)
+{
+	taskENTER_CRITICAL();
+	if ( (sLinkAdapt.eLink < PHY_NB_CH) && (sLinkAdapt.pPhydev == pPhydev) && !sLinkAdapt.bListen )
+	{
+		if ( (xTaskGetTickCount() - sLinkAdapt.xTxTime) > pdMS_TO_TICKS(LINK_ADAPT_XCH_TMO) )
+		{
+			sLinkAdapt.eLink = PHY_NB_CH;
+		}
+		else
+		{
+			sLinkAdapt.bListen = 1;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*!
+ * @brief  This function end the listen window of the current exchange
+ *
+ * Called when the Wize stack stops listening (response window expiry, or
+ * response received). Without any response, nor frame waiting to be read, the
+ * exchange is failed. Otherwise, the exchange is over once the waiting frames
+ * have been read.
+ *
+ * @param [in]  pPhydev  Pointer on the Phy device instance
+ *
+ * @return      None
+ */
+void LinkAdapt_OnRxEnd(phydev_t *pPhydev)
+{
+	uint8_t u8Pend, eLink = PHY_NB_CH;
+
+	if (pPhydev == NULL)
+	{
+		return;
+	}
+	u8Pend = Phy_GetRxFrameNb(pPhydev);
+
+	taskENTER_CRITICAL();
+	if ( (sLinkAdapt.eLink < PHY_NB_CH) && (sLinkAdapt.pPhydev == pPhydev) && sLinkAdapt.bListen )
+	{
+		eLink = sLinkAdapt.eLink;
+		sLinkAdapt.bListen = 0;
+		sLinkAdapt.u8Pend = (sLinkAdapt.bRcv)?(0):(u8Pend);
+		if (sLinkAdapt.u8Pend == 0)
+		{
+			if ( !sLinkAdapt.bRcv && (Phy_GetCrcErrNb(pPhydev) == sLinkAdapt.u32CrcErr) )
+			{
+				sLinkAdapt.aHist[eLink].u16NbMissed++;
+				_fail(&(sLinkAdapt.aHist[eLink]));
+			}
+			_close();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if (eLink < PHY_NB_CH)
+	{
+		_apply(eLink);
+	}
+}
+
+/*!
+ * @brief  This function take a received frame into account
+ *
+ * Frames received out of the listen window of an exchange are ignored.
+ *
+ * @param [in]  u8Rssi The frame RSSI (Wize unit)
+ *
+ * @return      None
+ */
+void LinkAdapt_OnRecv(uint8_t u8Rssi)
+{
+	link_adapt_hist_t *pHist;
+	uint8_t eLink;
+
+	taskENTER_CRITICAL();
+	eLink = sLinkAdapt.eLink;
+	if ( !sLinkAdapt.bListen && (sLinkAdapt.u8Pend == 0) )
+	{
+		eLink = PHY_NB_CH;
+	}
+	if (eLink < PHY_NB_CH)
+	{
+		pHist = &(sLinkAdapt.aHist[eLink]);
+		if (pHist->u8NbRssi)
+		{
+			pHist->u16Rssi = (uint16_t)( (int32_t)pHist->u16Rssi
+					+ ( ( ((int32_t)u8Rssi << 3) - (int32_t)pHist->u16Rssi ) >> 2 ) );
+		}
+		else
+		{
+			pHist->u16Rssi = (uint16_t)u8Rssi << 3;
+		}
+		if (pHist->u8NbRssi < 0xFF)
+		{
+			pHist->u8NbRssi++;
+		}
+		if (!sLinkAdapt.bRcv)
+		{
+			sLinkAdapt.bRcv = 1;
+			pHist->u16NbRcv++;
+			pHist->u8Fail = 0;
+			if (pHist->u8Hold)
+			{
+				pHist->u8Hold--;
+			}
+		}
+		_decide(pHist);
+		if (!sLinkAdapt.bListen)
+		{
+			// a frame of the ended listen window : the exchange is over
+			sLinkAdapt.u8Pend = 0;
+			_close();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if (eLink < PHY_NB_CH)
+	{
+		_apply(eLink);
+	}
+}
+
+/*!
+ * @brief  This function get the history of one link
+ *
+ * @param [in]  eChannel The uplink channel
+ * @param [out] pHist    Pointer on the history
+ *
+ * @return      0 on success, -1 on invalid channel
+ */
+int32_t LinkAdapt_GetHist(phy_chan_e eChannel, link_adapt_hist_t *pHist)
+{
+	if ( (pHist == NULL) || (eChannel >= PHY_NB_CH) )
+	{
+		return -1;
+	}
+	taskENTER_CRITICAL();
+	*pHist = sLinkAdapt.aHist[eChannel];
+	taskEXIT_CRITICAL();
+	return 0;
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief  This function give the downlink RSSI required by a setting
+ *
+ * @param [in]  u8Level The setting
+ *
+ * @return      The required RSSI (Wize unit)
+ */
+static int16_t _lvl_req(uint8_t u8Level)
+{
+	uint8_t eMod = u8Level / PHY_NB_PWR;
+	uint8_t ePwr = u8Level % PHY_NB_PWR;
+	return LINK_ADAPT_DBM_TO_RSSI( aLinkSens[eMod] + ePwr * LINK_ADAPT_PWR_STEP
+			+ LINK_ADAPT_MARGIN + LINK_ADAPT_UL_OFFSET );
+}
+
+/*!
+ * @static
+ * @brief  This function give the cheapest setting for a downlink RSSI
+ *
+ * @param [in]  u16Rssi The downlink RSSI average (RSSI unit x 8)
+ *
+ * @return      The setting (0 if none)
+ */
+static uint8_t _lvl_best(uint16_t u16Rssi)
+{
+	uint8_t u8Level;
+	for (u8Level = LINK_ADAPT_NB_LVL - 1; u8Level > 0; u8Level--)
+	{
+		if ( ((int32_t)_lvl_req(u8Level) << 3) <= (int32_t)u16Rssi )
+		{
+			break;
+		}
+	}
+	return u8Level;
+}
+
+/*!
+ * @static
+ * @brief  This function update the setting of a link from its RSSI average
+ *
+ * The setting steps down as soon as the margin is lost, but steps up only out
+ * of the hold period.
+ *
+ * @param [in]  pHist Pointer on the link history
+ *
+ * @return      None
+ */
+static void _decide(link_adapt_hist_t *pHist)
+{
+	uint8_t u8Best = 0;
+
+	if (pHist->u8NbRssi >= LINK_ADAPT_MIN_NB)
+	{
+		u8Best = _lvl_best(pHist->u16Rssi);
+	}
+	if ( (u8Best < pHist->u8Level) || (pHist->u8Hold == 0) )
+	{
+		pHist->u8Level = u8Best;
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function take a failed exchange into account
+ *
+ * On LINK_ADAPT_FAIL_NB consecutive failures, the setting falls back to the
+ * cheapest one requiring a lower RSSI than the current one. The RSSI average is
+ * lowered to what the new setting requires, so it has to be proven again.
+ *
+ * @param [in]  pHist Pointer on the link history
+ *
+ * @return      None
+ */
+static void _fail(link_adapt_hist_t *pHist)
+{
+	int16_t i16Req;
+	uint8_t u8Level;
+
+	if (++pHist->u8Fail < LINK_ADAPT_FAIL_NB)
+	{
+		return;
+	}
+	pHist->u8Fail = 0;
+	pHist->u8Hold = LINK_ADAPT_HOLD_NB;
+	if (pHist->u8Level == 0)
+	{
+		return;
+	}
+	i16Req = _lvl_req(pHist->u8Level);
+	for (u8Level = LINK_ADAPT_NB_LVL - 1; u8Level > 0; u8Level--)
+	{
+		if (_lvl_req(u8Level) < i16Req)
+		{
+			break;
+		}
+	}
+	pHist->u8Level = u8Level;
+	if ( pHist->u16Rssi > ((uint16_t)_lvl_req(u8Level) << 3) )
+	{
+		pHist->u16Rssi = (uint16_t)_lvl_req(u8Level) << 3;
+	}
+	pHist->u16NbFallback++;
+}
+
+/*!
+ * @static
+ * @brief  This function close the current exchange (in critical section)
+ *
+ * An exchange with CRC failed frames but without any response is failed.
+ *
+ * @return      None
+ */
+static void _close(void)
+{
+	link_adapt_hist_t *pHist;
+
+	if ( (sLinkAdapt.eLink < PHY_NB_CH) && !sLinkAdapt.bRcv
+		&& (Phy_GetCrcErrNb(sLinkAdapt.pPhydev) != sLinkAdapt.u32CrcErr) )
+	{
+		pHist = &(sLinkAdapt.aHist[sLinkAdapt.eLink]);
+		pHist->u16NbCrcErr++;
+		_fail(pHist);
+	}
+	sLinkAdapt.eLink = PHY_NB_CH;
+	sLinkAdapt.bListen = 0;
+	sLinkAdapt.u8Pend = 0;
+}
+
+/*!
+ * @static
+ * @brief  This function write the setting of a link into the parameters
+ *
+ * @param [in]  eLink The link
+ *
+ * @return      None
+ */
+static void _apply(uint8_t eLink)
+{
+	uint8_t u8Level, u8Mod, u8Pwr, u8Val;
+
+	if (!sLinkAdapt.bEnable)
+	{
+		return;
+	}
+	u8Level = sLinkAdapt.aHist[eLink].u8Level;
+	u8Mod = u8Level / PHY_NB_PWR;
+	u8Pwr = u8Level % PHY_NB_PWR;
+
+	Param_Access(RF_UPLINK_MOD, &u8Val, 0);
+	if (u8Val != u8Mod)
+	{
+		Param_Access(RF_UPLINK_MOD, &u8Mod, 1);
+	}
+	Param_Access(TX_POWER, &u8Val, 0);
+	if (u8Val != u8Pwr)
+	{
+		Param_Access(TX_POWER, &u8Pwr, 1);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,122 @@
+/**
+  * @file: link_adapt.h
+  * @brief: This file declare the uplink modulation and TX power adaptation.
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+#ifndef _LINK_ADAPT_H_
+#define _LINK_ADAPT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "phy_layer_private.h"
+
+#ifndef LINK_ADAPT_ENABLE
+/*!
+ * @brief Enable the adaptation at startup (1), or only keep the history (0)
+ *        (see also ATFC, FC_LINK_ADAPT_ID)
+ */
+#define LINK_ADAPT_ENABLE 0
+#endif
+
+#ifndef LINK_ADAPT_MARGIN
+/*!
+ * @brief Target margin above the modulation sensitivity (in dB)
+ */
+#define LINK_ADAPT_MARGIN 10
+#endif
+
+#ifndef LINK_ADAPT_UL_OFFSET
+/*!
+ * @brief Uplink versus downlink budget difference (in dB, positive when the uplink is the weakest)
+ */
+#define LINK_ADAPT_UL_OFFSET 0
+#endif
+
+#ifndef LINK_ADAPT_FAIL_NB
+/*!
+ * @brief Number of consecutive failed exchanges before falling back
+ */
+#define LINK_ADAPT_FAIL_NB 2
+#endif
+
+#ifndef LINK_ADAPT_HOLD_NB
+/*!
+ * @brief Number of good exchanges required to step up again after a fall back
+ */
+#define LINK_ADAPT_HOLD_NB 8
+#endif
+
+#ifndef LINK_ADAPT_MIN_NB
+/*!
+ * @brief Number of RSSI samples required before leaving the most robust setting
+ */
+#define LINK_ADAPT_MIN_NB 3
+#endif
+
+#ifndef LINK_ADAPT_XCH_TMO
+/*!
+ * @brief Time after an uplink within which its listen window must be opened (in ms)
+ */
+#define LINK_ADAPT_XCH_TMO 30000
+#endif
+
+/*!
+ * @brief Number of settings, from the most robust (WM2400, full power) to the
+ *        cheapest one (WM6400, lowest power)
+ */
+#define LINK_ADAPT_NB_LVL (PHY_NB_MOD * PHY_NB_PWR)
+
+/*!
+ * @brief This struct hold the history of one link (uplink channel)
+ */
+typedef struct {
+	uint16_t u16Rssi;      /*!< Downlink RSSI average (RSSI unit x 8) */
+	uint8_t  u8NbRssi;     /*!< Number of RSSI samples (saturated) */
+	uint8_t  u8Fail;       /*!< Number of consecutive failed exchanges */
+	uint8_t  u8Hold;       /*!< Number of good exchanges left before stepping up */
+	uint8_t  u8Level;      /*!< Current setting (mod * PHY_NB_PWR + power) */
+	uint16_t u16NbRcv;     /*!< Number of exchanges with a response */
+	uint16_t u16NbMissed;  /*!< Number of exchanges without an expected response */
+	uint16_t u16NbCrcErr;  /*!< Number of exchanges with only CRC failed frames */
+	uint16_t u16NbFallback;/*!< Number of fall back */
+} link_adapt_hist_t;
+
+void LinkAdapt_Setup(void);
+void LinkAdapt_Enable(uint8_t bEnable);
+uint8_t LinkAdapt_IsEnabled(void);
+void LinkAdapt_OnTx(phydev_t *pPhydev, phy_chan_e eChannel);
+void LinkAdapt_OnRx(phydev_t *pPhydev);
+void LinkAdapt_OnRxEnd(phydev_t *pPhydev);
+void LinkAdapt_OnRecv(uint8_t u8Rssi);
+int32_t LinkAdapt_GetHist(phy_chan_e eChannel, link_adapt_hist_t *pHist);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _LINK_ADAPT_H_ */
@@ -0,0 +1,768 @@
+/**
+  * @file: phy_server.c
+  * @brief: This file implement the PHY command server (PHY owner task).
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rtos_macro.h"
+
+#include "bsp.h"
+#include "phy_server.h"
+#include "link_adapt.h"
+#include "adf7030-1_phy_conv.h"
+
+/*
+ * The PHY server is the only context driving the Phy device (SPI and radio
+ * state). Its interface is put in front of the device one, so the Wize stack
+ * (through phy_if) and the ATCI (ioctl, test, calibration) post their request
+ * into a static mailbox and sleep until its completion, instead of polling the
+ * SPI on their own stack. The frame interrupt is still handled by _frame_it.
+ *
+ * Requests are served by priority, then by posting order.
+ */
+
+#ifndef PHY_SRV_STACK_SIZE
+#define PHY_SRV_STACK_SIZE 400
+#endif
+
+#ifndef PHY_SRV_PRIORITY
+#define PHY_SRV_PRIORITY (UBaseType_t)(tskIDLE_PRIORITY+4)
+#endif
+
+SYS_TASK_CREATE_DEF(physrv, PHY_SRV_STACK_SIZE, PHY_SRV_PRIORITY);
+
+/*!
+ * @brief This struct hold one served Phy device
+ */
+typedef struct {
+	phydev_t       *pPhydev;                 /*!< The Phy device instance (NULL : free) */
+	const phy_if_t *pIf;                     /*!< Its served interface */
+} phy_srv_dev_t;
+
+/*!
+ * @brief This struct hold the PHY server context
+ */
+typedef struct {
+	phy_srv_dev_t   aDev[PHY_NB_INST];       /*!< The served Phy devices */
+	void           *hTask;                   /*!< The PHY server task */
+	phy_srv_req_t  *aMbox[PHY_SRV_MBOX_NB];  /*!< Pending requests */
+	uint8_t         u8Nb;                    /*!< Number of pending requests */
+	uint32_t        u32Seq;                  /*!< Next posting order */
+	phy_srv_stats_t sStats;                  /*!< Statistics */
+} phy_srv_t;
+
+static phy_srv_t sPhySrv;
+
+static void _srv_task(void const *argument);
+static phy_srv_req_t* _srv_pop(void);
+static int32_t _srv_exec(phy_srv_req_t *pReq);
+static void _srv_done(phy_srv_req_t *pReq, int32_t i32Status);
+static uint8_t _srv_direct(void);
+static void _srv_wake(void *pCbParam, int32_t i32Status);
+static const phy_if_t* _srv_get_if(phydev_t *pPhydev);
+
+static int32_t _srv_init(phydev_t *pPhydev);
+static int32_t _srv_uninit(phydev_t *pPhydev);
+static int32_t _srv_tx(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+static int32_t _srv_rx(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+static int32_t _srv_cca(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+static int32_t _srv_set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len);
+static int32_t _srv_get_recv(phydev_t *pPhydev, uint8_t *pBuf, uint8_t *u8Len);
+static int32_t _srv_ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args);
+
+/*!
+ * @brief This structure hold the Phy device interface, as served
+ */
+static const phy_if_t _srv_if = {
+	.pfInit          = _srv_init,
+	.pfUnInit        = _srv_uninit,
+
+	.pfTx            = _srv_tx,
+	.pfRx            = _srv_rx,
+	.pfNoise         = _srv_cca,
+
+	.pfSetSend       = _srv_set_send,
+	.pfGetRecv       = _srv_get_recv,
+
+	.pfIoctl         = _srv_ioctl
+};
+
+/******************************************************************************/
+
+/*!
+ * @brief  This function put the PHY server in front of the given Phy device
+ *
+ * The device must be setup before (its interface is the served one). Each
+ * device (up to PHY_NB_INST) keeps its own served interface, and all are
+ * served by the same task, created on the first call.
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      None
+ */
+void PhySrv_Setup(phydev_t *pPhydev)
+{
+	uint8_t i;
+	if ( pPhydev && pPhydev->pIf && (pPhydev->pIf != &_srv_if) )
+	{
+		for (i = 0; i < PHY_NB_INST; i++)
+		{
+			if ( (sPhySrv.aDev[i].pPhydev == NULL) || (sPhySrv.aDev[i].pPhydev == pPhydev) )
+			{
+				sPhySrv.aDev[i].pPhydev = pPhydev;
+				sPhySrv.aDev[i].pIf = pPhydev->pIf;
+				pPhydev->pIf = &_srv_if;
+				break;
+			}
+		}
+	}
+	if (sPhySrv.hTask == NULL)
+	{
+		sPhySrv.hTask = SYS_TASK_CREATE_CALL(physrv, _srv_task, NULL);
+	}
+}
+
+/*!
+ * @brief  This function post a request to the PHY server
+ *
+ * @param [in]  pReq Pointer on the request
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     The request is pending
+ * - PHY_STATUS_BUSY   The mailbox is full
+ * - PHY_STATUS_ERROR  Invalid request or server not started
+ *
+ */
+int32_t PhySrv_Post(phy_srv_req_t *pReq)
+{
+	int32_t i32Ret = PHY_STATUS_OK;
+	uint8_t u8Idx;
+
+	if ( (pReq == NULL) || (pReq->pPhydev == NULL) || (pReq->eReq >= PHY_SRV_REQ_NB) || (sPhySrv.hTask == NULL) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if (pReq->ePrio >= PHY_SRV_PRIO_NB)
+	{
+		pReq->ePrio = PHY_SRV_PRIO_HIGH;
+	}
+	pReq->i32Status = PHY_STATUS_BUSY;
+
+	taskENTER_CRITICAL();
+	if (sPhySrv.u8Nb < PHY_SRV_MBOX_NB)
+	{
+		for (u8Idx = 0; sPhySrv.aMbox[u8Idx] != NULL; u8Idx++) {}
+		pReq->u32Seq = sPhySrv.u32Seq++;
+		pReq->u32Posted = cycles();
+		sPhySrv.aMbox[u8Idx] = pReq;
+		sPhySrv.u8Nb++;
+		if (sPhySrv.u8Nb > sPhySrv.sStats.u8MaxDepth)
+		{
+			sPhySrv.sStats.u8MaxDepth = sPhySrv.u8Nb;
+		}
+	}
+	else
+	{
+		sPhySrv.sStats.u32NbFull++;
+		i32Ret = PHY_STATUS_BUSY;
+	}
+	taskEXIT_CRITICAL();
+
+	if (i32Ret == PHY_STATUS_OK)
+	{
+		xTaskNotifyGive((TaskHandle_t)sPhySrv.hTask);
+	}
+	return i32Ret;
+}
+
+/*!
+ * @brief  This function post a request to the PHY server and wait for its completion
+ *
+ * The request is executed in place when called from an interrupt, from the
+ * server itself or before the scheduler has been started. The completion
+ * callback of the request is overridden.
+ *
+ * @param [in]  pReq Pointer on the request
+ *
+ * @return      Status (see PhySrv_Post, then the request status)
+ *
+ */
+int32_t PhySrv_Call(phy_srv_req_t *pReq)
+{
+	int32_t i32Ret;
+	StaticSemaphore_t xSemBuf;
+	SemaphoreHandle_t hSem;
+
+	if (pReq == NULL)
+	{
+		return PHY_STATUS_ERROR;
+	}
+	if ( _srv_direct() )
+	{
+		return _srv_exec(pReq);
+	}
+	hSem = xSemaphoreCreateBinaryStatic(&xSemBuf);
+	pReq->pfDone = _srv_wake;
+	pReq->pCbParam = (void*)hSem;
+	i32Ret = PhySrv_Post(pReq);
+	if (i32Ret == PHY_STATUS_OK)
+	{
+		xSemaphoreTake(hSem, portMAX_DELAY);
+		i32Ret = pReq->i32Status;
+	}
+	vSemaphoreDelete(hSem);
+	return i32Ret;
+}
+
+/*!
+ * @brief  This function run the (default) auto-calibration from the PHY server
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status (see Phy_AutoCalibrate)
+ *
+ */
+int32_t PhySrv_AutoCalibrate(phydev_t *pPhydev)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_CAL, .ePrio = PHY_SRV_PRIO_LOW, .u32Arg = 0
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function power on (init) or off (uninit) the radio from the PHY server
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  bOn     On / Off the RF power
+ *
+ * @return      Status (see pfInit, pfUnInit)
+ *
+ */
+int32_t PhySrv_OnOff(phydev_t *pPhydev, uint8_t bOn)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = (bOn)?(PHY_SRV_REQ_INIT):(PHY_SRV_REQ_UNINIT), .ePrio = PHY_SRV_PRIO_NORMAL
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function run the RSSI calibration from the PHY server
+ *
+ * @param [in]  pPhydev        Pointer on the Phy device instance
+ * @param [in]  i8RssiRefLevel The reference level (in dBm)
+ *
+ * @return      Status (see Phy_RssiCalibrate)
+ *
+ */
+int32_t PhySrv_RssiCalibrate(phydev_t *pPhydev, int8_t i8RssiRefLevel)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_RSSI_CAL, .ePrio = PHY_SRV_PRIO_LOW,
+		.u32Arg = (uint32_t)i8RssiRefLevel
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function run the noise sweep from the PHY server
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eModulation The modulation
+ * @param [out] aNoise      The noise of each channel
+ *
+ * @return      Status (see Phy_NoiseSweep)
+ *
+ */
+int32_t PhySrv_NoiseSweep(phydev_t *pPhydev, phy_mod_e eModulation, uint8_t aNoise[PHY_NB_CH])
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_NOISE_SWEEP, .ePrio = PHY_SRV_PRIO_LOW,
+		.eModulation = (uint8_t)eModulation, .pBuf = aNoise
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function run the listen before talk from the PHY server
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    The channel
+ * @param [in]  eModulation The modulation
+ * @param [in]  u8Threshold The busy threshold
+ * @param [out] pLbt        The result
+ *
+ * @return      Status (see Phy_Lbt)
+ *
+ */
+int32_t PhySrv_Lbt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint8_t u8Threshold, phy_lbt_t *pLbt)
+{
+	// it comes just before a TX
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_LBT, .ePrio = PHY_SRV_PRIO_HIGH,
+		.eChannel = (uint8_t)eChannel, .eModulation = (uint8_t)eModulation,
+		.u32Arg = u8Threshold, .pArg = pLbt
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function schedule a TX from the PHY server
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    The channel
+ * @param [in]  eModulation The modulation
+ * @param [in]  u32Delay    The delay before the TX
+ *
+ * @return      Status (see Phy_TxAt)
+ *
+ */
+int32_t PhySrv_TxAt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint32_t u32Delay)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_TXAT, .ePrio = PHY_SRV_PRIO_HIGH,
+		.eChannel = (uint8_t)eChannel, .eModulation = (uint8_t)eModulation, .u32Arg = u32Delay
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function cancel the scheduled TX from the PHY server
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status (see Phy_TxAtCancel)
+ *
+ */
+int32_t PhySrv_TxAtCancel(phydev_t *pPhydev)
+{
+	phy_srv_req_t sReq = { .pPhydev = pPhydev, .eReq = PHY_SRV_REQ_TXAT_CANCEL, .ePrio = PHY_SRV_PRIO_HIGH };
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function start the multi-channel listen from the PHY server
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eModulation The modulation
+ * @param [in]  pScan       The scan setup
+ *
+ * @return      Status (see Phy_Scan)
+ *
+ */
+int32_t PhySrv_Scan(phydev_t *pPhydev, phy_mod_e eModulation, const phy_scan_t *pScan)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_SCAN, .ePrio = PHY_SRV_PRIO_NORMAL,
+		.eModulation = (uint8_t)eModulation, .pArg = (void*)pScan
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function stop the multi-channel listen from the PHY server
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status (see Phy_ScanStop)
+ *
+ */
+int32_t PhySrv_ScanStop(phydev_t *pPhydev)
+{
+	phy_srv_req_t sReq = { .pPhydev = pPhydev, .eReq = PHY_SRV_REQ_SCAN_STOP, .ePrio = PHY_SRV_PRIO_NORMAL };
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function start the smart wake (sniff) receive from the PHY server
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    The channel
+ * @param [in]  eModulation The modulation
+ *
+ * @return      Status (see Phy_Sniff)
+ *
+ */
+int32_t PhySrv_Sniff(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_SNIFF, .ePrio = PHY_SRV_PRIO_NORMAL,
+		.eChannel = (uint8_t)eChannel, .eModulation = (uint8_t)eModulation
+	};
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function stop the smart wake (sniff) receive from the PHY server
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status (see Phy_SniffStop)
+ *
+ */
+int32_t PhySrv_SniffStop(phydev_t *pPhydev)
+{
+	phy_srv_req_t sReq = { .pPhydev = pPhydev, .eReq = PHY_SRV_REQ_SNIFF_STOP, .ePrio = PHY_SRV_PRIO_NORMAL };
+	return PhySrv_Call(&sReq);
+}
+
+/*!
+ * @brief  This function get the PHY server statistics
+ *
+ * @param [out] pStats Pointer on the statistics to fill
+ *
+ * @return      None
+ */
+void PhySrv_GetStats(phy_srv_stats_t *pStats)
+{
+	if (pStats)
+	{
+		taskENTER_CRITICAL();
+		*pStats = sPhySrv.sStats;
+		taskEXIT_CRITICAL();
+	}
+}
+
+/******************************************************************************/
+
+/*!
+ * @static
+ * @brief  The PHY server task
+ *
+ * @param [in]  argument unused
+ *
+ * @return      None (this task never return)
+ */
+static void _srv_task(void const *argument)
+{
+	phy_srv_req_t *pReq;
+	int32_t i32Status;
+	uint32_t u32Start, u32Wait, u32Exec;
+
+	(void)argument;
+	while(1)
+	{
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		while ( (pReq = _srv_pop()) != NULL )
+		{
+			u32Start = cycles();
+			u32Wait = cycles_to_us(u32Start - pReq->u32Posted);
+			i32Status = _srv_exec(pReq);
+			u32Exec = cycles_to_us(cycles() - u32Start);
+
+			sPhySrv.sStats.u32NbReq++;
+			if (u32Wait > sPhySrv.sStats.u32MaxWait)
+			{
+				sPhySrv.sStats.u32MaxWait = u32Wait;
+			}
+			if (u32Exec > sPhySrv.sStats.u32MaxExec)
+			{
+				sPhySrv.sStats.u32MaxExec = u32Exec;
+			}
+			_srv_done(pReq, i32Status);
+		}
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function remove the next request to serve from the mailbox
+ *
+ * @return      The highest priority (then the oldest) request, NULL if none
+ */
+static phy_srv_req_t* _srv_pop(void)
+{
+	phy_srv_req_t *pReq = NULL;
+	uint8_t u8i, u8Idx = 0;
+
+	taskENTER_CRITICAL();
+	for (u8i = 0; u8i < PHY_SRV_MBOX_NB; u8i++)
+	{
+		if (sPhySrv.aMbox[u8i] == NULL)
+		{
+			continue;
+		}
+		if ( (pReq == NULL)
+			|| (sPhySrv.aMbox[u8i]->ePrio > pReq->ePrio)
+			|| ( (sPhySrv.aMbox[u8i]->ePrio == pReq->ePrio)
+				&& ((int32_t)(sPhySrv.aMbox[u8i]->u32Seq - pReq->u32Seq) < 0) ) )
+		{
+			pReq = sPhySrv.aMbox[u8i];
+			u8Idx = u8i;
+		}
+	}
+	if (pReq)
+	{
+		sPhySrv.aMbox[u8Idx] = NULL;
+		sPhySrv.u8Nb--;
+	}
+	taskEXIT_CRITICAL();
+	return pReq;
+}
+
+/*!
+ * @static
+ * @brief  This function execute a request on the served interface
+ *
+ * @param [in]  pReq Pointer on the request
+ *
+ * @return      Status (from the Phy device)
+ */
+static int32_t _srv_exec(phy_srv_req_t *pReq)
+{
+	phydev_t *pPhydev = pReq->pPhydev;
+	const phy_if_t *pIf = _srv_get_if(pPhydev);
+
+	if ( (pPhydev == NULL) || (pIf == NULL) )
+	{
+		return PHY_STATUS_ERROR;
+	}
+	switch (pReq->eReq)
+	{
+		case PHY_SRV_REQ_INIT:
+			return pIf->pfInit(pPhydev);
+		case PHY_SRV_REQ_UNINIT:
+			return pIf->pfUnInit(pPhydev);
+		case PHY_SRV_REQ_TX:
+			return pIf->pfTx(pPhydev, (phy_chan_e)pReq->eChannel, (phy_mod_e)pReq->eModulation);
+		case PHY_SRV_REQ_RX:
+			return pIf->pfRx(pPhydev, (phy_chan_e)pReq->eChannel, (phy_mod_e)pReq->eModulation);
+		case PHY_SRV_REQ_CCA:
+			return pIf->pfNoise(pPhydev, (phy_chan_e)pReq->eChannel, (phy_mod_e)pReq->eModulation);
+		case PHY_SRV_REQ_SEND:
+			return pIf->pfSetSend(pPhydev, pReq->pBuf, pReq->u8Len);
+		case PHY_SRV_REQ_IOCTL:
+			return pIf->pfIoctl(pPhydev, pReq->eCtl, pReq->u32Arg);
+		case PHY_SRV_REQ_CAL:
+			return (pReq->u32Arg)?(Phy_AutoCalibrateStages(pPhydev, pReq->u32Arg)):(Phy_AutoCalibrate(pPhydev));
+		case PHY_SRV_REQ_RSSI_CAL:
+			return Phy_RssiCalibrate(pPhydev, (int8_t)pReq->u32Arg);
+		case PHY_SRV_REQ_NOISE_SWEEP:
+			return Phy_NoiseSweep(pPhydev, (phy_mod_e)pReq->eModulation, pReq->pBuf);
+		case PHY_SRV_REQ_LBT:
+			return Phy_Lbt(pPhydev, (phy_chan_e)pReq->eChannel, (phy_mod_e)pReq->eModulation, (uint8_t)pReq->u32Arg, (phy_lbt_t*)pReq->pArg);
+		case PHY_SRV_REQ_TXAT:
+			return Phy_TxAt(pPhydev, (phy_chan_e)pReq->eChannel, (phy_mod_e)pReq->eModulation, pReq->u32Arg);
+		case PHY_SRV_REQ_TXAT_CANCEL:
+			return Phy_TxAtCancel(pPhydev);
+		case PHY_SRV_REQ_SCAN:
+			return Phy_Scan(pPhydev, (phy_mod_e)pReq->eModulation, (const phy_scan_t*)pReq->pArg);
+		case PHY_SRV_REQ_SCAN_STOP:
+			return Phy_ScanStop(pPhydev);
+		case PHY_SRV_REQ_SNIFF:
+			return Phy_Sniff(pPhydev, (phy_chan_e)pReq->eChannel, (phy_mod_e)pReq->eModulation);
+		case PHY_SRV_REQ_SNIFF_STOP:
+			return Phy_SniffStop(pPhydev);
+		default:
+			return PHY_STATUS_ERROR;
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function complete a request
+ *
+ * @param [in]  pReq      Pointer on the request
+ * @param [in]  i32Status The request status
+ *
+ * @return      None
+ */
+static void _srv_done(phy_srv_req_t *pReq, int32_t i32Status)
+{
+	pReq->i32Status = i32Status;
+	if (pReq->pfDone)
+	{
+		pReq->pfDone(pReq->pCbParam, i32Status);
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function tell if the caller can't wait for the PHY server
+ *
+ * @return      1 if the request must be executed in place, 0 otherwise
+ */
+static uint8_t _srv_direct(void)
+{
+	return ( (sPhySrv.hTask == NULL)
+			|| (__get_IPSR() != 0)
+			|| (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+			|| (xTaskGetCurrentTaskHandle() == (TaskHandle_t)sPhySrv.hTask) )?(1):(0);
+}
+
+/*!
+ * @static
+ * @brief  Completion callback of PhySrv_Call, wake-up the caller
+ *
+ * @param [in]  pCbParam  The caller semaphore
+ * @param [in]  i32Status The request status
+ *
+ * @return      None
+ */
+static void _srv_wake(void *pCbParam, int32_t i32Status)
+{
+	(void)i32Status;
+	xSemaphoreGive((SemaphoreHandle_t)pCbParam);
+}
+
+/*!
+ * @static
+ * @brief  This function get the served interface of the given Phy device
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      The served interface, NULL if the device is not served
+ */
+static const phy_if_t* _srv_get_if(phydev_t *pPhydev)
+{
+	uint8_t i;
+	for (i = 0; i < PHY_NB_INST; i++)
+	{
+		if ( pPhydev && (sPhySrv.aDev[i].pPhydev == pPhydev) )
+		{
+			return sPhySrv.aDev[i].pIf;
+		}
+	}
+	return NULL;
+}
+
+/******************************************************************************/
+
+static int32_t _srv_init(phydev_t *pPhydev)
+{
+	phy_srv_req_t sReq = { .pPhydev = pPhydev, .eReq = PHY_SRV_REQ_INIT, .ePrio = PHY_SRV_PRIO_NORMAL };
+	return PhySrv_Call(&sReq);
+}
+
+static int32_t _srv_uninit(phydev_t *pPhydev)
+{
+	phy_srv_req_t sReq = { .pPhydev = pPhydev, .eReq = PHY_SRV_REQ_UNINIT, .ePrio = PHY_SRV_PRIO_NORMAL };
+	int32_t i32Ret = PhySrv_Call(&sReq);
+	// the listen window (if any) is over
+	LinkAdapt_OnRxEnd(pPhydev);
+	return i32Ret;
+}
+
+static int32_t _srv_tx(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_TX, .ePrio = PHY_SRV_PRIO_HIGH,
+		.eChannel = (uint8_t)eChannel, .eModulation = (uint8_t)eModulation
+	};
+	int32_t i32Ret = PhySrv_Call(&sReq);
+	if (i32Ret == PHY_STATUS_OK)
+	{
+		// a new exchange starts
+		LinkAdapt_OnTx(pPhydev, eChannel);
+	}
+	return i32Ret;
+}
+
+static int32_t _srv_rx(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_RX, .ePrio = PHY_SRV_PRIO_NORMAL,
+		.eChannel = (uint8_t)eChannel, .eModulation = (uint8_t)eModulation
+	};
+	int32_t i32Ret = PhySrv_Call(&sReq);
+	if (i32Ret == PHY_STATUS_OK)
+	{
+		// the response listen window opens
+		LinkAdapt_OnRx(pPhydev);
+	}
+	return i32Ret;
+}
+
+static int32_t _srv_cca(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_CCA, .ePrio = PHY_SRV_PRIO_NORMAL,
+		.eChannel = (uint8_t)eChannel, .eModulation = (uint8_t)eModulation
+	};
+	return PhySrv_Call(&sReq);
+}
+
+static int32_t _srv_set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len)
+{
+	// the frame upload comes along with the TX
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_SEND, .ePrio = PHY_SRV_PRIO_HIGH,
+		.pBuf = pBuf, .u8Len = u8Len
+	};
+	return PhySrv_Call(&sReq);
+}
+
+static int32_t _srv_get_recv(phydev_t *pPhydev, uint8_t *pBuf, uint8_t *u8Len)
+{
+	// frames are already in the RX ring (no SPI access), so no need to serialize
+	const phy_if_t *pIf = _srv_get_if(pPhydev);
+	int32_t i32Ret;
+	if (pIf == NULL)
+	{
+		return PHY_STATUS_ERROR;
+	}
+	i32Ret = pIf->pfGetRecv(pPhydev, pBuf, u8Len);
+	if (i32Ret == PHY_STATUS_OK)
+	{
+		// the RSSI taken with this frame
+		LinkAdapt_OnRecv( PHY_CONV_Signed11ToRssi(pPhydev->u16_Rssi) );
+	}
+	return i32Ret;
+}
+
+static int32_t _srv_ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args)
+{
+	phy_srv_req_t sReq = {
+		.pPhydev = pPhydev, .eReq = PHY_SRV_REQ_IOCTL, .ePrio = PHY_SRV_PRIO_NORMAL,
+		.eCtl = eCtl, .u32Arg = args
+	};
+	int32_t i32Ret;
+	// test modes are not time critical
+	if ( (eCtl == PHY_CMD_TEST) || (eCtl == PHY_CMD_SPORT) )
+	{
+		sReq.ePrio = PHY_SRV_PRIO_LOW;
+	}
+	i32Ret = PhySrv_Call(&sReq);
+	if ( (eCtl == PHY_CTL_CMD_READY) || (eCtl == PHY_CTL_CMD_SLEEP) || (eCtl == PHY_CTL_CMD_PWR_OFF) )
+	{
+		// listen stopped : the listen window (if any) is over
+		LinkAdapt_OnRxEnd(pPhydev);
+	}
+	return i32Ret;
+}
+
+#ifdef __cplusplus
+}
+#endif
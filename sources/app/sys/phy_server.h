@@ -0,0 +1,140 @@
+/**
+  * @file: phy_server.h
+  * @brief: This file declare the PHY command server (PHY owner task).
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19
+  * Initial version
+  *
+  *
+  */
+#ifndef _PHY_SERVER_H_
+#define _PHY_SERVER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "phy_layer_private.h"
+
+#ifndef PHY_SRV_MBOX_NB
+/*!
+ * @brief Number of pending requests the PHY server mailbox can hold
+ */
+#define PHY_SRV_MBOX_NB 8
+#endif
+
+/*!
+ * @brief This enum define the PHY server request type
+ */
+typedef enum {
+	PHY_SRV_REQ_INIT,        /*!< pfInit */
+	PHY_SRV_REQ_UNINIT,      /*!< pfUnInit */
+	PHY_SRV_REQ_TX,          /*!< pfTx (eChannel, eModulation) */
+	PHY_SRV_REQ_RX,          /*!< pfRx (eChannel, eModulation) */
+	PHY_SRV_REQ_CCA,         /*!< pfNoise (eChannel, eModulation) */
+	PHY_SRV_REQ_SEND,        /*!< pfSetSend (pBuf, u8Len) */
+	PHY_SRV_REQ_IOCTL,       /*!< pfIoctl (eCtl, u32Arg) */
+	PHY_SRV_REQ_CAL,         /*!< Phy_AutoCalibrateStages (u32Arg, 0 : default stages) */
+	PHY_SRV_REQ_RSSI_CAL,    /*!< Phy_RssiCalibrate ((int8_t)u32Arg) */
+	PHY_SRV_REQ_NOISE_SWEEP, /*!< Phy_NoiseSweep (eModulation, pBuf) */
+	PHY_SRV_REQ_LBT,         /*!< Phy_Lbt (eChannel, eModulation, u32Arg, pArg) */
+	PHY_SRV_REQ_TXAT,        /*!< Phy_TxAt (eChannel, eModulation, u32Arg) */
+	PHY_SRV_REQ_TXAT_CANCEL, /*!< Phy_TxAtCancel */
+	PHY_SRV_REQ_SCAN,        /*!< Phy_Scan (eModulation, pArg) */
+	PHY_SRV_REQ_SCAN_STOP,   /*!< Phy_ScanStop */
+	PHY_SRV_REQ_SNIFF,       /*!< Phy_Sniff (eChannel, eModulation) */
+	PHY_SRV_REQ_SNIFF_STOP,  /*!< Phy_SniffStop */
+	PHY_SRV_REQ_NB
+} phy_srv_req_e;
+
+/*!
+ * @brief This enum define the PHY server request priority
+ */
+typedef enum {
+	PHY_SRV_PRIO_LOW,    /*!< Test, calibration... */
+	PHY_SRV_PRIO_NORMAL, /*!< Default */
+	PHY_SRV_PRIO_HIGH,   /*!< Time critical (TX) */
+	PHY_SRV_PRIO_NB
+} phy_srv_prio_e;
+
+/*!
+ * @brief Request completion callback (called from the PHY server task)
+ */
+typedef void (*pfPhySrvDone_t)(void *pCbParam, int32_t i32Status);
+
+/*!
+ * @brief This struct define a PHY server request
+ *
+ * The request is owned by the PHY server from PhySrv_Post until its completion
+ * callback, so it must not be on a stack frame that could exit before.
+ */
+typedef struct phy_srv_req_s {
+	phydev_t       *pPhydev;     /*!< Pointer on the Phy device instance */
+	uint8_t         eReq;        /*!< Request type (see phy_srv_req_e) */
+	uint8_t         ePrio;       /*!< Request priority (see phy_srv_prio_e) */
+	uint8_t         eChannel;    /*!< TX, RX, CCA : channel */
+	uint8_t         eModulation; /*!< TX, RX, CCA : modulation */
+	uint32_t        eCtl;        /*!< IOCTL : the control id */
+	uint32_t        u32Arg;      /*!< IOCTL : the control argument, CAL : the stages, ... */
+	uint8_t        *pBuf;        /*!< SEND : the frame, NOISE_SWEEP : the result */
+	void           *pArg;        /*!< LBT : the result, SCAN : the setup */
+	uint8_t         u8Len;       /*!< SEND : the frame length */
+	pfPhySrvDone_t  pfDone;      /*!< Completion callback (could be NULL) */
+	void           *pCbParam;    /*!< Completion callback parameter */
+	int32_t         i32Status;   /*!< Request status (PHY_STATUS_xxx), once completed */
+	// internal
+	uint32_t        u32Seq;      /*!< Posting order */
+	uint32_t        u32Posted;   /*!< Posting time (in cycles) */
+} phy_srv_req_t;
+
+/*!
+ * @brief This struct hold the PHY server statistics
+ */
+typedef struct {
+	uint32_t u32NbReq;       /*!< Number of executed requests */
+	uint32_t u32NbFull;      /*!< Number of requests rejected on full mailbox */
+	uint32_t u32MaxWait;     /*!< Maximum time from post to execution (in µs) */
+	uint32_t u32MaxExec;     /*!< Maximum execution time (in µs) */
+	uint8_t  u8MaxDepth;     /*!< Maximum number of pending requests */
+} phy_srv_stats_t;
+
+void PhySrv_Setup(phydev_t *pPhydev);
+int32_t PhySrv_Post(phy_srv_req_t *pReq);
+int32_t PhySrv_Call(phy_srv_req_t *pReq);
+int32_t PhySrv_AutoCalibrate(phydev_t *pPhydev);
+int32_t PhySrv_OnOff(phydev_t *pPhydev, uint8_t bOn);
+int32_t PhySrv_RssiCalibrate(phydev_t *pPhydev, int8_t i8RssiRefLevel);
+int32_t PhySrv_NoiseSweep(phydev_t *pPhydev, phy_mod_e eModulation, uint8_t aNoise[PHY_NB_CH]);
+int32_t PhySrv_Lbt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint8_t u8Threshold, phy_lbt_t *pLbt);
+int32_t PhySrv_TxAt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint32_t u32Delay);
+int32_t PhySrv_TxAtCancel(phydev_t *pPhydev);
+int32_t PhySrv_Scan(phydev_t *pPhydev, phy_mod_e eModulation, const phy_scan_t *pScan);
+int32_t PhySrv_ScanStop(phydev_t *pPhydev);
+int32_t PhySrv_Sniff(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+int32_t PhySrv_SniffStop(phydev_t *pPhydev);
+void PhySrv_GetStats(phy_srv_stats_t *pStats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _PHY_SERVER_H_ */
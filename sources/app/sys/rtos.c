@@ -92,9 +92,118 @@ void vApplicationDaemonTaskStartupHook( void )
 }
 #endif
 /******************************************************************************/
+#if ( configUSE_TICKLESS_IDLE == 2 )
+
+#include "platform.h"
+#include "bsp_lptimer.h"
+#include "bsp_pwrlines.h"
+#include "tickless.h"
+
+#if !defined(HAL_LPTIM_MODULE_ENABLED)
+#error "Tickless idle (configUSE_TICKLESS_IDLE == 2) requires HAL_LPTIM_MODULE_ENABLED"
+#endif
+
+#ifndef TICKLESS_LPTIM_ID
+#define TICKLESS_LPTIM_ID 1 // LPTIM1
+#endif
+
+#ifndef TICKLESS_LP_MODE
+#define TICKLESS_LP_MODE LP_STOP2_MODE
+#endif
+
+#ifndef TICKLESS_MAX_IDLE_MS
+// LPTIM is 16 bits with at most a 128 prescaler, that is 256 s with LSE clock
+#define TICKLESS_MAX_IDLE_MS 250000
+#endif
+
+/*
+ * Time elapsed but not yet reported into the tick count, in 1/u32KerFreq tick
+ * unit (u32KerFreq being the LPTIM kernel clock frequency).
+ */
+static uint32_t u32TicklessResidual;
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+	uint32_t u32KerFreq, u32Cyc, u32Frac, u32Reload;
+	TickType_t xCompleteTicks, xMaxTicks, xModifiableIdleTime;
+	lp_mode_e eLpMode = TICKLESS_LP_MODE;
+
+	if ( xExpectedIdleTime > pdMS_TO_TICKS(TICKLESS_MAX_IDLE_MS) )
+	{
+		xExpectedIdleTime = pdMS_TO_TICKS(TICKLESS_MAX_IDLE_MS);
+	}
+
+	// Stop the SysTick, the current period will be accounted by hand
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	__disable_irq();
+	__DSB();
+	__ISB();
+
+	if ( eTaskConfirmSleepModeStatus() == eAbortSleep )
+	{
+		// Restart the SysTick from where it was stopped
+		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+		__enable_irq();
+		return;
+	}
+
+	u32KerFreq = BSP_LpTimer_GetFreq(TICKLESS_LPTIM_ID);
+
+	// Part of the current tick period already elapsed
+	u32Reload = SysTick->LOAD + 1;
+	u32Frac = (uint32_t)( ( (uint64_t)(u32Reload - SysTick->VAL) * u32KerFreq ) / u32Reload );
+
+	// The tick already pending (if any) will be counted by the SysTick handler
+	xMaxTicks = xExpectedIdleTime;
+	if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+	{
+		xMaxTicks--;
+	}
+
+	// Wake-up one tick earlier, the remaining is given by the current period
+	BSP_LpTimer_StartCyc(TICKLESS_LPTIM_ID, Tickless_TicksToCyc(xExpectedIdleTime - 1, u32KerFreq, configTICK_RATE_HZ));
+
+	xModifiableIdleTime = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+	if ( xModifiableIdleTime > 0 )
+	{
+		// LPTIM2 (id 0) is not functional in STOP2, so stay in STOP1 while it is running
+		if ( (eLpMode == LP_STOP2_MODE) && BSP_LpTimer_IsRunning(0) )
+		{
+			eLpMode = LP_STOP1_MODE;
+		}
+		BSP_LowPower_Idle(eLpMode);
+	}
+	configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+	// Woken up by the LPTIM or by any other IT
+	u32Cyc = BSP_LpTimer_Stop(TICKLESS_LPTIM_ID);
+	u32Cyc <<= BSP_LpTimer_GetPrescaler(TICKLESS_LPTIM_ID);
+
+	xCompleteTicks = (TickType_t)Tickless_Compensate(u32Cyc, u32Frac, u32KerFreq, configTICK_RATE_HZ, &u32TicklessResidual);
+	if (xCompleteTicks > xMaxTicks)
+	{
+		// Can't go beyond the next unblock time, keep the excess for later
+		u32TicklessResidual += (xCompleteTicks - xMaxTicks) * u32KerFreq;
+		xCompleteTicks = xMaxTicks;
+	}
+
+	// Restart the SysTick for a full period
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	vTaskStepTick( xCompleteTicks );
+	// HAL time base was stopped too
+	uwTick += xCompleteTicks * portTICK_PERIOD_MS;
+
+	__enable_irq();
+}
+#else
 void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
 {
   // Generated when configUSE_TICKLESS_IDLE == 2.
   // Function called in tasks.c (in portTASK_FUNCTION).
   // TO BE COMPLETED or TO BE REPLACED by a user one, overriding that weak one.
 }
+#endif
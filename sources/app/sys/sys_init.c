@@ -54,13 +54,30 @@ extern "C" {
 
 #include "bsp_pwrlines.h"
 #include "storage.h"
+#include "phy_server.h"
+#include "link_adapt.h"
 
 extern const adf7030_1_gpio_reset_info_t DEFAULT_GPIO_RESET;
 extern const adf7030_1_gpio_int_info_t DEFAULT_GPIO_INT[ADF7030_1_NUM_INT_PIN];
+extern const adf7030_1_gpio_trig_info_t DEFAULT_GPIO_TRIG[ADF7030_1_NUM_TRIG_PIN];
+extern spi_dev_t spi_ADF7030;
 
 static adf7030_1_device_t adf7030_1_ctx;
 phydev_t sPhyDev;
 
+#ifdef HAS_SECOND_RADIO
+#if (PHY_NB_INST < 2)
+#error "HAS_SECOND_RADIO requires ADF7030_1_NUM_DEV (or PHY_NB_INST) of 2"
+#endif
+extern const adf7030_1_gpio_reset_info_t AUX_GPIO_RESET;
+extern const adf7030_1_gpio_int_info_t AUX_GPIO_INT[ADF7030_1_NUM_INT_PIN];
+extern const adf7030_1_gpio_trig_info_t AUX_GPIO_TRIG[ADF7030_1_NUM_TRIG_PIN];
+extern spi_dev_t spi_ADF7030_AUX;
+
+static adf7030_1_device_t adf7030_1_ctx_aux;
+phydev_t sPhyDevAux;
+#endif
+
 
 void Sys_Init(void)
 {
@@ -100,12 +117,29 @@ void Sys_Init(void)
 	// Setup adf device
 	assert(0 == Phy_adf7030_setup( &sPhyDev,
                                &adf7030_1_ctx,
+                               &spi_ADF7030,
                                (adf7030_1_gpio_int_info_t *)&DEFAULT_GPIO_INT,
-                               (adf7030_1_gpio_trig_info_t *)NULL,
+                               (adf7030_1_gpio_trig_info_t *)&DEFAULT_GPIO_TRIG,
                                (adf7030_1_gpio_reset_info_t *)&DEFAULT_GPIO_RESET,
 							   ADF7030_1_GPIO6,
                                ADF7030_1_GPIO_NONE
                                ) );
+	// From now, the PHY is driven by the PHY server task only
+	PhySrv_Setup(&sPhyDev);
+#ifdef HAS_SECOND_RADIO
+	// Second radio, on its own SPI bus (initialized by its user)
+	assert(0 == Phy_adf7030_setup( &sPhyDevAux,
+                               &adf7030_1_ctx_aux,
+                               &spi_ADF7030_AUX,
+                               (adf7030_1_gpio_int_info_t *)&AUX_GPIO_INT,
+                               (adf7030_1_gpio_trig_info_t *)&AUX_GPIO_TRIG,
+                               (adf7030_1_gpio_reset_info_t *)&AUX_GPIO_RESET,
+							   ADF7030_1_GPIO6,
+                               ADF7030_1_GPIO_NONE
+                               ) );
+	PhySrv_Setup(&sPhyDevAux);
+#endif
+	LinkAdapt_Setup();
 
 	WizeApi_CtxClear();
 
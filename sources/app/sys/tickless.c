@@ -0,0 +1,70 @@
+/**
+  * @file: tickless.c
+  * @brief: This file implement the tickless idle time conversions.
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19[GBI]
+  * Initial version
+  *
+  *
+  */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "tickless.h"
+
+/*!
+ * @brief  Convert an elapsed time into complete ticks, carrying the residual
+ *
+ * @param [in]     u32Cyc      Elapsed time, in LPTIM kernel clock cycles
+ * @param [in]     u32Frac     Elapsed time, in 1/u32KerFreq tick unit (i.e. fraction of the SysTick period)
+ * @param [in]     u32KerFreq  LPTIM kernel clock frequency (Hz)
+ * @param [in]     u32TickHz   Tick rate (Hz)
+ * @param [in,out] pResidual   Residual time (in 1/u32KerFreq tick unit)
+ *
+ * @return The number of complete ticks
+ */
+uint32_t Tickless_Compensate(uint32_t u32Cyc, uint32_t u32Frac, uint32_t u32KerFreq, uint32_t u32TickHz, uint32_t *pResidual)
+{
+	uint64_t u64Total;
+	u64Total = (uint64_t)u32Cyc * u32TickHz + u32Frac + *pResidual;
+	*pResidual = (uint32_t)(u64Total % u32KerFreq);
+	return (uint32_t)(u64Total / u32KerFreq);
+}
+
+/*!
+ * @brief  Convert a number of ticks into LPTIM kernel clock cycles
+ *
+ * @param [in] u32Ticks    Number of ticks
+ * @param [in] u32KerFreq  LPTIM kernel clock frequency (Hz)
+ * @param [in] u32TickHz   Tick rate (Hz)
+ *
+ * @return The number of kernel clock cycles (rounded down)
+ */
+uint32_t Tickless_TicksToCyc(uint32_t u32Ticks, uint32_t u32KerFreq, uint32_t u32TickHz)
+{
+	return (uint32_t)( ( (uint64_t)u32Ticks * u32KerFreq ) / u32TickHz );
+}
+
+#ifdef __cplusplus
+}
+#endif
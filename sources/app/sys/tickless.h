@@ -0,0 +1,44 @@
+/**
+  * @file: tickless.h
+  * @brief: This file declare the tickless idle time conversions.
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19[GBI]
+  * Initial version
+  *
+  *
+  */
+#ifndef _TICKLESS_H_
+#define _TICKLESS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+uint32_t Tickless_Compensate(uint32_t u32Cyc, uint32_t u32Frac, uint32_t u32KerFreq, uint32_t u32TickHz, uint32_t *pResidual);
+uint32_t Tickless_TicksToCyc(uint32_t u32Ticks, uint32_t u32KerFreq, uint32_t u32TickHz);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* _TICKLESS_H_ */
@@ -46,6 +46,9 @@ extern "C" {
 #endif
 
 extern void msleep(uint32_t milisecond);
+extern uint32_t mtick(void);
+extern uint32_t cycles(void);
+extern uint32_t cycles_to_us(uint32_t cycle);
 extern void Error_Handler(void);
 extern void BSP_Init(void);
 
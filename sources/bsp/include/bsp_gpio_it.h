@@ -49,6 +49,7 @@ typedef enum {
 int8_t BSP_GpioIt_GetLineId(const uint16_t u16Pin);
 uint8_t BSP_GpioIt_ConfigLine (const uint32_t u32Port, const uint16_t u16Pin, const gpio_irq_trg_cond_e ePol);
 uint8_t BSP_GpioIt_SetLine (const uint32_t u32Port, const uint16_t u16Pin, const bool bEnable);
+uint8_t BSP_GpioIt_MaskLine (const uint16_t u16Pin, const bool bMask);
 uint8_t BSP_GpioIt_SetCallback (const uint32_t u32Port, const uint16_t u16Pin, pf_cb_t const pfCb, void *const pCbParam );
 uint8_t BSP_GpioIt_SetGpioCpy( const uint8_t u8ItLineId, const uint32_t u32Port, const uint16_t u16Pin);
 uint8_t BSP_GpioIt_ClrGpioCpy( const uint8_t u8ItLineId);
@@ -38,7 +38,11 @@ extern pfHandlerCB_t pfLptim1Event;
 extern pfHandlerCB_t pfLptim2Event;
 
 uint32_t BSP_LpTimer_Start(const uint8_t u8TimerId, uint32_t u32Elapse);
+uint32_t BSP_LpTimer_StartCyc(const uint8_t u8TimerId, uint32_t u32NbClkCyc);
 uint32_t BSP_LpTimer_Stop(const uint8_t u8TimerId);
+uint8_t BSP_LpTimer_IsRunning(const uint8_t u8TimerId);
+uint32_t BSP_LpTimer_GetFreq(const uint8_t u8TimerId);
+uint8_t BSP_LpTimer_GetPrescaler(const uint8_t u8TimerId);
 void BSP_LpTimer_SetHandler (const uint8_t u8TimerId, pfHandlerCB_t const pfCb);
 
 
@@ -59,6 +59,7 @@ typedef enum {
 } lp_mode_e;
 
 void BSP_LowPower_Enter(lp_mode_e eLpMode);
+void BSP_LowPower_Idle(lp_mode_e eLpMode);
 
 /*******************************************************************************/
 
@@ -35,6 +35,11 @@ extern "C" {
 #include "common.h"
 #include "bsp_gpio.h"
 
+#ifndef SPI_SHORT_XFER_MAX
+/*! Transfer up to this size (in bytes) use the register level path */
+#define SPI_SHORT_XFER_MAX 8
+#endif
+
 typedef struct
 {
     uint8_t*    pTransmitter;/*!< Pointer to transmit data.        */
@@ -51,6 +56,8 @@ typedef struct
     uint8_t bus_id;
     uint32_t ss_port;
     uint16_t ss_pin;
+    uint32_t miso_port;
+    uint16_t miso_pin;
 } spi_dev_t;
 
 typedef spi_dev_t* p_spi_dev_t;
@@ -62,9 +69,11 @@ uint8_t BSP_Spi_Open(const p_spi_dev_t p_Device);
 uint8_t BSP_Spi_Close (const p_spi_dev_t p_Device);
 
 uint8_t BSP_Spi_SetBitrate (const p_spi_dev_t p_Device, const uint32_t u32_Hertz);
+uint32_t BSP_Spi_GetBitrateSwitchCnt (const p_spi_dev_t p_Device, uint32_t *pu32Elided);
 uint8_t BSP_Spi_SetClockPhase (const p_spi_dev_t p_Device, const bool b_Flag);
 uint8_t BSP_Spi_SetClockPol (const p_spi_dev_t p_Device, const bool b_Flag);
 uint8_t BSP_Spi_ReadWrite (const p_spi_dev_t p_Device, spi_transceiver_s* const p_Xfr);
+uint8_t BSP_Spi_ReadWrite_Short (const p_spi_dev_t p_Device, const uint8_t *pTx, uint8_t *pRx, uint8_t u8Size);
 
 #ifdef __cplusplus
 }
@@ -56,6 +56,15 @@ extern "C" {
 #define FE_EN_Pin GPIO_PIN_8
 #define FE_EN_GPIO_Port GPIOA
 
+#ifdef HAS_SECOND_RADIO
+// Second radio, on its own SPI bus (SPI_ID_AUX). Its pinout (ADF7030_2_SS,
+// ADF7030_2_RST, ADF7030_2_GPIO2 to ADF7030_2_GPIO5 and RADIO_2_MISO) is given
+// by the board variant.
+#ifndef ADF7030_2_SS_Pin
+#error "HAS_SECOND_RADIO : the second radio pinout is missing"
+#endif
+#endif
+
 // V_REF_EN
 #define PA_V_EN_Pin GPIO_PIN_13
 #define PA_V_EN_GPIO_Port GPIOC
@@ -38,6 +38,9 @@ extern "C" {
 typedef enum
 {
 	SPI_ID_MAIN,
+#ifdef HAS_SECOND_RADIO
+	SPI_ID_AUX,
+#endif
 	//
 	SPI_ID_MAX
 } spi_id_e;
@@ -38,6 +38,9 @@ extern "C" {
 
 //inline __attribute__((always_inline))
 void msleep(uint32_t milisecond) { HAL_Delay(milisecond); }
+uint32_t mtick(void) { return HAL_GetTick(); }
+uint32_t cycles(void) { return DWT->CYCCNT; }
+uint32_t cycles_to_us(uint32_t cycle) { return cycle / (SystemCoreClock / 1000000); }
 
 
 extern UART_HandleTypeDef *paUART_BusHandle[UART_ID_MAX];
@@ -80,6 +83,10 @@ void BSP_Init(void)
 	__init_sys_handlers__();
 	__init_sys_calls__();
 	BSP_Rtc_Setup_Prescaler(RTC_PREDIV_S, RTC_PREDIV_A);
+	// Enable the cycle counter (used for fine time measurement)
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 }
 #ifdef __cplusplus
 }
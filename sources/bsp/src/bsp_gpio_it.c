@@ -200,6 +200,30 @@ uint8_t BSP_GpioIt_SetLine (const uint32_t u32Port, const uint16_t u16Pin, const
 	return e_ret;
 }
 
+uint8_t BSP_GpioIt_MaskLine (const uint16_t u16Pin, const bool bMask)
+{
+	IRQn_Type e_Irq;
+	int8_t i8_ItLineId = BSP_GpioIt_GetLineId(u16Pin);
+	if (i8_ItLineId < 0 || i8_ItLineId > 15){
+		return DEV_FAILURE;
+	}
+	// Mask at NVIC level, so the EXTI pending state is kept
+	if (i8_ItLineId < 5){
+		// IT line from 0, 1, 2, 3 and 4
+		e_Irq = (IRQn_Type)(EXTI0_IRQn + i8_ItLineId);
+	}
+	else if (i8_ItLineId < 10){
+		// IT line from 5 to 9
+		e_Irq = EXTI9_5_IRQn;
+	}
+	else {
+		// IT line from 10 to 15
+		e_Irq = EXTI15_10_IRQn;
+	}
+	(bMask)?(HAL_NVIC_DisableIRQ(e_Irq)):(HAL_NVIC_EnableIRQ(e_Irq));
+	return DEV_SUCCESS;
+}
+
 uint8_t BSP_GpioIt_SetCallback (const uint32_t u32Port, const uint16_t u16Pin, pf_cb_t const pfCb, void *const pCbParam )
 {
 	UNUSED(u32Port);
@@ -112,13 +112,43 @@ uint32_t BSP_LpTimer_Start(const uint8_t u8TimerId, uint32_t u32Elapse)
 	}
 	HAL_LPTIM_SetOnce_Stop_IT(pHandle);
 	// u32Elapse is in ms and frequency in Hertz
-	u32NbClkCyc = (frequency/1000) * u32Elapse;
+	u32NbClkCyc = (uint32_t)( ( (uint64_t)frequency * u32Elapse ) / 1000 );
 	u32NbClkCyc = (uint32_t)_set_prescaler_(pHandle, u32NbClkCyc);
 	HAL_LPTIM_SetOnce_Start_IT(pHandle, 0xFFFF, u32NbClkCyc);
 #endif
 	return u32NbClkCyc;
 }
 
+// u32NbClkCyc is in kernel clock cycles, return the counter compare value
+uint32_t BSP_LpTimer_StartCyc(const uint8_t u8TimerId, uint32_t u32NbClkCyc)
+{
+#if defined(HAL_LPTIM_MODULE_ENABLED)
+	LPTIM_HandleTypeDef *pHandle;
+	if (u8TimerId)
+	{
+#if defined (LPTIM1)
+		pHandle = &hlptim1;
+#else
+		return 0;
+#endif
+	}
+	else
+	{
+#if defined (LPTIM2)
+		pHandle = &hlptim2;
+#else
+		return 0;
+#endif
+	}
+	HAL_LPTIM_SetOnce_Stop_IT(pHandle);
+	u32NbClkCyc = (uint32_t)_set_prescaler_(pHandle, u32NbClkCyc);
+	HAL_LPTIM_SetOnce_Start_IT(pHandle, 0xFFFF, u32NbClkCyc);
+#else
+	u32NbClkCyc = 0;
+#endif
+	return u32NbClkCyc;
+}
+
 uint32_t BSP_LpTimer_Stop(const uint8_t u8TimerId)
 {
 	uint32_t u32NbClkCyc = 0;
@@ -140,8 +170,8 @@ uint32_t BSP_LpTimer_Stop(const uint8_t u8TimerId)
 		return 0;
 #endif
 	}
-	HAL_LPTIM_SetOnce_Stop_IT(pHandle);
 	// Read LPTIM_CNT is not reliable, so read it multiple time
+	// Note : counter has to be read before disabling the LPTIM (reset it)
 	u32NbClkCyc = HAL_LPTIM_ReadCounter(pHandle);
 	for (uint8_t i=0; i < 3; i++)
 	{
@@ -152,10 +182,86 @@ uint32_t BSP_LpTimer_Stop(const uint8_t u8TimerId)
 		}
 		u32NbClkCyc = temp;
 	}
+	HAL_LPTIM_SetOnce_Stop_IT(pHandle);
 #endif
 	return u32NbClkCyc;
 }
 
+// return 1 if the timer is started (i.e. not yet stopped)
+uint8_t BSP_LpTimer_IsRunning(const uint8_t u8TimerId)
+{
+	uint8_t bRunning = 0;
+#if defined(HAL_LPTIM_MODULE_ENABLED)
+	LPTIM_HandleTypeDef *pHandle;
+	if (u8TimerId)
+	{
+#if defined (LPTIM1)
+		pHandle = &hlptim1;
+#else
+		return 0;
+#endif
+	}
+	else
+	{
+#if defined (LPTIM2)
+		pHandle = &hlptim2;
+#else
+		return 0;
+#endif
+	}
+	bRunning = (pHandle->Instance->CR & LPTIM_CR_ENABLE)?(1):(0);
+#endif
+	return bRunning;
+}
+
+// return the kernel clock frequency (Hz)
+uint32_t BSP_LpTimer_GetFreq(const uint8_t u8TimerId)
+{
+	uint32_t frequency = 0;
+#if defined(HAL_LPTIM_MODULE_ENABLED)
+	if (u8TimerId)
+	{
+#if defined (LPTIM1)
+		frequency = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_LPTIM1);
+#endif
+	}
+	else
+	{
+#if defined (LPTIM2)
+		frequency = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_LPTIM2);
+#endif
+	}
+#endif
+	return frequency;
+}
+
+// return the current prescaler as a power of 2 (counter clock is kernel clock >> prescaler)
+uint8_t BSP_LpTimer_GetPrescaler(const uint8_t u8TimerId)
+{
+	uint8_t u8Presc = 0;
+#if defined(HAL_LPTIM_MODULE_ENABLED)
+	LPTIM_HandleTypeDef *pHandle;
+	if (u8TimerId)
+	{
+#if defined (LPTIM1)
+		pHandle = &hlptim1;
+#else
+		return 0;
+#endif
+	}
+	else
+	{
+#if defined (LPTIM2)
+		pHandle = &hlptim2;
+#else
+		return 0;
+#endif
+	}
+	u8Presc = (uint8_t)( (pHandle->Instance->CFGR & LPTIM_CFGR_PRESC_Msk) >> LPTIM_CFGR_PRESC_Pos );
+#endif
+	return u8Presc;
+}
+
 void BSP_LpTimer_SetHandler (const uint8_t u8TimerId, pfHandlerCB_t const pfCb)
 {
 	if (u8TimerId)
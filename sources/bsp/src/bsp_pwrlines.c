@@ -270,12 +270,8 @@ static void _lp_exit_ (void)
 #endif
 }
 
-void BSP_LowPower_Enter (lp_mode_e eLpMode)
+static void _lp_enter_ (lp_mode_e eLpMode)
 {
-	HAL_SuspendTick();
-	HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
-
-	_lp_entry_();
 	switch(eLpMode)
 	{
 		case LP_SHTDWN_MODE:
@@ -295,6 +291,30 @@ void BSP_LowPower_Enter (lp_mode_e eLpMode)
 			HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
 			break;
 	}
+}
+
+void BSP_LowPower_Enter (lp_mode_e eLpMode)
+{
+	HAL_SuspendTick();
+	HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+
+	_lp_entry_();
+	_lp_enter_(eLpMode);
+	_lp_exit_();
+	HAL_ResumeTick();
+}
+
+/*
+ * Same as BSP_LowPower_Enter, but keep the RTC wake-up timer running. This one
+ * is intended to be called from the RTOS idle (tickless), so the caller is in
+ * charge to setup the wake-up source (e.g. LPTIM).
+ */
+void BSP_LowPower_Idle (lp_mode_e eLpMode)
+{
+	HAL_SuspendTick();
+
+	_lp_entry_();
+	_lp_enter_(eLpMode);
 	_lp_exit_();
 	HAL_ResumeTick();
 }
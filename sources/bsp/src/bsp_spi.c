@@ -36,6 +36,9 @@
 #ifndef SPI_TX_TIMEOUT
 	#define SPI_TX_TIMEOUT 1000
 #endif
+#ifndef SPI_SHORT_XFER_TMO
+	#define SPI_SHORT_XFER_TMO 10000 // in polling loop
+#endif
 
 extern const char *pa_HalErrMsg[];
 //extern spi_dev_t *ap_SpiDev[SPI_ID_MAX];
@@ -56,6 +59,22 @@ static const uint32_t prescaler_table[] =
 	SPI_BAUDRATEPRESCALER_128,
 	SPI_BAUDRATEPRESCALER_256
 };
+#define NB_PRESCALER (sizeof(prescaler_table) / sizeof(prescaler_table[0]))
+
+/*
+ * Bit-rate switch context. The frequency obtained with each prescaler is
+ * pre-computed (and re-computed if the SPI kernel clock change).
+ */
+typedef struct
+{
+	uint32_t u32KerFreq;                 // SPI kernel clock the table is computed for
+	uint32_t aRankHz[NB_PRESCALER];      // bit-rate for each prescaler rank
+	uint32_t u32LastHz;                  // last requested bit-rate
+	uint32_t u32SwitchCnt;               // number of effective prescaler change
+	uint32_t u32ElideCnt;                // number of elided (redundant) change
+} spi_br_ctx_t;
+
+static spi_br_ctx_t aSpiBrCtx[SPI_ID_MAX];
 
 static uint16_t _get_AHB_div_(void){
 	uint32_t cfgr, hpre;
@@ -189,30 +208,98 @@ uint8_t BSP_Spi_Close (const p_spi_dev_t p_Device)
 
 uint8_t BSP_Spi_SetBitrate (const p_spi_dev_t p_Device, const uint32_t u32_Hertz)
 {
-	int spi_hz = 0;
+	SPI_HandleTypeDef *p_handle = paSPI_BusHandle[p_Device->bus_id];
+	spi_br_ctx_t *pCtx = &aSpiBrCtx[p_Device->bus_id];
+	uint32_t u32KerFreq, u32Spe;
+	uint32_t u32Tmo = SPI_SHORT_XFER_TMO;
 	uint8_t prescaler_rank = 0;
-	uint8_t last_index = (sizeof(prescaler_table) / sizeof(prescaler_table[0])) - 1;
+	uint8_t ret;
+	uint8_t last_index = NB_PRESCALER - 1;
 
-	/* Calculate the spi clock for prescaler_rank 0: SPI_BAUDRATEPRESCALER_2 */
-	spi_hz = _get_SPI_freq_() / 2;
+	u32KerFreq = _get_SPI_freq_();
+	if (pCtx->u32KerFreq != u32KerFreq)
+	{
+		/* (Re)compute the bit-rate table */
+		pCtx->u32KerFreq = u32KerFreq;
+		pCtx->u32LastHz = 0;
+		for (prescaler_rank = 0; prescaler_rank < NB_PRESCALER; prescaler_rank++)
+		{
+			pCtx->aRankHz[prescaler_rank] = u32KerFreq >> (prescaler_rank + 1);
+		}
+		prescaler_rank = 0;
+	}
+	else if ( (pCtx->u32LastHz == u32_Hertz) && (p_handle->State != HAL_SPI_STATE_RESET) )
+	{
+		/* Nothing change */
+		pCtx->u32ElideCnt++;
+		return DEV_SUCCESS;
+	}
 
 	/* Define pre-scaler in order to get highest available frequency below requested frequency */
-	while ((spi_hz > u32_Hertz) && (prescaler_rank < last_index)) {
-		spi_hz = spi_hz / 2;
+	while ((pCtx->aRankHz[prescaler_rank] > u32_Hertz) && (prescaler_rank < last_index)) {
 		prescaler_rank++;
 	}
 
-	/*  Use the best fit pre-scaler */
-	paSPI_BusHandle[p_Device->bus_id]->Init.BaudRatePrescaler = prescaler_table[prescaler_rank];
-
 	/*  In case maximum pre-scaler still gives too high freq, raise an error */
-	if (spi_hz > u32_Hertz) {
-		DBG_BSP("WRN: lowest SPI freq (%d)  higher than requested (%d)\r\n", spi_hz, (int)u32_Hertz);
+	if (pCtx->aRankHz[prescaler_rank] > u32_Hertz) {
+		DBG_BSP("WRN: lowest SPI freq (%d)  higher than requested (%d)\r\n", (int)pCtx->aRankHz[prescaler_rank], (int)u32_Hertz);
+	}
+
+	DBG_BSP("spi_frequency, request:%d, select:%d\r\n", (int)u32_Hertz, (int)pCtx->aRankHz[prescaler_rank]);
+
+	if (p_handle->State == HAL_SPI_STATE_RESET)
+	{
+		/* Not initialized yet, go through the HAL */
+		p_handle->Init.BaudRatePrescaler = prescaler_table[prescaler_rank];
+		pCtx->u32SwitchCnt++;
+		ret = BSP_Spi_Init(p_Device);
+		/* The request is cached only once the prescaler is really set */
+		pCtx->u32LastHz = (ret == DEV_SUCCESS)?(u32_Hertz):(0);
+		return ret;
+	}
+
+	if (p_handle->Init.BaudRatePrescaler == prescaler_table[prescaler_rank])
+	{
+		/* Same prescaler */
+		pCtx->u32LastHz = u32_Hertz;
+		pCtx->u32ElideCnt++;
+		return DEV_SUCCESS;
 	}
 
-	DBG_BSP("spi_frequency, request:%d, select:%d\r\n", (int)u32_Hertz, spi_hz);
+	if (p_handle->State != HAL_SPI_STATE_READY)
+	{
+		return DEV_BUSY;
+	}
 
-	return BSP_Spi_Init(p_Device);
+	/* Wait for the end of the current frame (bounded) */
+	while (p_handle->Instance->SR & SPI_SR_BSY)
+	{
+		if (--u32Tmo == 0)
+		{
+			DBG_BSP("SPI %x Set bitrate: busy timeout\r\n", p_handle->Instance);
+			return DEV_BUSY;
+		}
+	}
+
+	/*  Use the best fit pre-scaler : register level switch, SPI must be disabled */
+	u32Spe = p_handle->Instance->CR1 & SPI_CR1_SPE;
+	CLEAR_BIT(p_handle->Instance->CR1, SPI_CR1_SPE);
+	MODIFY_REG(p_handle->Instance->CR1, SPI_CR1_BR, prescaler_table[prescaler_rank]);
+	SET_BIT(p_handle->Instance->CR1, u32Spe);
+	p_handle->Init.BaudRatePrescaler = prescaler_table[prescaler_rank];
+	pCtx->u32LastHz = u32_Hertz;
+	pCtx->u32SwitchCnt++;
+	return DEV_SUCCESS;
+}
+
+uint32_t BSP_Spi_GetBitrateSwitchCnt (const p_spi_dev_t p_Device, uint32_t *pu32Elided)
+{
+	spi_br_ctx_t *pCtx = &aSpiBrCtx[p_Device->bus_id];
+	if (pu32Elided)
+	{
+		*pu32Elided = pCtx->u32ElideCnt;
+	}
+	return pCtx->u32SwitchCnt;
 }
 
 uint8_t BSP_Spi_SetClockPhase (const p_spi_dev_t p_Device, const bool b_Flag)
@@ -245,6 +332,11 @@ uint8_t BSP_Spi_ReadWrite (const p_spi_dev_t p_Device, spi_transceiver_s* const
 {
 	uint8_t ret = DEV_SUCCESS;
 	uint8_t u8_Status;
+	if ( (p_Xfr->ReceiverBytes <= SPI_SHORT_XFER_MAX) &&
+		 (paSPI_BusHandle[p_Device->bus_id]->Init.DataSize == SPI_DATASIZE_8BIT) )
+	{
+		return BSP_Spi_ReadWrite_Short(p_Device, p_Xfr->pTransmitter, p_Xfr->pReceiver, (uint8_t)p_Xfr->ReceiverBytes);
+	}
 	if (HAL_SPI_GetState(paSPI_BusHandle[p_Device->bus_id]) == HAL_SPI_STATE_READY)
 	{
 		BSP_Gpio_SetLow(p_Device->ss_port, p_Device->ss_pin);
@@ -265,3 +357,61 @@ uint8_t BSP_Spi_ReadWrite (const p_spi_dev_t p_Device, spi_transceiver_s* const
 	}
 	return ret;
 }
+
+/*
+ * Short transfer, register level with inline polling.
+ * - no HAL state machine, no tick based timeout
+ * - RX FIFO threshold set to 1/4 (RXNE on each received byte)
+ * - chip select driven through BRR/BSRR
+ * - TX is kept at most 2 bytes ahead of RX, so the RX FIFO never overflow
+ */
+uint8_t BSP_Spi_ReadWrite_Short (const p_spi_dev_t p_Device, const uint8_t *pTx, uint8_t *pRx, uint8_t u8Size)
+{
+	SPI_HandleTypeDef *p_handle = paSPI_BusHandle[p_Device->bus_id];
+	SPI_TypeDef *pSpi = p_handle->Instance;
+	GPIO_TypeDef *pSsPort = (GPIO_TypeDef *)p_Device->ss_port;
+	uint32_t u32Tmo = SPI_SHORT_XFER_TMO;
+	uint32_t u32Sr;
+	uint8_t u8TxIdx = 0;
+	uint8_t u8RxIdx = 0;
+	uint8_t ret = DEV_SUCCESS;
+
+	if (p_handle->State != HAL_SPI_STATE_READY)
+	{
+		return DEV_BUSY;
+	}
+
+	SET_BIT(pSpi->CR2, SPI_CR2_FRXTH);
+	if ( !(pSpi->CR1 & SPI_CR1_SPE) )
+	{
+		SET_BIT(pSpi->CR1, SPI_CR1_SPE);
+	}
+	/* Flush left-over from the RX FIFO */
+	while (pSpi->SR & SPI_SR_FRLVL)
+	{
+		(void)*(__IO uint8_t *)&pSpi->DR;
+	}
+
+	pSsPort->BRR = p_Device->ss_pin;
+	while (u8RxIdx < u8Size)
+	{
+		u32Sr = pSpi->SR;
+		if ( (u8TxIdx < u8Size) && (u8TxIdx - u8RxIdx < 2) && (u32Sr & SPI_SR_TXE) )
+		{
+			*(__IO uint8_t *)&pSpi->DR = pTx[u8TxIdx++];
+		}
+		if (u32Sr & SPI_SR_RXNE)
+		{
+			pRx[u8RxIdx++] = *(__IO uint8_t *)&pSpi->DR;
+			u32Tmo = SPI_SHORT_XFER_TMO;
+		}
+		else if (--u32Tmo == 0)
+		{
+			DBG_BSP("SPI %x Short transfer: timeout\r\n", pSpi);
+			ret = DEV_FAILURE;
+			break;
+		}
+	}
+	pSsPort->BSRR = p_Device->ss_pin;
+	return ret;
+}
@@ -49,9 +49,22 @@ spi_dev_t spi_ADF7030 =
 {
 	.bus_id  = SPI_ID_MAIN,
 	.ss_port = GPIO_PORT(ADF7030_SS),
-	.ss_pin  = GPIO_PIN(ADF7030_SS)
+	.ss_pin  = GPIO_PIN(ADF7030_SS),
+	.miso_port = GPIO_PORT(RADIO_MISO),
+	.miso_pin  = GPIO_PIN(RADIO_MISO)
 };
 
+#ifdef HAS_SECOND_RADIO
+spi_dev_t spi_ADF7030_AUX =
+{
+	.bus_id  = SPI_ID_AUX,
+	.ss_port = GPIO_PORT(ADF7030_2_SS),
+	.ss_pin  = GPIO_PIN(ADF7030_2_SS),
+	.miso_port = GPIO_PORT(RADIO_2_MISO),
+	.miso_pin  = GPIO_PIN(RADIO_2_MISO)
+};
+#endif
+
 /******************************************************************************/
 
 const char *pa_HalErrMsg[] = {
@@ -74,9 +87,15 @@ extern LPTIM_HandleTypeDef hlptim2;
 
 /*******************************************************************************/
 extern SPI_HandleTypeDef hspi1;
+#ifdef HAS_SECOND_RADIO
+extern SPI_HandleTypeDef hspi2;
+#endif
 SPI_HandleTypeDef *paSPI_BusHandle[SPI_ID_MAX] =
 {
 	[SPI_ID_MAIN] = &hspi1,
+#ifdef HAS_SECOND_RADIO
+	[SPI_ID_AUX]  = &hspi2,
+#endif
 };
 
 /*******************************************************************************/
@@ -49,6 +49,41 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
 
+#ifndef ADF7030_1_CFG_PATCH_ADDR
+/*! Sequences written from this address (program RAM) are considered as patch
+ *  (resident) data, the ones written below it as configuration data. */
+#define ADF7030_1_CFG_PATCH_ADDR 0x20001000UL
+#endif
+
+#ifndef ADF7030_1_CFG_VERIFY_WORDS
+/*! Number of words read back at once by adf7030_1__VerifyConfiguration */
+#define ADF7030_1_CFG_VERIFY_WORDS 16
+#endif
+
+#ifndef ADF7030_1_CFG_PACKED
+/*! Enable the support of packed (LZSS compressed) cfg images. Packed images
+ *  are generated at build time by tools/build_support/cfg_pack.py and are
+ *  recognized by their header, so raw images are still accepted. */
+#define ADF7030_1_CFG_PACKED 0
+#endif
+
+/*! Packed cfg image magic (first byte of a raw image is always 0) */
+#define ADF7030_1_CFG_PACK_MAGIC   0x5A
+/*! Packed cfg image version : 2^8 bytes window, 3 bits copy length */
+#define ADF7030_1_CFG_PACK_VERSION 0x83
+/*! Packed cfg image header size (magic, version, raw size) */
+#define ADF7030_1_CFG_PACK_HDR_SZ  4
+
+/*! Enumeration of configuration sequences filter */
+typedef enum {
+    /*! All sequences */
+    ADF7030_1_CFG_SEQ_ALL   = 0,
+    /*! Only sequences written below ADF7030_1_CFG_PATCH_ADDR */
+    ADF7030_1_CFG_SEQ_CFG   = 1,
+    /*! Only sequences written from ADF7030_1_CFG_PATCH_ADDR */
+    ADF7030_1_CFG_SEQ_PATCH = 2,
+} adf7030_1_cfg_seq_e;
+
 /* ADI Radio Configuration transfer function */
 uint8_t adf7030_1__SendConfiguration(
     adf7030_1_spi_info_t* pSPIDevInfo,
@@ -56,6 +91,22 @@ uint8_t adf7030_1__SendConfiguration(
     uint32_t              Size
 );
 
+/* ADI Radio partial Configuration transfer function */
+uint8_t adf7030_1__SendConfigurationPart(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    const uint8_t*        pCONFIG,
+    uint32_t              Size,
+    adf7030_1_cfg_seq_e   eSeq
+);
+
+/* ADI Radio Configuration verify function */
+uint8_t adf7030_1__VerifyConfiguration(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    const uint8_t*        pCONFIG,
+    uint32_t              Size,
+    adf7030_1_cfg_seq_e   eSeq
+);
+
 
 /** @} */ /* End of group adf7030-1__cfg Configuration */
 /** @} */ /* End of group adf7030-1 adf7030-1 Driver */
@@ -91,6 +91,14 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 // FIXME: increased form 256 to 300 due to "buffer" overflow of spi_CfgBuffer
 #define ADF7030_1_SPI_BUFFER_SIZE 300u
 
+#ifndef ADF7030_1_NUM_DEV
+/*!
+ *  Defines the number of PHY Radio devices, each one has its own SPI and
+ *  configuration transfer buffers.
+ */
+#define ADF7030_1_NUM_DEV                   1
+#endif
+
 /*!
  *  Defines the maximum size of an SPI transaction.
  *  The Radio drivers requires a minimum of 8bytes used for command framing
@@ -452,6 +460,8 @@ typedef struct adf7030_1_spi_info_s
     void*                   hDevInfo; //adf7030_1_info_t
     /*! SPI device handle */
     void*                   hSPIDevice;
+    /*! Device index (selects the SPI and configuration buffers) */
+    uint8_t                 nDevId;
     /*! SPI TX transaction buffer */
     uint8_t*                pSPI_TX_BUFF;
     /*! SPI RX transaction buffer */
@@ -464,6 +474,24 @@ typedef struct adf7030_1_spi_info_s
     uint32_t                nClkFreq_Current;
     /*! SPI PHY pointer */
     adf7030_1_spi_pntr      PHY_PNTR;
+    /*! SPI PHY user pointers cache (PNTR_CUSTOM0_ADDR to PNTR_CUSTOM2_ADDR) */
+    uint32_t                PNTR_CACHE[3];
+    /*! Key (configuration image hash) the pointers cache is valid for */
+    uint32_t                nPntrCacheKey;
+    /*! Number of pointers restore from cache (without read back) */
+    uint32_t                nPntrCacheHit;
+    /*! Number of pointers read back (cache miss or spot check) */
+    uint32_t                nPntrCacheMiss;
+    /*! Number of spot checks that didn't match the cache */
+    uint32_t                nPntrCacheBad;
+    /*! Pointers cache is valid */
+    uint8_t                 bPntrCacheValid;
+    /*! Restore counter, for the periodic spot check */
+    uint8_t                 nPntrCacheCnt;
+    /*! Custom pointers usage counters (used by the pointer allocator) */
+    uint16_t                nPntrUse[3];
+    /*! Number of custom pointers (re)allocation */
+    uint32_t                nPntrAllocCnt;
     /*! SPI Driver communication result */
     adf7030_1_res_e         eXferResult;
     /*! SPI status from last transaction */
@@ -589,6 +617,28 @@ typedef struct adf7030_1_device_s
 	uint8_t                     bTxPwrDone;
 	/*! Internal : Pending TX size */
 	uint8_t                     u8PendTXBuffSize;
+	/*! Internal : Staged TX size (next frame, uploaded while transmitting) */
+	uint8_t                     u8StagedTXBuffSize;
+	/*! Internal : TX slot of the pending frame */
+	uint8_t                     u8TxSlot;
+	/*! Internal : Size of the frame currently on air */
+	uint8_t                     u8OnAirTXBuffSize;
+	/*! Internal : Staged TX frame must be sent on TX complete */
+	uint8_t                     bTxChained;
+	/*! Internal : Sleeping with memory retention (configuration is still valid) */
+	uint8_t                     bRetained;
+	/*! Internal : Offline calibration image may be resident (not powered off since its upload) */
+	uint8_t                     bCalResident;
+	/*! Internal : Smart wake (sniff) receive is running */
+	uint8_t                     bSniffOn;
+	/*! Internal : WM6400 preamble and sync. word are staged in front of the TX buffer */
+	uint8_t                     bTxPrefixOn;
+	/*! Internal : Instance index in the Phy layer */
+	uint8_t                     u8InstId;
+	/*! Internal : Last wake-up to ready time (in µs) */
+	uint32_t                    u32WakeUpTime;
+	/*! Internal : Last power-on (or reset) sequence time (in µs) */
+	uint32_t                    u32PwrOnTime;
     /*! Internal : Set calibration parts */
 	radio_cal_cfg0_t            CalCfg;
 
@@ -94,6 +94,41 @@ typedef adf7030_1_res_e (* ADF7030_1_SPI_Xfer)(
 #define ADF703x_SPI_MEM_SHORT       (0 << 3)
 #define ADF703x_SPI_MEM_LONG        (1 << 3)
 
+#ifndef ADF7030_1_SPI_BENCH
+/*! Enable the SPI transaction cycle count benchmark */
+#define ADF7030_1_SPI_BENCH 0
+#endif
+
+#ifndef ADF7030_1_PNTR_CACHE_CHECK
+/*! Period (in number of restore) of the pointers cache spot check (read back) */
+#define ADF7030_1_PNTR_CACHE_CHECK  16
+#endif
+
+#ifndef ADF7030_1_PNTR_ALLOC_POOL
+/*! Number of custom pointers (from PNTR_CUSTOM0_ADDR) managed by the allocator,
+ *  PNTR_CUSTOM2_ADDR is kept for the PHY state polling */
+#define ADF7030_1_PNTR_ALLOC_POOL   2
+#endif
+
+#ifndef ADF7030_1_PNTR_STATIC_NB
+/*! Number of custom pointers of the pool pinned to ADF7030_1_PNTR_STATIC_PROFILE,
+ *  so never moved by the allocator. They are the last ones of the pool,
+ *  PNTR_CUSTOM0_ADDR (directly used by some accessors) is never pinned */
+#define ADF7030_1_PNTR_STATIC_NB    0
+#endif
+
+#ifndef ADF7030_1_PNTR_STATIC_PROFILE
+/*! Static pointers profile (at least ADF7030_1_PNTR_STATIC_NB addresses) */
+#define ADF7030_1_PNTR_STATIC_PROFILE { GENERIC_PKT_BASE }
+#endif
+
+#if ADF7030_1_PNTR_STATIC_NB >= ADF7030_1_PNTR_ALLOC_POOL
+#error "At least one custom pointer of the pool must be left to the allocator"
+#endif
+
+/*! Number of custom pointers moved by the allocator (from PNTR_CUSTOM0_ADDR) */
+#define ADF7030_1_PNTR_DYN_NB (ADF7030_1_PNTR_ALLOC_POOL - ADF7030_1_PNTR_STATIC_NB)
+
 /*! \endcond */
 
 uint8_t adf7030_1__SPI_SetSpeed(
@@ -109,6 +144,19 @@ uint8_t adf7030_1__SPI_GetMMapPointers(
     adf7030_1_spi_info_t* pSPIDevInfo
 );
 
+uint8_t adf7030_1__SPI_RestoreMMapPointers(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint32_t              nKey
+);
+
+uint8_t adf7030_1__SPI_SetMMapProfile(
+    adf7030_1_spi_info_t* pSPIDevInfo
+);
+
+void adf7030_1__SPI_InvalidMMapPointers(
+    adf7030_1_spi_info_t* pSPIDevInfo
+);
+
 void adf7030_1__SPI_FindMMapPointer(
     adf7030_1_spi_info_t* pSPIDevInfo,
     uint32_t              Addr,
@@ -121,6 +169,20 @@ uint8_t adf7030_1__SPI_SetMMapCustomPntr0(
     uint32_t              Addr
 );
 
+uint8_t adf7030_1__SPI_SetMMapCustomPntr(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    adf7030_1_spi_pntr_t  PNTR_ID,
+    uint32_t              Addr
+);
+
+uint8_t adf7030_1__SPI_AllocMMapPointer(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint32_t              Addr,
+    uint8_t               bExact,
+    adf7030_1_spi_pntr_t* pPNTR_ID,
+    uint8_t*              pOffset
+);
+
 uint8_t adf7030_1__SPI_wr_word_b_a(
     adf7030_1_spi_info_t* pSPIDevInfo,
     uint32_t              AddrIn,
@@ -237,6 +299,32 @@ void adf7030_1__SPI_ReadWrite_Fast(
     uint32_t              nSize
 );
 
+#if ADF7030_1_SPI_BENCH
+/*! Enumeration of SPI transaction type (for benchmark) */
+typedef enum {
+    ADF7030_1_SPI_OP_NOP = 0, /*!< NOP, status polling */
+    ADF7030_1_SPI_OP_CMD,     /*!< Radio command */
+    ADF7030_1_SPI_OP_RD,      /*!< Short memory read */
+    ADF7030_1_SPI_OP_WR,      /*!< Short memory write */
+    ADF7030_1_SPI_OP_BLOCK,   /*!< Block transfer */
+    ADF7030_1_SPI_OP_NB
+} adf7030_1_spi_op_e;
+
+/*! Structure to hold the cycle count of one SPI transaction type */
+typedef struct {
+    uint32_t nCnt;    /*!< Number of transaction */
+    uint32_t nCycles; /*!< Cumulated cycles */
+    uint32_t nMin;    /*!< Minimum cycles */
+    uint32_t nMax;    /*!< Maximum cycles */
+} adf7030_1_spi_bench_t;
+
+const adf7030_1_spi_bench_t* adf7030_1__SPI_GetBench(
+    adf7030_1_spi_op_e eOp
+);
+
+void adf7030_1__SPI_ClrBench(void);
+#endif
+
 void adf7030_1__SPI_Xfer_WriteBuff(
     void*    pDest,
     void*    pSrc,
@@ -253,6 +341,12 @@ uint8_t adf7030_1__SPI_Xfer_ReadBuff(
     uint32_t mode
 );
 
+void adf7030_1__SPI_Xfer_Swap(
+    void*       pDest,
+    const void* pSrc,
+    uint32_t    nWords
+);
+
 /** @}*/ /* End of group adf7030-1__spi SPI Communication Interface*/
 /** @}*/ /* End of group adf7030-1 adf7030-1 Driver*/
 
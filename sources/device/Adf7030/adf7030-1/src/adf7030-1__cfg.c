@@ -85,8 +85,64 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /*! \endcond */
 
-/* SPI Configuration transfer buffer */  
-static uint8_t spi_CfgBuffer[ADF7030_1_SPI_BUFFER_SIZE];
+/* SPI Configuration transfer buffer (one per device) */
+static uint8_t spi_CfgBuffer[ADF7030_1_NUM_DEV][ADF7030_1_SPI_BUFFER_SIZE];
+
+#if (ADF7030_1_CFG_PACKED == 1)
+/* Packed cfg stream : window size (bits), copy length (bits), min copy length */
+#define CFG_PACK_WIN_BITS 8
+#define CFG_PACK_LEN_BITS 3
+#define CFG_PACK_MIN_LEN  2
+
+/* Unpacked sequence buffer (command, address and data) */
+static uint8_t spi_CfgSeqBuffer[ADF7030_1_NUM_DEV][ADF7030_1_SPI_BUFFER_SIZE + 8];
+
+/* Unpack history window */
+static uint8_t spi_CfgWindow[ADF7030_1_NUM_DEV][1 << CFG_PACK_WIN_BITS];
+#endif
+
+/*! Cfg image sequence reader */
+typedef struct {
+    const uint8_t* pCONFIG;  /*!< Pointer to cfg binary blob */
+    uint32_t       Size;     /*!< Size of the (unpacked) cfg image */
+    uint32_t       Pos;      /*!< Current position in the (unpacked) cfg image */
+#if (ADF7030_1_CFG_PACKED == 1)
+    const uint8_t* pIn;      /*!< Current position in the packed stream */
+    const uint8_t* pEnd;     /*!< End of the packed stream */
+    uint32_t       u32Bits;  /*!< Bits accumulator */
+    uint8_t        nBits;    /*!< Number of available bits in the accumulator */
+    uint8_t        nWinPos;  /*!< Current position in the window */
+    uint8_t        nCpyLen;  /*!< Remaining bytes to copy from the window */
+    uint16_t       nCpyOff;  /*!< Offset of the copy in the window */
+    uint8_t        bPacked;  /*!< The cfg image is packed */
+    uint8_t        nDevId;   /*!< Device index (selects the unpack buffers) */
+#endif
+} cfg_reader_t;
+
+/* Initialize the cfg image sequence reader */
+static uint8_t adf7030_1__CfgReaderInit(
+    cfg_reader_t*  pReader,
+    uint8_t        nDevId,
+    const uint8_t* pCONFIG,
+    uint32_t       Size
+);
+
+/* Get the next sequence from the cfg image */
+static uint8_t adf7030_1__CfgReaderNext(
+    cfg_reader_t*   pReader,
+    const uint8_t** ppSeqData,
+    uint32_t*       pLength
+);
+
+/* Check if a sequence is selected by the given filter */
+static uint8_t adf7030_1__CfgSeqSelected(
+    const uint8_t*        pSeqData,
+    uint32_t              length,
+    adf7030_1_cfg_seq_e   eSeq
+);
+
+/* Rotating 32bits sum, used to compare the read back with the cfg image */
+#define CFG_SUM(sum, word) ( (((sum) << 1) | ((sum) >> 31)) + (word) )
 
 /* ADI Radio SPI sequence configuration transfer */
 static uint8_t adf7030_1__XferCfgSeq(
@@ -121,43 +177,418 @@ uint8_t adf7030_1__SendConfiguration(
     uint32_t              Size
 )
 {
+    return adf7030_1__SendConfigurationPart( pSPIDevInfo, pCONFIG, Size, ADF7030_1_CFG_SEQ_ALL);
+}
+
+/**
+ * @brief       ADI Radio partial Configuration transfer function
+ *
+ * @param [in]  pSPIDevInfo     Pointer to the SPI device info structure of the 
+ *                              ADI RF Driver used to communicate with the
+ *                              adf7030-1 PHY.
+ *
+ * @param [in]  pCONFIG         Pointer to cfg binary blob (raw or packed)
+ *
+ * @param [in]  Size            Size of the cfg binary blob
+ *
+ * @param [in]  eSeq            Sequences to transfer (all, configuration or
+ *                              patch ones, see ADF7030_1_CFG_PATCH_ADDR).
+ *
+ * @note                        Packed images are unpacked one sequence at a time,
+ *                              so the whole image is never held in RAM.
+ *
+ * @return      Status
+ *  - #0    If the configuration was written transfered to the Host.
+ *  - #1    [D] If the configuration transfert failed.
+ */
+
+uint8_t adf7030_1__SendConfigurationPart(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    const uint8_t*        pCONFIG,
+    uint32_t              Size,
+    adf7030_1_cfg_seq_e   eSeq
+)
+{
+    cfg_reader_t sReader;
+    const uint8_t * pSeqData;
+    uint32_t length;
 
-    uint32_t array_position = 0;
     if ( (pSPIDevInfo == NULL) || (pCONFIG ==NULL) ) {
     	return 1;
     }
+    if ( adf7030_1__CfgReaderInit( &sReader, pSPIDevInfo->nDevId, pCONFIG, Size) ) {
+    	return 1;
+    }
     do 
     { 
-      // Calculate the number of bytes to write
-      uint32_t length =  (*(pCONFIG + array_position ) << 16) | 
-                         (*(pCONFIG + array_position + 1) << 8) |
-                         (*(pCONFIG + array_position + 2));
-      
-      if(length > 0xFFFF)
+      // Get the next sequence and its length
+      if ( adf7030_1__CfgReaderNext( &sReader, &pSeqData, &length) )
       {
          return 1;
-      } 
-      
-      // Write the SPI data pointed to location (MEMORY_FILE + array_position) with specified length (length)
-      const uint8_t * pSeqData = (pCONFIG + array_position + 3);
+      }
       
-      // Transfer the Configuration sequence
-      if(adf7030_1__XferCfgSeq( pSPIDevInfo,
-                                pSeqData,
-                                length - 4) )
+      // Transfer the Configuration sequence, if selected
+      if( adf7030_1__CfgSeqSelected( pSeqData, length, eSeq) )
       {
-          return 1;
+          if(adf7030_1__XferCfgSeq( pSPIDevInfo,
+                                    (uint8_t *)pSeqData,
+                                    length - 4) )
+          {
+              return 1;
+          }
       }
-      
-      // Update the array position to point to the next block
-      array_position += length;
     
-    }while(array_position < Size); // Continue operation until full data file has been written
+    }while(sReader.Pos < sReader.Size); // Continue operation until full data file has been written
     
     return 0;
 }
 
 
+/**
+ * @brief       ADI Radio Configuration verify function
+ *
+ * @param [in]  pSPIDevInfo     Pointer to the SPI device info structure of the 
+ *                              ADI RF Driver used to communicate with the
+ *                              adf7030-1 PHY.
+ *
+ * @param [in]  pCONFIG         Pointer to cfg binary blob (raw or packed)
+ *
+ * @param [in]  Size            Size of the cfg binary blob
+ *
+ * @param [in]  eSeq            Sequences to verify (all, configuration or
+ *                              patch ones, see ADF7030_1_CFG_PATCH_ADDR).
+ *
+ * @note                        Each 32bits address block sequence is fully read
+ *                              back (by ADF7030_1_CFG_VERIFY_WORDS words) and
+ *                              its rotating sum is compared with the one of
+ *                              the cfg image, so nothing has to be buffered.
+ *
+ * @return      Status
+ *  - #0    If the read back matches the configuration.
+ *  - #1    [D] If it doesn't match or if the transfert failed.
+ */
+
+uint8_t adf7030_1__VerifyConfiguration(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    const uint8_t*        pCONFIG,
+    uint32_t              Size,
+    adf7030_1_cfg_seq_e   eSeq
+)
+{
+    cfg_reader_t sReader;
+    const uint8_t * pSeqData;
+    uint32_t length;
+    const uint8_t * pRef;
+    uint32_t aRead[ADF7030_1_CFG_VERIFY_WORDS];
+    uint32_t Addr;
+    uint32_t nLeft;
+    uint32_t nWords;
+    uint32_t u32SumRd;
+    uint32_t u32SumRef;
+    uint32_t i;
+
+    if ( (pSPIDevInfo == NULL) || (pCONFIG ==NULL) ) {
+    	return 1;
+    }
+    if ( adf7030_1__CfgReaderInit( &sReader, pSPIDevInfo->nDevId, pCONFIG, Size) ) {
+    	return 1;
+    }
+    do
+    {
+      if ( adf7030_1__CfgReaderNext( &sReader, &pSeqData, &length) )
+      {
+         return 1;
+      }
+
+      if( adf7030_1__CfgSeqSelected( pSeqData, length, eSeq) &&
+          ((*pSeqData & 0x78) == ( ADF703x_SPI_MEM_WRITE | ADF703x_SPI_MEM_BLOCK | ADF703x_SPI_MEM_ADDRESS | ADF703x_SPI_MEM_LONG )) &&
+          (length >= 12) )
+      {
+          // Sequence : cmd, address, data words (see adf7030_1__XferCfgSeq)
+          Addr = __ntohl(*(uint32_t *)(pSeqData + 1));
+          pRef = pSeqData + 5;
+          nLeft = (length - 8) >> 2;
+          u32SumRd = 0;
+          u32SumRef = 0;
+          while (nLeft)
+          {
+              nWords = (nLeft > ADF7030_1_CFG_VERIFY_WORDS)?(ADF7030_1_CFG_VERIFY_WORDS):(nLeft);
+              if(adf7030_1__SPI_rd_word_b_a( pSPIDevInfo, Addr, nWords, aRead))
+              {
+                  return 1;
+              }
+              for (i = 0; i < nWords; i++)
+              {
+                  u32SumRd = CFG_SUM(u32SumRd, aRead[i]);
+                  u32SumRef = CFG_SUM(u32SumRef, __ntohl(*(uint32_t *)pRef));
+                  pRef += 4;
+              }
+              Addr += (nWords << 2);
+              nLeft -= nWords;
+          }
+          if( u32SumRd != u32SumRef )
+          {
+              return 1;
+          }
+      }
+
+    }while(sReader.Pos < sReader.Size);
+
+    return 0;
+}
+
+/**
+ * @brief       Check if a sequence is selected by the given filter
+ *
+ * @param [in]  pSeqData        Pointer to the sequence (command, address, data)
+ *
+ * @param [in]  length          Length of the sequence (with its length field)
+ *
+ * @param [in]  eSeq            Sequences filter
+ *
+ * @note                        Sequences without 32bits address are taken as
+ *                              configuration ones.
+ *
+ * @return      1 if the sequence is selected, 0 otherwise
+ */
+
+static uint8_t adf7030_1__CfgSeqSelected(
+    const uint8_t*        pSeqData,
+    uint32_t              length,
+    adf7030_1_cfg_seq_e   eSeq
+)
+{
+    uint32_t Addr;
+
+    if (eSeq == ADF7030_1_CFG_SEQ_ALL)
+    {
+        return 1;
+    }
+    if ( ((*pSeqData & 0x78) != ( ADF703x_SPI_MEM_WRITE | ADF703x_SPI_MEM_BLOCK | ADF703x_SPI_MEM_ADDRESS | ADF703x_SPI_MEM_LONG )) ||
+         (length < 8) )
+    {
+        return (eSeq == ADF7030_1_CFG_SEQ_CFG);
+    }
+    Addr = __ntohl(*(uint32_t *)(pSeqData + 1));
+    return ( (eSeq == ADF7030_1_CFG_SEQ_PATCH) == (Addr >= ADF7030_1_CFG_PATCH_ADDR) );
+}
+
+#if (ADF7030_1_CFG_PACKED == 1)
+/**
+ * @brief       Get bits from the packed stream
+ *
+ * @param [in]  pReader         Pointer to the cfg reader
+ *
+ * @param [in]  nBits           Number of bits to get (8 max.)
+ *
+ * @return      The bits value, or -1 if the packed stream is exhausted
+ */
+
+static int32_t adf7030_1__CfgGetBits(
+    cfg_reader_t* pReader,
+    uint8_t       nBits
+)
+{
+    while (pReader->nBits < nBits)
+    {
+        if (pReader->pIn >= pReader->pEnd)
+        {
+            return -1;
+        }
+        pReader->u32Bits = (pReader->u32Bits << 8) | *(pReader->pIn++);
+        pReader->nBits += 8;
+    }
+    pReader->nBits -= nBits;
+    return (int32_t)((pReader->u32Bits >> pReader->nBits) & ((1UL << nBits) - 1));
+}
+
+/**
+ * @brief       Unpack bytes from the packed stream
+ *
+ * @param [in]  pReader         Pointer to the cfg reader
+ *
+ * @param [out] pOut            Pointer to the output buffer
+ *
+ * @param [in]  nSize           Number of bytes to unpack
+ *
+ * @note                        The unpacking can be stopped at any point, a
+ *                              pending copy is resumed on the next call.
+ *
+ * @return      Status
+ *  - #0    If nSize bytes have been unpacked.
+ *  - #1    [D] If the packed stream is exhausted.
+ */
+
+static uint8_t adf7030_1__CfgUnpack(
+    cfg_reader_t* pReader,
+    uint8_t*      pOut,
+    uint32_t      nSize
+)
+{
+    int32_t i32Val;
+    int32_t i32Len;
+    uint8_t c;
+
+    while (nSize)
+    {
+        if (pReader->nCpyLen == 0)
+        {
+            i32Val = adf7030_1__CfgGetBits(pReader, 1);
+            if (i32Val < 0) { return 1; }
+            if (i32Val == 0)
+            {
+                // literal
+                i32Val = adf7030_1__CfgGetBits(pReader, 8);
+                if (i32Val < 0) { return 1; }
+                c = (uint8_t)i32Val;
+                spi_CfgWindow[pReader->nDevId][pReader->nWinPos++] = c;
+                *pOut++ = c;
+                nSize--;
+                continue;
+            }
+            // copy from window
+            i32Val = adf7030_1__CfgGetBits(pReader, CFG_PACK_WIN_BITS);
+            i32Len = adf7030_1__CfgGetBits(pReader, CFG_PACK_LEN_BITS);
+            if ( (i32Val < 0) || (i32Len < 0) ) { return 1; }
+            pReader->nCpyOff = (uint16_t)(i32Val + 1);
+            pReader->nCpyLen = (uint8_t)(i32Len + CFG_PACK_MIN_LEN);
+        }
+        c = spi_CfgWindow[pReader->nDevId][(uint8_t)(pReader->nWinPos - pReader->nCpyOff)];
+        spi_CfgWindow[pReader->nDevId][pReader->nWinPos++] = c;
+        pReader->nCpyLen--;
+        *pOut++ = c;
+        nSize--;
+    }
+    return 0;
+}
+#endif
+
+/**
+ * @brief       Initialize the cfg image sequence reader
+ *
+ * @param [out] pReader         Pointer to the cfg reader
+ *
+ * @param [in]  nDevId          Device index (selects the unpack buffers)
+ *
+ * @param [in]  pCONFIG         Pointer to cfg binary blob (raw or packed)
+ *
+ * @param [in]  Size            Size of the cfg binary blob
+ *
+ * @return      Status
+ *  - #0    If the reader is ready.
+ *  - #1    [D] If the cfg image is not supported.
+ */
+
+static uint8_t adf7030_1__CfgReaderInit(
+    cfg_reader_t*  pReader,
+    uint8_t        nDevId,
+    const uint8_t* pCONFIG,
+    uint32_t       Size
+)
+{
+    pReader->pCONFIG = pCONFIG;
+    pReader->Size = Size;
+    pReader->Pos = 0;
+#if (ADF7030_1_CFG_PACKED == 1)
+    pReader->bPacked = 0;
+    pReader->nDevId = nDevId;
+    if ( (Size >= ADF7030_1_CFG_PACK_HDR_SZ) && (pCONFIG[0] == ADF7030_1_CFG_PACK_MAGIC) )
+    {
+        if (pCONFIG[1] != ADF7030_1_CFG_PACK_VERSION)
+        {
+            return 1;
+        }
+        pReader->Size = (pCONFIG[2] << 8) | pCONFIG[3];
+        pReader->pIn = pCONFIG + ADF7030_1_CFG_PACK_HDR_SZ;
+        pReader->pEnd = pCONFIG + Size;
+        pReader->u32Bits = 0;
+        pReader->nBits = 0;
+        pReader->nWinPos = 0;
+        pReader->nCpyLen = 0;
+        pReader->nCpyOff = 0;
+        pReader->bPacked = 1;
+    }
+#else
+    (void)nDevId;
+#endif
+    return (pReader->Size)?(0):(1);
+}
+
+/**
+ * @brief       Get the next sequence from the cfg image
+ *
+ * @param [in]  pReader         Pointer to the cfg reader
+ *
+ * @param [out] ppSeqData       Pointer to the sequence (command byte)
+ *
+ * @param [out] pLength         Length of the sequence (including its 3 bytes
+ *                              length field)
+ *
+ * @note                        For a packed image, the sequence is unpacked in
+ *                              an internal buffer, valid until the next call.
+ *
+ * @return      Status
+ *  - #0    If the sequence is available.
+ *  - #1    [D] If the sequence is malformed.
+ */
+
+static uint8_t adf7030_1__CfgReaderNext(
+    cfg_reader_t*   pReader,
+    const uint8_t** ppSeqData,
+    uint32_t*       pLength
+)
+{
+    const uint8_t * pSeq;
+#if (ADF7030_1_CFG_PACKED == 1)
+    uint8_t aLen[3];
+    if (pReader->bPacked)
+    {
+        if (adf7030_1__CfgUnpack(pReader, aLen, 3))
+        {
+            return 1;
+        }
+        pSeq = aLen;
+    }
+    else
+#endif
+    {
+        if ( (pReader->Pos + 3) > pReader->Size )
+        {
+            return 1;
+        }
+        pSeq = pReader->pCONFIG + pReader->Pos;
+    }
+
+    // Calculate the number of bytes of the sequence
+    uint32_t length = (*(pSeq) << 16) | (*(pSeq + 1) << 8) | (*(pSeq + 2));
+
+    if( (length > 0xFFFF) || (length < 4) || ((pReader->Pos + length) > pReader->Size) )
+    {
+        return 1;
+    }
+
+#if (ADF7030_1_CFG_PACKED == 1)
+    if (pReader->bPacked)
+    {
+        if ( ((length - 3) > sizeof(spi_CfgSeqBuffer[0])) ||
+             adf7030_1__CfgUnpack(pReader, spi_CfgSeqBuffer[pReader->nDevId], length - 3) )
+        {
+            return 1;
+        }
+        *ppSeqData = spi_CfgSeqBuffer[pReader->nDevId];
+    }
+    else
+#endif
+    {
+        *ppSeqData = pSeq + 3;
+    }
+    *pLength = length;
+
+    // Update the position to point to the next sequence
+    pReader->Pos += length;
+    return 0;
+}
+
 /**
  * @brief       ADI Radio SPI sequence configuration transfer
  *
@@ -207,7 +638,7 @@ static uint8_t adf7030_1__XferCfgSeq(
                     // rev-ing is already done as part of the sequence
                     
                     // So for now, we just need to unrev data...
-                    uint32_t * pUNREV_BUFF = (uint32_t *)spi_CfgBuffer;
+                    uint32_t * pUNREV_BUFF = (uint32_t *)spi_CfgBuffer[pSPIDevInfo->nDevId];
                     uint32_t * pSEQ_BUFF = (uint32_t *)pData;
                     
                     pSEQ_BUFF++;
@@ -221,7 +652,7 @@ static uint8_t adf7030_1__XferCfgSeq(
                     if(adf7030_1__SPI_wr_word_b_a( pSPIDevInfo,
                                                    Addr,
                                                    SeqDataLen >> 2,
-                                                   (uint32_t *)spi_CfgBuffer) )
+                                                   (uint32_t *)spi_CfgBuffer[pSPIDevInfo->nDevId]) )
                     {
                         return 1;
                     }
@@ -238,7 +669,7 @@ static uint8_t adf7030_1__XferCfgSeq(
                     uint32_t SeqDataLen = Size;
 
                     // So for now, we just need to unrev data...
-                    uint32_t * pUNREV_BUFF = (uint32_t *)spi_CfgBuffer;
+                    uint32_t * pUNREV_BUFF = (uint32_t *)spi_CfgBuffer[pSPIDevInfo->nDevId];
                     uint32_t * pSEQ_BUFF = (uint32_t *)pData;
                     
                     pSEQ_BUFF++;
@@ -252,7 +683,7 @@ static uint8_t adf7030_1__XferCfgSeq(
                     if(adf7030_1__SPI_wr_word_b_p( pSPIDevInfo,
                                                    pntrID,
                                                    SeqDataLen >> 2,
-                                                   (uint32_t *)spi_CfgBuffer) )
+                                                   (uint32_t *)spi_CfgBuffer[pSPIDevInfo->nDevId]) )
                     {
                         return 1;
                     }
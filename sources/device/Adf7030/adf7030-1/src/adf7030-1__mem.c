@@ -560,10 +560,17 @@ uint8_t adf7030_1__XferDataBlock(
         uint32_t size = (Byte_Size == 0) ? pBLOCK->Size : Byte_Size;
 
         adf7030_1_spi_pntr_t PNTR_id;
-        int32_t PNTR_offset;
+        uint8_t PNTR_offset;
     
-        /* Get good PNTRid from pSPIDevInfo->PHY_PNTR[] */
-        adf7030_1__SPI_FindMMapPointer( pSPIDevInfo, PHYAddr, &PNTR_id, &PNTR_offset);
+        /* Get a pointer in range, transfer cut into sub transactions requires no offset */
+        if(adf7030_1__SPI_AllocMMapPointer( pSPIDevInfo,
+                                            PHYAddr,
+                                            (size > ADF7030_1_SPI_MAX_TRX_SIZE),
+                                            &PNTR_id,
+                                            &PNTR_offset) )
+        {
+            return 1;
+        }
         
         /* Setup pointer to Host start of data */
         uint8_t * pHostMem = (uint8_t *)(pBLOCK->pData + Byte_Offset);
@@ -575,20 +582,14 @@ uint8_t adf7030_1__XferDataBlock(
             pHostMem = NULL;
         }
         
-        /* No valid PHY SPI pointer available, use 8bits access with no offset */
-        if(PNTR_id == 0)
+        /* PHY SPI pointer on the block, use 8bits access with no offset */
+        if(PNTR_offset == 0)
         {
-            /* Change the SPI custom pointer 0 */
-            if(adf7030_1__SPI_SetMMapCustomPntr0( pSPIDevInfo, PHYAddr ) )
-            {
-                return 1;
-            }
-            
             if(bREAD_nWRITE == 1)
             {
                 /* Read from radio PHY */
                 if(adf7030_1__SPI_rd_cmp_byte_p_a( pSPIDevInfo,
-                                                   PNTR_CUSTOM0_ADDR,
+                                                   PNTR_id,
                                                    size,
                                                    pHostMem,
                                                    pHostRef) )
@@ -606,13 +607,13 @@ uint8_t adf7030_1__XferDataBlock(
                 }                    
             }else{
                 /* Write to radio PHY */
-                if(adf7030_1__SPI_wr_byte_p_a( pSPIDevInfo, PNTR_CUSTOM0_ADDR, size, pHostMem) )
+                if(adf7030_1__SPI_wr_byte_p_a( pSPIDevInfo, PNTR_id, size, pHostMem) )
                 {
                     return 1;
                 }  
             }
         }
-        /* Valid PHY SPI pointer available, use 8bits access with pointer offset */
+        /* PHY SPI pointer in range, use 8bits access with pointer offset */
         else
         {
             if(bREAD_nWRITE == 1)
@@ -1100,32 +1101,24 @@ void adf7030_1__SPI_SetBytes(
     uint32_t*             pRegVal
 )
 {   
-    /* Get current SPI custom pntr 0 value */ 
-    int32_t AddrDiff = (int32_t)Addr - (int32_t)(pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]);
-    
+    adf7030_1_spi_pntr_t PNTR_id;
     uint8_t Offset;
     
     /* Check if byte access is allowed at this address */
     uint8_t bByteAccess = adf7030_1__MEM_CheckByteAccess(Addr);
-    uint8_t bInrange = ((AddrDiff >= 0) & (AddrDiff < (255 + nbBytes))) ? 1 : 0;
     
-    if((bInrange == 1) && (bByteAccess == 1))
+    /* Get a pointer in range, word access requires the pointer on the word itself */
+    if ( adf7030_1__SPI_AllocMMapPointer( pSPIDevInfo,
+                                          (bByteAccess) ? (Addr) : ((Addr >> 2) << 2),
+                                          !bByteAccess,
+                                          &PNTR_id,
+                                          &Offset) )
+    {
+        /* Exit if error */
+        return ;
+    }
+    if(bByteAccess == 0)
     {
-      /* Here PNTR_CUSTOM0_ADDR is within range, just change the offset */
-        Offset = (uint8_t)AddrDiff; 
-    }else{
-      /* Here PNTR_CUSTOM0_ADDR is not within range, changing it, we shall */
-            
-        if(((Addr >> 2) << 2) != pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]) //Fix for double setup of pntr0
-        {
-            /* Setup the PHY Radio SPI pointer 0 address to Addr */
-            if ( adf7030_1__SPI_SetMMapCustomPntr0( pSPIDevInfo, ((Addr >> 2) << 2)) )
-            {
-            /* Exit if error */
-                return ;
-            }
-        }
-          
         Offset = Addr & 0x03;
     }
     
@@ -1151,7 +1144,7 @@ void adf7030_1__SPI_SetBytes(
         Value |= tmp_reg;
       
         /* Byte access is not permitted, do word access instead */
-        adf7030_1__SPI_wr_word_b_p( pSPIDevInfo, PNTR_CUSTOM0_ADDR, 1, &Value);
+        adf7030_1__SPI_wr_word_b_p( pSPIDevInfo, PNTR_id, 1, &Value);
 
     }
     else
@@ -1159,10 +1152,10 @@ void adf7030_1__SPI_SetBytes(
         if((Offset == 0) && (nbBytes == 4))
         {
           /* Write the 32bit alligned data */ 
-            adf7030_1__SPI_wr_word_b_p( pSPIDevInfo, PNTR_CUSTOM0_ADDR, 1, &Value);
+            adf7030_1__SPI_wr_word_b_p( pSPIDevInfo, PNTR_id, 1, &Value);
         }else{
           /* Write the nbBytes data */
-            adf7030_1__SPI_wr_byte_b_a( pSPIDevInfo, PNTR_CUSTOM0_ADDR, Offset, nbBytes, (uint8_t *)&Value);
+            adf7030_1__SPI_wr_byte_b_a( pSPIDevInfo, PNTR_id, Offset, nbBytes, (uint8_t *)&Value);
         }
     }
 }
@@ -1201,44 +1194,34 @@ uint32_t adf7030_1__SPI_GetBytes(
     /* SPI transfert result */
 	uint8_t Result = 0;
 
-      /* Get current SPI custom pntr 0 value */ 
-    int32_t AddrDiff = (int32_t)Addr - (int32_t)(pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]);
-    
+    adf7030_1_spi_pntr_t PNTR_id;
     uint8_t Offset;
     
     /* Check if byte access is allowed at this address */
     uint8_t bByteAccess = adf7030_1__MEM_CheckByteAccess(Addr);
-    uint8_t bInrange = ((AddrDiff >= 0) & (AddrDiff < (255 + nbBytes))) ? 1 : 0;
     
-    if((bInrange == 1) && (bByteAccess == 1))
+    /* Get a pointer in range, word access requires the pointer on the word itself */
+    Result = adf7030_1__SPI_AllocMMapPointer( pSPIDevInfo,
+                                              (bByteAccess) ? (Addr) : ((Addr >> 2) << 2),
+                                              !bByteAccess,
+                                              &PNTR_id,
+                                              &Offset);
+    /* Exit if error */
+    if(Result)
+    {
+        return(0);
+    }
+    if(bByteAccess == 0)
     {
-      /* Here PNTR_CUSTOM0_ADDR is within range, just change the offset */
-        Offset = (uint8_t)AddrDiff;
-      
-    }else{
-      /* Here PNTR_CUSTOM0_ADDR is not within range, changing it, we shall */
-            
-        if(((Addr >> 2) << 2) != pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]) //Fix for double setup of pntr0
-        {
-            /* Setup the PHY Radio SPI pointer 0 address to Addr */
-            Result = adf7030_1__SPI_SetMMapCustomPntr0( pSPIDevInfo, ((Addr >> 2) << 2));
-            
-            /* Exit if error */
-            if(Result)
-            {
-                return(0);
-            }
-        }
-
         Offset = Addr & 0x03;
     }
     
-    uint32_t RetVal;
+    uint32_t RetVal = 0;
     
     if(bByteAccess == 0)
     {
         /* Byte access is not permitted, do word access instead */
-        Result = adf7030_1__SPI_rd_word_b_p( pSPIDevInfo, PNTR_CUSTOM0_ADDR, 1, &RetVal);
+        Result = adf7030_1__SPI_rd_word_b_p( pSPIDevInfo, PNTR_id, 1, &RetVal);
         
         if(pRegVal)
         {
@@ -1262,7 +1245,7 @@ uint32_t adf7030_1__SPI_GetBytes(
         if((Offset == 0) && (nbBytes == 4))
         {
             /* Read the 32bit alligned data */  
-            Result = adf7030_1__SPI_rd_word_b_p( pSPIDevInfo, PNTR_CUSTOM0_ADDR, 1, &RetVal);
+            Result = adf7030_1__SPI_rd_word_b_p( pSPIDevInfo, PNTR_id, 1, &RetVal);
             
             if(pRegVal)
             {
@@ -1271,7 +1254,7 @@ uint32_t adf7030_1__SPI_GetBytes(
             }
         }else{
             /* Read the nbBytes data */
-            Result = adf7030_1__SPI_rd_byte_b_a( pSPIDevInfo, PNTR_CUSTOM0_ADDR, Offset, nbBytes, (uint8_t *)&RetVal);
+            Result = adf7030_1__SPI_rd_byte_b_a( pSPIDevInfo, PNTR_id, Offset, nbBytes, (uint8_t *)&RetVal);
         }
     }
     
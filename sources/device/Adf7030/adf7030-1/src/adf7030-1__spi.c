@@ -79,6 +79,32 @@ OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma diag_suppress=Pm073,Pm143
 #endif /* __ICCARM__ */
 
+#if ADF7030_1_SPI_BENCH
+static adf7030_1_spi_bench_t aSpiBench[ADF7030_1_SPI_OP_NB];
+
+static void _spi_bench_(uint8_t nCmd, uint32_t nSize, uint32_t nStart)
+{
+    adf7030_1_spi_op_e eOp;
+    uint32_t nCycles = cycles() - nStart;
+
+    if (nSize > SPI_SHORT_XFER_MAX)        { eOp = ADF7030_1_SPI_OP_BLOCK; }
+    else if (nCmd == CMD_NOP)              { eOp = ADF7030_1_SPI_OP_NOP; }
+    else if (nCmd & RADIO_CMD)             { eOp = ADF7030_1_SPI_OP_CMD; }
+    else if (nCmd & ADF703x_SPI_MEM_READ)  { eOp = ADF7030_1_SPI_OP_RD; }
+    else                                   { eOp = ADF7030_1_SPI_OP_WR; }
+
+    if (aSpiBench[eOp].nCnt == 0 || nCycles < aSpiBench[eOp].nMin) { aSpiBench[eOp].nMin = nCycles; }
+    if (nCycles > aSpiBench[eOp].nMax) { aSpiBench[eOp].nMax = nCycles; }
+    aSpiBench[eOp].nCycles += nCycles;
+    aSpiBench[eOp].nCnt++;
+}
+#define SPI_BENCH_START() uint32_t nBenchStart = cycles()
+#define SPI_BENCH_END(cmd, size) _spi_bench_(cmd, size, nBenchStart)
+#else
+#define SPI_BENCH_START()
+#define SPI_BENCH_END(cmd, size)
+#endif
+
 /*! \endcond */
 
 /**
@@ -176,6 +202,131 @@ uint8_t adf7030_1__SPI_GetMMapPointers(
                                        pPNTR));
 }
 
+/**
+ * @brief       Restore SPI Radio mmap pointers access
+ *
+ * @param [in]  pSPIDevInfo     Pointer to the SPI device info structure of the 
+ *                              ADI RF Driver used to communicate with the
+ *                              adf7030-1 PHY.
+ *
+ * @param [in]  nKey            Key (hash) of the configuration image for which
+ *                              pointers are requested.
+ *
+ * @note        The mmap pointers are deterministic for a given PHY radio
+ *              firmware and configuration. So, if the cache is valid for the
+ *              given key, pSPIDevInfo->PHY_PNTR[] is restored from it without
+ *              any SPI transfer. Otherwise, or every ADF7030_1_PNTR_CACHE_CHECK
+ *              restore (spot check), pointers are read back and the cache is
+ *              refreshed. A spot check that doesn't match the cache drops it
+ *              (counted in nPntrCacheBad), the read back pointers being kept.
+ *
+ * @return      Status
+ *  - #0    If the restore or readback of mmap pointers was succesfull.
+ *  - #1    [D] If the readback failed.
+ */
+
+uint8_t adf7030_1__SPI_RestoreMMapPointers(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint32_t              nKey
+)
+{
+    uint32_t * pPNTR = (uint32_t *)&pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR];
+    uint8_t bCheck = 0;
+    uint8_t Result;
+
+    /* Custom pointers are back to their configuration value */
+    memset(pSPIDevInfo->nPntrUse, 0, sizeof(pSPIDevInfo->nPntrUse));
+
+    if( (pSPIDevInfo->bPntrCacheValid) && (pSPIDevInfo->nPntrCacheKey == nKey) )
+    {
+        bCheck = (++pSPIDevInfo->nPntrCacheCnt >= ADF7030_1_PNTR_CACHE_CHECK);
+        if(!bCheck)
+        {
+            memcpy(pPNTR, pSPIDevInfo->PNTR_CACHE, sizeof(pSPIDevInfo->PNTR_CACHE));
+            pSPIDevInfo->nPntrCacheHit++;
+            return adf7030_1__SPI_SetMMapProfile(pSPIDevInfo);
+        }
+    }
+
+    /* Cache miss or spot check : read back */
+    pSPIDevInfo->nPntrCacheMiss++;
+    pSPIDevInfo->nPntrCacheCnt = 0;
+    if(adf7030_1__SPI_GetMMapPointers(pSPIDevInfo))
+    {
+        pSPIDevInfo->bPntrCacheValid = 0;
+        return 1;
+    }
+    if( bCheck && memcmp(pPNTR, pSPIDevInfo->PNTR_CACHE, sizeof(pSPIDevInfo->PNTR_CACHE)) )
+    {
+        /* Stale cache : drop it, then rewrite it from the read back pointers */
+        pSPIDevInfo->nPntrCacheBad++;
+        adf7030_1__SPI_InvalidMMapPointers(pSPIDevInfo);
+    }
+    memcpy(pSPIDevInfo->PNTR_CACHE, pPNTR, sizeof(pSPIDevInfo->PNTR_CACHE));
+    pSPIDevInfo->nPntrCacheKey = nKey;
+    pSPIDevInfo->bPntrCacheValid = 1;
+    Result = adf7030_1__SPI_SetMMapProfile(pSPIDevInfo);
+    return Result;
+}
+
+/**
+ * @brief       Set the static SPI Radio mmap pointers profile
+ *
+ * @param [in]  pSPIDevInfo     Pointer to the SPI device info structure of the 
+ *                              ADI RF Driver used to communicate with the
+ *                              adf7030-1 PHY.
+ *
+ * @note        The last ADF7030_1_PNTR_STATIC_NB custom pointers of the pool
+ *              are set to ADF7030_1_PNTR_STATIC_PROFILE. A pointer already at
+ *              its profile address is not written.
+ *
+ * @return      Status
+ *  - #0    If the profile is set.
+ *  - #1    [D] If a pointer update failed.
+ */
+
+uint8_t adf7030_1__SPI_SetMMapProfile(
+    adf7030_1_spi_info_t* pSPIDevInfo
+)
+{
+#if ADF7030_1_PNTR_STATIC_NB
+    static const uint32_t aProfile[] = ADF7030_1_PNTR_STATIC_PROFILE;
+    adf7030_1_spi_pntr_t eId;
+    uint32_t id;
+
+    for(id = 0; id < ADF7030_1_PNTR_STATIC_NB; id++)
+    {
+        eId = (adf7030_1_spi_pntr_t)(PNTR_CUSTOM0_ADDR + ADF7030_1_PNTR_DYN_NB + id);
+        if( (pSPIDevInfo->PHY_PNTR[eId] != aProfile[id]) &&
+            adf7030_1__SPI_SetMMapCustomPntr(pSPIDevInfo, eId, aProfile[id]) )
+        {
+            return 1;
+        }
+    }
+#else
+    (void)pSPIDevInfo;
+#endif
+    return 0;
+}
+
+/**
+ * @brief       Invalidate the SPI Radio mmap pointers cache
+ *
+ * @param [in]  pSPIDevInfo     Pointer to the SPI device info structure of the 
+ *                              ADI RF Driver used to communicate with the
+ *                              adf7030-1 PHY.
+ *
+ * @return      None
+ */
+
+void adf7030_1__SPI_InvalidMMapPointers(
+    adf7030_1_spi_info_t* pSPIDevInfo
+)
+{
+    pSPIDevInfo->bPntrCacheValid = 0;
+    pSPIDevInfo->nPntrCacheCnt = 0;
+}
+
 /**
  * @brief       This function return the best Pointer id + offset for subsequent
  *              SPI transfert to the PHY "Addr" provided.
@@ -269,6 +420,138 @@ uint8_t adf7030_1__SPI_SetMMapCustomPntr0(
     return Result;
 }
 
+/**
+ * @brief       Change one of the SPI Radio mmap custom pointers location
+ *
+ * @param [in]  pSPIDevInfo     Pointer to the SPI device info structure of the 
+ *                              ADI RF Driver used to communicate with the
+ *                              adf7030-1 PHY.
+ *
+ * @param [in]  PNTR_ID         The custom pointer (PNTR_CUSTOM0_ADDR to 
+ *                              PNTR_CUSTOM2_ADDR).
+ *
+ * @param [in]  Addr            Value of the pSPIDevInfo->PHY_PNTR[PNTR_ID].
+ *
+ * @return      Status
+ *  - #0    If the pointer was succesfully updated.
+ *  - #1    [D] If PNTR_ID is not a custom pointer or if the transfer failed.
+ */
+
+uint8_t adf7030_1__SPI_SetMMapCustomPntr(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    adf7030_1_spi_pntr_t  PNTR_ID,
+    uint32_t              Addr
+)
+{
+    uint8_t Result;
+
+    if(PNTR_ID == PNTR_CUSTOM0_ADDR)
+    {
+        /* Shortest access, through the setup pointer */
+        return adf7030_1__SPI_SetMMapCustomPntr0(pSPIDevInfo, Addr);
+    }
+    if((PNTR_ID < PNTR_CUSTOM0_ADDR) || (PNTR_ID > PNTR_CUSTOM2_ADDR))
+    {
+        return 1;
+    }
+
+    /* Custom pointers are contiguous from the setup pointer location */
+    if((Result = adf7030_1__SPI_wr_word_b_a( pSPIDevInfo,
+                                             pSPIDevInfo->PHY_PNTR[PNTR_SETUP_ADDR] + ((PNTR_ID - PNTR_CUSTOM0_ADDR) << 2),
+                                             1,
+                                             &Addr)) == 0)
+    {
+        pSPIDevInfo->PHY_PNTR[PNTR_ID] = Addr;
+    }
+    return Result;
+}
+
+/**
+ * @brief       Get a SPI Radio mmap pointer and offset to access the given
+ *              PHY address with short addressing.
+ *
+ * @note        If a pointer (fixed or custom) is already in range, it is used
+ *              and no pointer is written. Otherwise, the least used custom
+ *              pointer of the allocator pool (ADF7030_1_PNTR_ALLOC_POOL) is
+ *              moved to "Addr". Usage counters are halved on each reallocation,
+ *              so the pool follows the hottest memory regions (packet RAM,
+ *              PROFILE, GENERIC_PKT...). The pointers pinned by the static
+ *              profile (ADF7030_1_PNTR_STATIC_NB) are never moved.
+ *
+ * @param [in]  pSPIDevInfo     Pointer to the SPI device info structure of the 
+ *                              ADI RF Driver used to communicate with the
+ *                              adf7030-1 PHY.
+ *
+ * @param [in]  Addr            Desired Radio PHY address.
+ *
+ * @param [in]  bExact          If set, the pointer must be equal to "Addr" 
+ *                              (word access, no offset).
+ *
+ * @param [out] pPNTR_ID        Pointer to the PNTR_ID to use.
+ *
+ * @param [out] pOffset         Pointer to the byte offset from the pointer.
+ *
+ * @return      Status
+ *  - #0    If a pointer is available.
+ *  - #1    [D] If the pointer update failed.
+ */
+
+uint8_t adf7030_1__SPI_AllocMMapPointer(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint32_t              Addr,
+    uint8_t               bExact,
+    adf7030_1_spi_pntr_t* pPNTR_ID,
+    uint8_t*              pOffset
+)
+{
+    uint16_t *pUse = pSPIDevInfo->nPntrUse;
+    uint32_t Base = (bExact) ? (Addr) : ((Addr >> 2) << 2);
+    uint32_t id, victim = 0;
+    uint32_t diff;
+
+    /* Search through pSPIDevInfo->PHY_PNTR[] for a Pointer within range of "Addr" */
+    for(id = PNTR_SRAM_ADDR; id <= PNTR_CUSTOM2_ADDR; id++)
+    {
+        diff = Addr - pSPIDevInfo->PHY_PNTR[id];
+        if( (bExact) ? (diff == 0) : (diff <= 255) )
+        {
+            if( (id >= PNTR_CUSTOM0_ADDR) && (id < PNTR_CUSTOM0_ADDR + ADF7030_1_PNTR_ALLOC_POOL) &&
+                (pUse[id - PNTR_CUSTOM0_ADDR] < 0xFFFF) )
+            {
+                pUse[id - PNTR_CUSTOM0_ADDR]++;
+            }
+            *pPNTR_ID = (adf7030_1_spi_pntr_t)id;
+            *pOffset = (uint8_t)diff;
+            return 0;
+        }
+    }
+
+    /* Miss : take the least used (not pinned) pointer of the pool... */
+    for(id = 1; id < ADF7030_1_PNTR_DYN_NB; id++)
+    {
+        if(pUse[id] < pUse[victim])
+        {
+            victim = id;
+        }
+    }
+    /* ...and age the others */
+    for(id = 0; id < ADF7030_1_PNTR_DYN_NB; id++)
+    {
+        pUse[id] >>= 1;
+    }
+
+    if(adf7030_1__SPI_SetMMapCustomPntr(pSPIDevInfo, (adf7030_1_spi_pntr_t)(PNTR_CUSTOM0_ADDR + victim), Base))
+    {
+        return 1;
+    }
+    pUse[victim] = 1;
+    pSPIDevInfo->nPntrAllocCnt++;
+
+    *pPNTR_ID = (adf7030_1_spi_pntr_t)(PNTR_CUSTOM0_ADDR + victim);
+    *pOffset = (uint8_t)(Addr - Base);
+    return 0;
+}
+
 
 /**
  * @brief       Write a number of word(s) from Host to memory of the adf7030-1
@@ -1089,11 +1372,12 @@ uint8_t adf7030_1__SPI_Block_Xfer__fast(
  *                              start transfer in the PHY.
  *
  * @param [in]  nbBytes         Number of bytes to read or write to be performed.
- *                              If nbBytes is bigger than SPI_MEMORY_SIZE, 
- *                              the custom spi pntr0 will be used to transfer the data.
- *                              The shadow pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]
- *                              and the PHY value (in the radio) will be restored 
- *                              to there original value.
+ *                              If nbBytes is bigger than SPI_MEMORY_SIZE, the
+ *                              next blocks go through the custom pointer given by
+ *                              the allocator (adf7030_1__SPI_AllocMMapPointer).
+ *                              A pointer already at the block address is used
+ *                              as is, otherwise one is moved and left there (its
+ *                              value is tracked in pSPIDevInfo->PHY_PNTR[]).
  *
  * @param [in|out]  pDataIO     Pointer to the start of the Host data block.
  *                              On exit, pDataIO is pointing nbBytes away from
@@ -1125,8 +1409,7 @@ uint8_t adf7030_1__SPI_Block_Xfer(
     /* Variable holding current value off full spi block (used when nbBytes > ADF7030_1_SPI_MAX_TRX_SIZE )*/
     uint32_t full_block_cnt = 0;
 
-    /* Store the initial value of PNTR_CUSTOM0 */
-    uint32_t copy_spi_pntr_custom0 = pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR];
+    /* Store the initial value of the pointer */
     uint32_t copy_spi_pntr_ID = pSPIDevInfo->PHY_PNTR[PNTR_ID];
 
     /* Transfert loop */
@@ -1164,6 +1447,8 @@ uint8_t adf7030_1__SPI_Block_Xfer(
         {
             uint32_t tmp_SPI_Prolog;
             uint32_t tmp_nClkFreq_Fast;
+            uint8_t tmp_Offset;
+            uint8_t eAlloc;
             switch(*(pSPI_TX_BUFF + cmdOffset) & 0x78)
             {
                 case( ADF703x_SPI_MEM_WRITE | ADF703x_SPI_MEM_BLOCK |  ADF703x_SPI_MEM_ADDRESS | ADF703x_SPI_MEM_LONG ) :
@@ -1203,26 +1488,32 @@ uint8_t adf7030_1__SPI_Block_Xfer(
                     //ADF703x_SPI_MEM_WRITE | ADF703x_SPI_MEM_BLOCK | ADF703x_SPI_MEM_POINTER | ADF703x_SPI_MEM_SHORT | pntrID;
                     //ADF703x_SPI_MEM_READ  | ADF703x_SPI_MEM_BLOCK | ADF703x_SPI_MEM_POINTER | ADF703x_SPI_MEM_SHORT | pntrID;
           
-                    /* Change the Host copy of SPI pointer 0 address for next block of byte transfer */
-                    pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR] = copy_spi_pntr_ID + (size * ++full_block_cnt);
-            
                     /* Save current SPI prolog */
                     tmp_SPI_Prolog = *(uint32_t *)pSPI_TX_BUFF;
                     
                     /* Override pSPIDevInfo->nClkFreq_Fast setting to avoid toggling between SPI freq during long block transfer */
                     tmp_nClkFreq_Fast = pSPIDevInfo->nClkFreq_Fast;
                     pSPIDevInfo->nClkFreq_Fast = pSPIDevInfo->nClkFreq_Current;
-                    /* Update the PHY Radio SPI pointer 0 */
-                    adf7030_1__SPI_wr_word_b_p( pSPIDevInfo, PNTR_SETUP_ADDR, 1, &(pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]));
+                    /* Get a pointer on the next block (only written if none is already there) */
+                    eAlloc = adf7030_1__SPI_AllocMMapPointer( pSPIDevInfo,
+                                                              copy_spi_pntr_ID + (size * ++full_block_cnt),
+                                                              1,
+                                                              &PNTR_ID,
+                                                              &tmp_Offset );
 
                     /* Recall original pSPIDevInfo->nClkFreq_Fast setting */
                     pSPIDevInfo->nClkFreq_Fast = tmp_nClkFreq_Fast;
                     /* Recall current SPI prolog */
                     *(uint32_t *)pSPI_TX_BUFF = tmp_SPI_Prolog;
+                    if(eAlloc)
+                    {
+                        pSPIDevInfo->eXferResult = ADF7030_1_SPI_COMM_FAILED;
+                        return 1;
+                    }
             
-                    /* Update SPI command byte to use the SPI pointer 0 */
+                    /* Update SPI command byte to use this pointer */
                     *(pSPI_TX_BUFF + cmdOffset) &= 0xF8;
-                    *(pSPI_TX_BUFF + cmdOffset) |= PNTR_CUSTOM0_ADDR;
+                    *(pSPI_TX_BUFF + cmdOffset) |= PNTR_ID;
                     
                     break;
                 
@@ -1249,15 +1540,6 @@ uint8_t adf7030_1__SPI_Block_Xfer(
         nbBytes -= size;
     }
 
-    /* Restore the initial value of PNTR_CUSTOM0 if required */
-    if(pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR] != copy_spi_pntr_custom0)
-    {
-        /* Change the Host copy of SPI pointer 0 */
-        pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR] = copy_spi_pntr_custom0;
-        
-        /* Update the PHY Radio SPI pointer 0 */
-        adf7030_1__SPI_wr_word_b_p( pSPIDevInfo, PNTR_SETUP_ADDR, 1, &(pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]));
-    }
     pSPIDevInfo->eXferResult = ADF7030_1_SUCCESS;
     return 0;
 }
@@ -1345,11 +1627,13 @@ uint8_t adf7030_1__SPI_block_transaction(
     Transceiver.nRxIncrement     =      1u;
 
     /* Transmit the sequence */
+    SPI_BENCH_START();
     if(BSP_Spi_ReadWrite(pSPIDevInfo->hSPIDevice, &Transceiver) != DEV_SUCCESS)
     {
     	pSPIDevInfo->eXferResult = ADF7030_1_SPI_COMM_FAILED;
     	return 1;
     }
+    SPI_BENCH_END(*Transceiver.pTransmitter, txlen);
     /* ------------ Readback SPI RX buffer ------------- */
  
     /* Set Block address to 2nd unit32_t */   
@@ -1421,6 +1705,7 @@ void adf7030_1__SPI_ReadWrite_Fast(
   Transceiver.nTxIncrement     = 0u;
   Transceiver.nRxIncrement     = 0u;
   /* Transmit the sequence */
+  SPI_BENCH_START();
   if(BSP_Spi_ReadWrite(pSPIDevInfo->hSPIDevice, &Transceiver) != DEV_SUCCESS)
   {
       Transceiver.nRxIncrement = 0xFFFFFFFF;
@@ -1429,8 +1714,36 @@ void adf7030_1__SPI_ReadWrite_Fast(
   else {
 	  pSPIDevInfo->eXferResult = ADF7030_1_SUCCESS;
   }
+  SPI_BENCH_END(*pTX_DATA, nSize);
 }
 
+#if ADF7030_1_SPI_BENCH
+/**
+ * @brief       Get the cycle count benchmark of one SPI transaction type
+ *
+ * @param [in]  eOp   The transaction type.
+ *
+ * @return      Pointer on the benchmark (NULL if eOp is invalid)
+ */
+const adf7030_1_spi_bench_t* adf7030_1__SPI_GetBench(
+    adf7030_1_spi_op_e eOp
+)
+{
+    if (eOp >= ADF7030_1_SPI_OP_NB) { return NULL; }
+    return &aSpiBench[eOp];
+}
+
+/**
+ * @brief       Clear the SPI transaction cycle count benchmark
+ *
+ * @return      None
+ */
+void adf7030_1__SPI_ClrBench(void)
+{
+    memset(aSpiBench, 0, sizeof(aSpiBench));
+}
+#endif
+
 
 /**
  * @brief       Copy number of byte(s) from Host memory space into SPI TX buffer
@@ -1463,46 +1776,22 @@ void adf7030_1__SPI_Xfer_WriteBuff(
 )
 {
     uint32_t nb_word = nBytes >> 2;
-    uint32_t nb_bytes_rem = nBytes & 3;
 
     /* Fill SPI TX buffer data */
     if(op)
     {
     /* READ operation */
-        uint32_t tx_fill = 0xFFFFFFFF;
-        for(uint32_t i = 0; i < nb_word; i++)
-        {   
-            *((uint32_t *)pDest + i) = tx_fill;
-        }
-             
-        if(!(mode & 1) && nb_bytes_rem)
-        {
-            pDest = (uint32_t *)pDest + nb_word;
-            for(uint32_t i = 0; i < nb_bytes_rem; i++)
-            {
-                *((uint8_t *)pDest + i) = tx_fill;
-            }
-        }
+        memset(pDest, 0xFF, (mode & 1) ? (nb_word << 2) : nBytes);
+    }
+    else if(mode & 1)
+    {
+    /* WRITE operation, word : swap on the fly */
+        adf7030_1__SPI_Xfer_Swap(pDest, pSrc, nb_word);
     }
     else
     {
-    /* WRITE operation */
-        for(uint32_t i = 0; i < nb_word; i++)
-        {   
-            uint32_t word = *((uint32_t *)pSrc + i);
-            if(mode & 1) word = __ntohl(word);
-            *((uint32_t *)pDest + i) = word;
-        }
-        
-        if(!(mode & 1) && nb_bytes_rem)
-        {
-            pDest = (uint32_t *)pDest + nb_word;
-            pSrc = (uint32_t *)pSrc + nb_word;
-            for(uint32_t i = 0; i < nb_bytes_rem; i++)
-            {
-                *((uint8_t *)pDest + i) = *((uint8_t *)pSrc + i);
-            }
-        }
+    /* WRITE operation, byte : straight copy */
+        memcpy(pDest, pSrc, nBytes);
     }
 }
 
@@ -1542,92 +1831,69 @@ uint8_t adf7030_1__SPI_Xfer_ReadBuff(
 )
 {
     uint32_t nb_word = nBytes >> 2;
-    uint32_t nb_bytes_rem = nBytes & 3;
-    
-    if((pDest != NULL) && (pRef == NULL))
+
+    if((pDest == NULL) && (pRef == NULL))
     {
-        /* Copy nb_word from spi_rxbuf to pDataIO */  
-        for(uint32_t i = 0; i < nb_word; i++)
-        {
-            uint32_t word = *((uint32_t *)pSrc + i);
-            if(mode & 1) word = __ntohl(word);
-            *((uint32_t *)pDest + i) = word;
-        }
-        
-        if(!(mode & 1) && nb_bytes_rem)
-        {           
-            pDest = (uint32_t *)pDest + nb_word;
-            pSrc = (uint32_t *)pSrc + nb_word;
-            for(uint32_t i = 0; i < nb_bytes_rem; i++)
-            {
-                *((uint8_t *)pDest + i) = *((uint8_t *)pSrc + i);
-            }
-        }   
+        /* Should never end up here */
+        return 1;
     }
-    else if((pDest != NULL) && (pRef != NULL))
+
+    if(mode & 1)
     {
-        /* Copy up to nb_word from spi_rxbuf to pDataIO and Check versus pDataRef */
-        for(uint32_t i = 0; i < nb_word; i++)
+        if(pRef == NULL)
         {
-            uint32_t word = *((uint32_t *)pSrc + i);
-            if(mode & 1) word = __ntohl(word);
-            if(*((uint32_t *)pRef + i) != word)
-            {
-                return 1;
-            }  
-            *((uint32_t *)pDest + i) = word;
+            /* Word : swap on the fly from the SPI RX buffer */
+            adf7030_1__SPI_Xfer_Swap(pDest, pSrc, nb_word);
+            return 0;
         }
-        
-        if(!(mode & 1) && nb_bytes_rem)
-        {
-            pDest = (uint32_t *)pDest + nb_word;
-            pSrc = (uint32_t *)pSrc + nb_word;
-            pRef = (uint32_t *)pRef + nb_word;
-            for(uint32_t i = 0; i < nb_bytes_rem; i++)
-            {
-                uint32_t byte = *((uint8_t *)pSrc + i);
-                if(*((uint8_t *)pRef + i) != byte)
-                {
-                    return 1;
-                }
-                *((uint8_t *)pDest + i) = byte;
-            }
-        }   
+        /* Word : swap in place in the SPI RX buffer... */
+        adf7030_1__SPI_Xfer_Swap(pSrc, pSrc, nb_word);
+        nBytes = nb_word << 2;
     }
-    else if((pDest == NULL) && (pRef != NULL))
+
+    /* ...then compare and copy as a byte stream */
+    if((pRef != NULL) && (memcmp(pRef, pSrc, nBytes) != 0))
     {
-        /* Compare up to nb_word of spi_rxbuf versus pDataRef */
-        for(uint32_t i = 0; i < nb_word; i++)
-        {
-            uint32_t word = *((uint32_t *)pSrc + i);
-            if(mode & 1) word = __ntohl(word);
-            if(*((uint32_t *)pRef + i) != word)
-            {
-                return 1;
-            }
-        }
-        
-        if(!(mode & 1) && nb_bytes_rem)
-        {
-            pSrc = (uint32_t *)pSrc + nb_word;
-            pRef = (uint32_t *)pRef + nb_word;
-            for(uint32_t i = 0; i < nb_bytes_rem; i++)
-            {
-                if(*((uint8_t *)pRef + i) != *((uint8_t *)pSrc + i))
-                {
-                    return 1;
-                }
-            }
-        }   
+        return 1;
     }
-    else
+    if(pDest != NULL)
     {
-        /* Should never end up here */
-        return 1;
+        memcpy(pDest, pSrc, nBytes);
     }
-    
     return 0;
 }
+
+/**
+ * @brief       Swap (32 bits endianess) a number of word(s).
+ *
+ * @note        pDest and pSrc can be the same (in place swap) and can be
+ *              unaligned. The swap compile to a REV instruction.
+ *
+ * @param [in]  pDest     Pointer to the destination.
+ *
+ * @param [in]  pSrc      Pointer to the source.
+ *
+ * @param [in]  nWords    Number of word to swap
+ *
+ * @return      None
+ */
+void adf7030_1__SPI_Xfer_Swap(
+    void*       pDest,
+    const void* pSrc,
+    uint32_t    nWords
+)
+{
+    uint32_t word;
+    while(nWords--)
+    {
+        /* memcpy keeps unaligned access safe, it end up as a single LDR/STR */
+        memcpy(&word, pSrc, 4);
+        word = __ntohl(word);
+        memcpy(pDest, &word, 4);
+        pSrc = (const uint8_t *)pSrc + 4;
+        pDest = (uint8_t *)pDest + 4;
+    }
+}
                     
 #endif /* _ADF7030_1__SPI_C_ */
 
@@ -42,6 +42,35 @@ extern "C" {
 #define NOISE_MEAS_AVG_NB (10u)
 #endif
 
+#ifndef NOISE_MEAS_BURST_NB
+/*! Define the number of CCA readback read in one SPI transaction */
+#define NOISE_MEAS_BURST_NB (8u)
+#endif
+
+#ifndef NOISE_MEAS_MIN_NB
+/*! Define the minimum number of measure before checking the convergence */
+#define NOISE_MEAS_MIN_NB (4u)
+#endif
+
+#ifndef NOISE_MEAS_VAR_THR
+/*! Define the convergence threshold on the variance of the mean (raw unit squared, 1/16 dB^2) */
+#define NOISE_MEAS_VAR_THR (4u)
+#endif
+
+#ifndef NOISE_MEAS_TIME_BUDGET
+/*! Define the maximum time spent to measure the noise (ms) */
+#define NOISE_MEAS_TIME_BUDGET (5u)
+#endif
+
+/*!
+ * @brief This hold the noise measurement result
+ */
+typedef struct {
+	uint16_t u16Noise;  /*!< Averaged raw noise */
+	uint16_t u16NbMeas; /*!< Number of valid measures */
+	uint32_t u32Var;    /*!< Variance of the measures (raw unit squared) */
+} noise_meas_t;
+
 typedef enum {
     FW_MODULE_NAME,
     FW_MODULE_VERSION,
@@ -75,6 +104,13 @@ uint16_t adf7030_1__GetRawNoise(
 	uint8_t               u8NbMeas
 );
 
+uint8_t adf7030_1__MeasureRawNoise(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+	uint8_t               u8MaxMeas,
+	uint32_t              u32Budget,
+	noise_meas_t          *pMeas
+);
+
 int16_t adf7030_1__GetRawAfcFreqErr(
     adf7030_1_spi_info_t* pSPIDevInfo
 );
@@ -141,6 +177,13 @@ uint8_t adf7030_1__SetupWakeSrc(
     uint8_t               u8_WkUpSrc
 );
 
+uint8_t adf7030_1__SetupSmartWake(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint8_t               bFlag,
+    uint32_t              u32Period,
+    uint32_t              u32Dwell
+);
+
 uint8_t adf7030_1__SetupExtPaLna(
     adf7030_1_spi_info_t* pSPIDevInfo,
     adf7030_1_gpio_pin_e  ePaPhyPin,
@@ -175,6 +218,16 @@ uint8_t adf7030_1__GetRxPacket(
     uint8_t*              u8_Sz
 );
 
+uint8_t adf7030_1__GetRxPacketFilt(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint8_t*              p_Data,
+    uint8_t*              u8_Sz,
+    const uint8_t*        p_Addr,
+    uint8_t               u8_Offset,
+    uint8_t               u8_AddrSz,
+    uint8_t*              pb_Match
+);
+
 /******************************************************************************/
 // The following function use SPI polling on PHY state
 uint8_t adf7030_1__MeasureNoise(
@@ -51,10 +51,15 @@ extern inline
 uint8_t PHY_CONV_Signed11ToRssi(uint16_t u16_Signed11);
 
 extern inline
-float PHY_CONV_Signed11ToFloat(uint16_t u16_Signed11);
+int16_t PHY_CONV_Signed11ToQdBm(uint16_t u16_Signed11);
 
 extern inline
-float PHY_CONV_AfcFreqErrToFloat(int16_t i16AfcFreqErr);
+int32_t PHY_CONV_AfcFreqErrToHz(int16_t i16AfcFreqErr);
+
+/*! Minimum buffer size for PHY_CONV_QdBmToStr (longest is "-8192.00" for INT16_MIN, plus the '\0') */
+#define PHY_CONV_QDBM_STR_SZ 9
+
+uint8_t PHY_CONV_QdBmToStr(int16_t i16_QdBm, char *pStr);
 
 #ifdef __cplusplus
 }
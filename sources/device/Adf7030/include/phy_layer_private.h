@@ -46,6 +46,95 @@ extern "C" {
 
 #define CAL_RES_SZ (36+8+32+8)
 
+#ifndef PHY_USE_RETENTION
+/*!
+ * @brief Sleep with memory retention, so wake-up doesn't need to reload the configuration
+ */
+#define PHY_USE_RETENTION 1
+#endif
+
+#ifndef PHY_USE_ADDR_FILT
+/*!
+ * @brief Drop the received frames which are not addressed to this device (address taken from the device ID)
+ *
+ * Broadcast and wildcard addresses (0xF nibbles) always pass. Off by default :
+ * some downlink frames (e.g. download) may not carry the device address.
+ */
+#define PHY_USE_ADDR_FILT 0
+#endif
+
+/*!
+ * @brief Offset of the address (M-field then A-field) in a received frame, i.e. after L-field and C-field
+ */
+#define PHY_ADDR_FILT_OFFSET 2
+
+/*!
+ * @brief Size of the address (M-field then A-field)
+ */
+#define PHY_ADDR_FILT_SZ 8
+
+/*!
+ * @brief Size of the frame CRC (EN13757-4 CRC16, set in the base CFG file)
+ */
+#define PHY_CRC_SZ 2
+
+#ifndef PHY_RX_RING_NB
+/*!
+ * @brief Number of received frame records kept by the PHY (must be a power of 2)
+ */
+#define PHY_RX_RING_NB 4
+#endif
+#if (PHY_RX_RING_NB & (PHY_RX_RING_NB - 1))
+#error "PHY_RX_RING_NB must be a power of 2"
+#endif
+
+#ifndef PHY_LBT_MEAS_NB
+/*!
+ * @brief Maximum number of noise measures (averaged) for the listen before talk
+ */
+#define PHY_LBT_MEAS_NB 8
+#endif
+
+#ifndef PHY_LBT_TIME_BUDGET
+/*!
+ * @brief Maximum time spent to measure the noise for the listen before talk (ms)
+ */
+#define PHY_LBT_TIME_BUDGET 2
+#endif
+
+#ifndef PHY_TXAT_TRIGPIN
+/*!
+ * @brief Trigger pin which fire the scheduled transmission
+ */
+#define PHY_TXAT_TRIGPIN ADF7030_1_TRIGPIN0
+#endif
+
+#ifndef PHY_TXAT_LPTIM_ID
+/*!
+ * @brief Low power timer which schedule the transmission (0 : LPTIM2, LPTIM1 is used by the tickless idle)
+ */
+#define PHY_TXAT_LPTIM_ID 0
+#endif
+
+#ifndef PHY_TXAT_MARGIN
+/*!
+ * @brief Minimum time left between the end of the pre-arm and the scheduled transmission (µs)
+ */
+#define PHY_TXAT_MARGIN 100
+#endif
+
+#ifndef PHY_NB_INST
+/*!
+ * @brief Number of Phy device instances (i.e. radios, each one on its own SPI bus)
+ */
+#define PHY_NB_INST ADF7030_1_NUM_DEV
+#endif
+
+/*!
+ * @brief Maximum size of one received frame record payload
+ */
+#define PHY_RX_FRAME_MAX_SZ 255
+
 /******************************************************************************/
 /*!
  * @brief This define the available command to change the PHY state
@@ -58,6 +147,9 @@ typedef enum {
 	// ----
 	PHY_CMD_SPORT    , /*!< Set the SPORT ini/out */
 	PHY_CMD_TEST     , /*!< Test mode */
+	// ----
+	PHY_CMD_GET_RSSI_QDBM, /*!< Get the last RSSI in 1/4 dBm (int16_t*) */
+	PHY_CMD_GET_FERR_HZ  , /*!< Get the last AFC frequency error in Hz (int32_t*) */
 } phy_cmd_e;
 
 /*!
@@ -70,6 +162,62 @@ typedef struct {
 } phy_power_t;
 
 
+/*!
+ * @brief This define the sniff (smart wake receive) set point of one modulation
+ */
+typedef struct {
+	uint16_t u16Period;    /*!< Radio wake-up period (in ms), 0 : sniff not allowed */
+	uint8_t  u8DetectDwell;/*!< Symbols allowed for the preamble detection (RSSI qualification) */
+	uint8_t  u8QualDwell;  /*!< Symbols allowed for the preamble qualification (AFC) */
+	uint8_t  u8SyncDwell;  /*!< Symbols allowed for the start of syncword */
+} phy_sniff_t;
+
+/*!
+ * @brief This hold the result of one listen before talk
+ */
+typedef struct {
+	uint8_t  u8Noise;    /*!< Measured noise level (same unit as PHY_CTL_GET_NOISE) */
+	uint8_t  bClear;     /*!< The channel was clear, so the frame has been sent */
+	uint32_t u32Latency; /*!< Time from the CCA start to the TX (or busy) decision (µs) */
+} phy_lbt_t;
+
+/*!
+ * @brief This hold the timing of the last scheduled transmission (all relative to the request)
+ */
+typedef struct {
+	uint32_t u32Armed;  /*!< Time spent to pre-arm the radio (µs) */
+	uint32_t u32Target; /*!< Scheduled start, as programmed into the timer (µs) */
+	uint32_t u32Start;  /*!< Trigger time, i.e. when the trigger pin has been pulsed (µs), 0 : not yet. The frame is on air after the radio TX ramp up */
+} phy_txat_t;
+
+/*!
+ * @brief This define the multi-channel listen (scan) set point
+ */
+typedef struct {
+	uint8_t  u8ChMsk;  /*!< Channels to listen on (bit n : channel n, see phy_chan_e) */
+	uint16_t u16Dwell; /*!< Listen time on each channel (in ms) */
+	uint16_t u16Lock;  /*!< Additional listen time when a preamble is detected (in ms) */
+} phy_scan_t;
+
+/*!
+ * @brief This hold the multi-channel listen statistics of one channel
+ */
+typedef struct {
+	uint32_t u32NbDwell;  /*!< Number of times the channel has been listened */
+	uint32_t u32NbDetect; /*!< Number of detected preambles */
+	uint32_t u32NbFrame;  /*!< Number of received frames */
+} phy_scan_ch_t;
+
+/*!
+ * @brief This hold the multi-channel listen statistics
+ */
+typedef struct {
+	phy_scan_ch_t aCh[PHY_NB_CH]; /*!< Per channel statistics */
+	uint32_t      u32NbHop;       /*!< Number of channel changes */
+	uint32_t      u32MaxRetune;   /*!< Maximum channel change time (µs) */
+	uint8_t       bOn;            /*!< The scan is running */
+} phy_scan_stats_t;
+
 /*!
  * @brief PHY device SPORT I/O selection
  */
@@ -97,11 +245,24 @@ typedef union
 	};
 } test_mode_info_t;
 
+/*!
+ * @brief PHY device received frame record
+ */
+typedef struct {
+	uint64_t u64Timestamp;                   /*!< Reception time (epoch, in ms) */
+	uint16_t u16Rssi;                        /*!< Raw RSSI of the frame */
+	uint16_t u16Ferr;                        /*!< Raw AFC frequency error of the frame */
+	uint8_t  u8Len;                          /*!< Payload length */
+	uint8_t  bCrcOk;                         /*!< The CRC has been verified by the radio */
+	uint8_t  aPayload[PHY_RX_FRAME_MAX_SZ];  /*!< Payload */
+} phy_rx_frame_t;
+
 /******************************************************************************/
 
 int32_t Phy_adf7030_setup(
     phydev_t *pPhydev,
     adf7030_1_device_t *pCtx,
+    spi_dev_t *pSpiDev,
     adf7030_1_gpio_int_info_t*   const pINTDevInfo,
     adf7030_1_gpio_trig_info_t*  const pTRIGDevInfo,
     adf7030_1_gpio_reset_info_t* const pRESETDevInfo,
@@ -118,18 +279,49 @@ int32_t Phy_GetPa(void);
 int32_t Phy_SetPowerEntry(phydev_t *pPhydev, phy_power_e eEntryId, phy_power_t sPwrEntry);
 int32_t Phy_GetPowerEntry(phydev_t *pPhydev, phy_power_e eEntryId, phy_power_t *sPwrEntry);
 
-int32_t Phy_GetCal(uint8_t *pBuf);
-int32_t Phy_SetCal(uint8_t *pBuf);
-int32_t Phy_ClrCal(void);
+int32_t Phy_SetSniffEntry(phydev_t *pPhydev, phy_mod_e eModulation, phy_sniff_t sSniffEntry);
+int32_t Phy_GetSniffEntry(phydev_t *pPhydev, phy_mod_e eModulation, phy_sniff_t *sSniffEntry);
+int32_t Phy_Sniff(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation);
+int32_t Phy_SniffStop(phydev_t *pPhydev);
+
+int32_t Phy_GetCal(phydev_t *pPhydev, uint8_t *pBuf);
+int32_t Phy_SetCal(phydev_t *pPhydev, uint8_t *pBuf);
+int32_t Phy_ClrCal(phydev_t *pPhydev);
 int32_t Phy_AutoCalibrate(phydev_t *pPhydev);
+int32_t Phy_AutoCalibrateStages(phydev_t *pPhydev, uint32_t u32Stages);
 int32_t Phy_RssiCalibrate(phydev_t *pPhydev, int8_t i8RssiRefLevel);
 
+int32_t Phy_NoiseSweep(phydev_t *pPhydev, phy_mod_e eModulation, uint8_t aNoise[PHY_NB_CH]);
+int32_t Phy_Lbt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint8_t u8Threshold, phy_lbt_t *pLbt);
+int32_t Phy_TxAt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint32_t u32Delay);
+int32_t Phy_TxAtCancel(phydev_t *pPhydev);
+int32_t Phy_GetTxAt(phydev_t *pPhydev, phy_txat_t *pTxAt);
+int32_t Phy_Scan(phydev_t *pPhydev, phy_mod_e eModulation, const phy_scan_t *pScan);
+int32_t Phy_ScanStop(phydev_t *pPhydev);
+int32_t Phy_GetScanStats(phydev_t *pPhydev, phy_scan_stats_t *pStats);
+
+int32_t Phy_GetRxFrame(phydev_t *pPhydev, phy_rx_frame_t *pFrame);
+uint8_t Phy_GetRxFrameNb(phydev_t *pPhydev);
+uint32_t Phy_GetRxOverflowNb(phydev_t *pPhydev);
+int32_t Phy_SetAddrFilt(phydev_t *pPhydev, const uint8_t *pAddr);
+uint8_t Phy_GetAddrFilt(phydev_t *pPhydev, uint8_t *pAddr);
+uint32_t Phy_GetAddrFiltNb(phydev_t *pPhydev);
+int32_t Phy_SetCrcOffload(phydev_t *pPhydev, uint8_t bEnable);
+uint8_t Phy_GetCrcOffload(phydev_t *pPhydev);
+uint8_t Phy_GetRxCrcOk(phydev_t *pPhydev);
+uint32_t Phy_GetCrcErrNb(phydev_t *pPhydev);
+uint8_t Phy_IsBusy(phydev_t *pPhydev);
+int32_t Phy_GetNoiseMeas(phydev_t *pPhydev, noise_meas_t *pMeas);
+uint32_t Phy_GetWakeUpTime(phydev_t *pPhydev);
+uint32_t Phy_GetPwrOnTime(phydev_t *pPhydev);
+
 #ifdef PHY_USE_POWER_RAMP
 	extern pa_ramp_rate_e pa_ramp_rate;
 #endif
 extern int16_t rssi_offset_cal ;
 
 extern phy_power_t aPhyPower[PHY_NB_PWR];
+extern phy_sniff_t aPhySniff[PHY_NB_MOD];
 
 extern const char * const aChanStr[PHY_NB_CH];
 extern const char * const aModulationStr[PHY_NB_MOD];
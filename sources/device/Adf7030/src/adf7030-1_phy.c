@@ -59,8 +59,15 @@ extern "C" {
 
 #define PTR_TRX_BASE_MIN 0x2bcUL // 0x2bc << 2 = 0xAF0
 
-uint8_t a_SpiTxBuf [ADF7030_1_SPI_BUFFER_SIZE];
-uint8_t a_SpiRxBuf [ADF7030_1_SPI_BUFFER_SIZE];
+/* Wake-up timeout (ms) */
+#define ADF7030_1_WAKEUP_TMO 2
+
+/* LFRC (RTC clock source) nominal frequency (Hz) */
+#define ADF7030_1_LFRC_FREQ 26000
+
+/* SPI transaction buffers, one pair per device (the buses run concurrently) */
+uint8_t a_SpiTxBuf [ADF7030_1_NUM_DEV][ADF7030_1_SPI_BUFFER_SIZE];
+uint8_t a_SpiRxBuf [ADF7030_1_NUM_DEV][ADF7030_1_SPI_BUFFER_SIZE];
 
 /******************************************************************************/
 /* Pulse */
@@ -147,7 +154,8 @@ uint8_t adf7030_1_PulseWakup(
 )
 {
 	p_spi_dev_t pSpiDev;
-    uint8_t u8Level;
+    uint32_t u32Start;
+    uint8_t u8Level = 0;
     if (pDevice == NULL) { return ADF7030_1_INVALID_OPERATION;}
 #ifdef TRIG_AS_WAKE_UP
     if( (pDevice->TrigGPIOInfo[ADF7030_1_TRIGPIN0].eTrigStatus != ENABLED) &&
@@ -158,12 +166,18 @@ uint8_t adf7030_1_PulseWakup(
     	pSpiDev = ((p_spi_dev_t)pDevice->SPIInfo.hSPIDevice);
     	BSP_Gpio_SetHigh(pSpiDev->ss_port, pSpiDev->ss_pin);
         BSP_Gpio_SetLow(pSpiDev->ss_port, pSpiDev->ss_pin);
-        // FIXME :
-        //do {
-        //	// should rise high level after 92µs typ.
-        //    BSP_Gpio_Get((uint32_t)RADIO_MISO_GPIO_Port, RADIO_MISO_Pin, &u8Level);
-        //} while(u8Level);
-        msleep(1);
+        if (pSpiDev->miso_port)
+        {
+            // MISO should rise high level after 92µs typ.
+            u32Start = mtick();
+            do {
+                BSP_Gpio_Get(pSpiDev->miso_port, pSpiDev->miso_pin, &u8Level);
+            } while( !u8Level && ( (mtick() - u32Start) < ADF7030_1_WAKEUP_TMO ) );
+        }
+        else
+        {
+            msleep(1);
+        }
         BSP_Gpio_SetHigh(pSpiDev->ss_port, pSpiDev->ss_pin);
 #ifdef TRIG_AS_WAKE_UP
     }
@@ -207,7 +221,7 @@ uint16_t adf7030_1__GetRawRSSI(
  * @note  The PHY device has to be in CCA state before calling this function
  *
  * @param [in] pSPIDevInfo   Pointer to ADF7030-1 SPI device instance.
- * @param [in] u8NbMeas      The number of noise measure to average one.
+ * @param [in] u8NbMeas      The maximum number of noise measure to average one.
  *
  * @return Current Noise
  */
@@ -216,37 +230,109 @@ uint16_t adf7030_1__GetRawNoise(
 	uint8_t               u8NbMeas
 )
 {
-    uint8_t u8i, u8j;
-    uint32_t u32_Sum;
+    noise_meas_t sMeas = { .u16Noise = 0 };
+    adf7030_1__MeasureRawNoise(pSPIDevInfo, u8NbMeas, NOISE_MEAS_TIME_BUDGET, &sMeas);
+    return sMeas.u16Noise;
+}
+
+/*!
+ * @brief  This function measure the Noise
+ *
+ * @details The CCA readback is read by burst of NOISE_MEAS_BURST_NB in one SPI
+ *          transaction. Measure is validated if the LIVE_STATUS of cca_readback
+ *          register, equal 0. The measurement stops when :
+ *          - u8MaxMeas valid measures are done
+ *          - or, after NOISE_MEAS_MIN_NB measures, the variance of the mean is
+ *            lower than NOISE_MEAS_VAR_THR
+ *          - or, the time budget is reached
+ *
+ * @note  The PHY device has to be in CCA state before calling this function
+ *
+ * @param [in]  pSPIDevInfo   Pointer to ADF7030-1 SPI device instance.
+ * @param [in]  u8MaxMeas     The maximum number of noise measure to average one.
+ * @param [in]  u32Budget     The maximum time to spent (ms).
+ * @param [out] pMeas         Pointer on the measure result.
+ *
+ * @return      Status
+ *  - #0    If at least one valid measure has been done.
+ *  - #1    [D] If the transfer failed or no valid measure.
+ */
+uint8_t adf7030_1__MeasureRawNoise(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+	uint8_t               u8MaxMeas,
+	uint32_t              u32Budget,
+	noise_meas_t          *pMeas
+)
+{
+    uint32_t aAddr[NOISE_MEAS_BURST_NB];
+    uint32_t aRead[NOISE_MEAS_BURST_NB];
+    uint32_t u32_Sum, u32_SumSq;
+    uint32_t u32_Start;
+    uint16_t u16_Invalid;
     uint16_t u16_NoiseMeas;
-    uint16_t u16_NoiseAvg;
+    uint8_t u8_Nb, u8_Burst, u8i;
+    uint64_t u64_Dev;
     cca_read_back_t ccaReadBack;
 
-    if (pSPIDevInfo == NULL) { return 0;}
+    if (pSPIDevInfo == NULL || pMeas == NULL) { return 1;}
+
+    pMeas->u16Noise = 0;
+    pMeas->u16NbMeas = 0;
+    pMeas->u32Var = 0;
+
+    for (u8i = 0; u8i < NOISE_MEAS_BURST_NB; u8i++)
+    {
+    	aAddr[u8i] = PROFILE_CCA_READBACK_Addr;
+    }
 
     u32_Sum = 0;
-    u8j = 0;
-    u16_NoiseAvg = 0;
-    for (u8i = 1; u8i <= u8NbMeas ; u8i++)
+    u32_SumSq = 0;
+    u8_Nb = 0;
+    u16_Invalid = 0;
+    u32_Start = mtick();
+    while (u8_Nb < u8MaxMeas)
     {
-        ccaReadBack = (cca_read_back_t)adf7030_1__SPI_GetMem32(pSPIDevInfo,  PROFILE_CCA_READBACK_Addr );
-        u16_NoiseMeas = ccaReadBack.CCA_READBACK_b.VALUE;
-        if (ccaReadBack.CCA_READBACK_b.LIVE_STATUS == 1 || u16_NoiseMeas == 0){
-            u8i--; u8j++;
-            if (u8j > (u8NbMeas*10) )
-            {
-            	break;
+        u8_Burst = u8MaxMeas - u8_Nb;
+        u8_Burst = (u8_Burst > NOISE_MEAS_BURST_NB)?(NOISE_MEAS_BURST_NB):(u8_Burst);
+        if ( adf7030_1__SPI_rd_word_r_a( pSPIDevInfo, aAddr, aRead, u8_Burst ) )
+        {
+        	break;
+        }
+        for (u8i = 0; u8i < u8_Burst; u8i++)
+        {
+            ccaReadBack = (cca_read_back_t)aRead[u8i];
+            u16_NoiseMeas = ccaReadBack.CCA_READBACK_b.VALUE;
+            if (ccaReadBack.CCA_READBACK_b.LIVE_STATUS == 1 || u16_NoiseMeas == 0){
+            	u16_Invalid++;
+            }
+            else {
+                u32_Sum += u16_NoiseMeas;
+                u32_SumSq += (uint32_t)u16_NoiseMeas * u16_NoiseMeas;
+                u8_Nb++;
             }
         }
-        else {
-            u32_Sum += u16_NoiseMeas;
-            u16_NoiseAvg = u32_Sum / u8i;
+        if (u16_Invalid > (u8MaxMeas*10) ) {
+        	break;
         }
-        if (u8j > 1000) {
+        if ( (mtick() - u32_Start) >= u32Budget ) {
         	break;
         }
+        if (u8_Nb >= NOISE_MEAS_MIN_NB)
+        {
+        	// Var. of the mean = (n.Sum(x^2) - Sum(x)^2) / n^3
+        	u64_Dev = (uint64_t)u8_Nb * u32_SumSq - (uint64_t)u32_Sum * u32_Sum;
+        	if ( u64_Dev <= (uint64_t)NOISE_MEAS_VAR_THR * u8_Nb * u8_Nb * u8_Nb ) {
+        		break;
+        	}
+        }
     }
-    return u16_NoiseAvg;
+    if (u8_Nb == 0) { return 1; }
+
+    pMeas->u16NbMeas = u8_Nb;
+    pMeas->u16Noise = (uint16_t)( (u32_Sum + (u8_Nb >> 1)) / u8_Nb );
+    u64_Dev = (uint64_t)u8_Nb * u32_SumSq - (uint64_t)u32_Sum * u32_Sum;
+    pMeas->u32Var = (uint32_t)( u64_Dev / ((uint32_t)u8_Nb * u8_Nb) );
+    return 0;
 }
 
 /*!
@@ -598,6 +684,57 @@ uint8_t adf7030_1__SetupLPM(
     return ( (pSPIDevInfo->eXferResult)?(1):(0) );
 }
 
+/*!
+ * @brief  This function setup, enable/disable the smart wake mode.
+ *
+ * @details When enabled, the RTC wakes the ADF7030-1 up every period to listen
+ *          (PHY_RX) until one of the dwell time expires, then it goes back
+ *          to sleep. So, the host is only interrupted when a frame is detected.
+ *          The RTC is (re)configured on the next CFG_DEV.
+ *
+ * @param [in] pSPIDevInfo Pointer to ADF7030-1 SPI device instance.
+ * @param [in] bFlag       Enable/disable the smart wake mode
+ * @param [in] u32Period   Wake-up period (in ms)
+ * @param [in] u32Dwell    Preamble dwell times (see lpm_cfg_t)
+ *
+ * @return      Status
+ *  - #ADF7030_1_SUCCESS         If the transfert was succesfull to the adf7030-1.
+ *  - #ADF7030_1_INVALID_HANDLE  [D] If the given SPI ADF7030-1 device instance is invalid.
+ *  - #ADF7030_1_SPI_COMM_FAILED [D] If the transfert failed.
+ */
+uint8_t adf7030_1__SetupSmartWake(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint8_t bFlag,
+    uint32_t u32Period,
+    uint32_t u32Dwell
+)
+{
+    lpm_cfg0_t lpm_cfg0;
+    wake_source_t wake_src;
+    if (pSPIDevInfo == NULL) { return 1;}
+
+    lpm_cfg0 = (lpm_cfg0_t)adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_LPM_CFG0_Addr);
+    wake_src = (wake_source_t)adf7030_1__SPI_GetMem32(pSPIDevInfo, SM_CONFIG_WAKE_SOURCE_Addr);
+    if (bFlag)
+    {
+        adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_LPM_CFG1_Addr, (u32Period * ADF7030_1_LFRC_FREQ) / 1000);
+        adf7030_1__SPI_SetMem32(pSPIDevInfo, GENERIC_PKT_LPM_CFG_Addr, u32Dwell);
+        wake_src.WAKE_SOURCE_b.EXT |= WAKE_UP_RTC;
+    }
+    else
+    {
+        wake_src.WAKE_SOURCE_b.EXT &= ~WAKE_UP_RTC;
+    }
+    lpm_cfg0.LPM_CFG0_b.RTC_LF_SRC_SEL = PROFILE_LPM_CFG0_RTC_LF_SRC_SEL_LFRC_Eval;
+    lpm_cfg0.LPM_CFG0_b.RTC_RECONFIG_EN = 1;
+    lpm_cfg0.LPM_CFG0_b.RTC_EN = bFlag;
+    lpm_cfg0.LPM_CFG0_b.RETAIN_SRAM = bFlag;
+    lpm_cfg0.LPM_CFG0_b.ENABLE = bFlag;
+    adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_LPM_CFG0_Addr, lpm_cfg0.LPM_CFG0);
+    adf7030_1__SPI_SetMem32(pSPIDevInfo, SM_CONFIG_WAKE_SOURCE_Addr, wake_src.WAKE_SOURCE);
+    return ( (pSPIDevInfo->eXferResult)?(1):(0) );
+}
+
 /*!
  * @brief  This function setup the wake-up source.
  *
@@ -906,6 +1043,102 @@ uint8_t adf7030_1__GetRxPacket(
     return e_Ret;
 }
 
+/*!
+ * @brief  This function compare a received address with the expected one
+ *
+ * @param [in]  p_Rx      Pointer on the received address.
+ * @param [in]  p_Addr    Pointer on the expected address.
+ * @param [in]  u8_AddrSz Size of the address.
+ *
+ * @return  1 if they match (0xF received nibbles match any nibble), 0 otherwise
+ */
+static uint8_t _addr_match(const uint8_t *p_Rx, const uint8_t *p_Addr, uint8_t u8_AddrSz)
+{
+    uint8_t u8_Msk;
+    while (u8_AddrSz--)
+    {
+        u8_Msk = ( ((*p_Rx & 0xF0) == 0xF0)?(0x00):(0xF0) ) | ( ((*p_Rx & 0x0F) == 0x0F)?(0x00):(0x0F) );
+        if ( (*p_Rx ^ *p_Addr) & u8_Msk )
+        {
+            return 0;
+        }
+        p_Rx++;
+        p_Addr++;
+    }
+    return 1;
+}
+
+/*!
+ * @brief  This function copy the ADF7030 RX buffer into the given buffer, if its
+ *         address field match.
+ *
+ * @details The frame is read up to the end of the address field first. The
+ *          remaining is read only if the address match, so a foreign frame
+ *          costs only a short SPI transfer. A received 0xF nibble is a
+ *          wildcard (EN13757-4), so broadcast frames always match.
+ *
+ * @param [in]  pSPIDevInfo Pointer to ADF7030-1 SPI device instance.
+ * @param [out] p_Data      Pointer on buffer to copy in the RX packet.
+ * @param [out] *u8_Sz      Reference variable to hold the size of the packet (with CRC).
+ * @param [in]  p_Addr      Pointer on the address to match.
+ * @param [in]  u8_Offset   Offset of the address field in the packet.
+ * @param [in]  u8_AddrSz   Size of the address field.
+ * @param [out] *pb_Match   Reference variable to hold the result (1 : match, the packet has been read).
+ *
+ * @return      Status
+ *  - #ADF7030_1_SUCCESS         If successfully read (or filtered out).
+ *  - #ADF7030_1_INVALID_HANDLE  [D]  If the given ADF7030-1 device instance is invalid.
+ *  - #ADF7030_1_SPI_COMM_FAILED [D] If the transfert failed.
+ */
+uint8_t adf7030_1__GetRxPacketFilt(
+    adf7030_1_spi_info_t* pSPIDevInfo,
+    uint8_t *p_Data,
+    uint8_t *u8_Sz,
+    const uint8_t *p_Addr,
+    uint8_t u8_Offset,
+    uint8_t u8_AddrSz,
+    uint8_t *pb_Match
+)
+{
+    uint8_t e_Ret = 1;
+    data_blck_desc_t sBlock;
+    buff_cfg0_t buff_cfg_0;
+    uint16_t frame_len;
+    uint16_t head_len = u8_Offset + u8_AddrSz;
+    if (pSPIDevInfo == NULL) { return e_Ret;}
+
+    *pb_Match = 0;
+    frame_len = adf7030_1__READ_FIELD(GENERIC_PKT_FRAME_CFG3_RX_LENGTH);
+    *u8_Sz = (uint8_t)frame_len;
+    if (frame_len < head_len)
+    {
+        /* Too short to hold the address */
+        return ( (pSPIDevInfo->eXferResult)?(1):(0) );
+    }
+    buff_cfg_0 = (buff_cfg0_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, GENERIC_PKT_BUFF_CFG0_Addr));
+    sBlock.Addr = PARAM_ADF7030_1_SRAM_BASE;
+    sBlock.Addr |= buff_cfg_0.BUFF_CFG0_b.PTR_RX_BASE << 2;
+    sBlock.pData = p_Data;
+    sBlock.WordXfer = 0;
+    sBlock.Size = head_len;
+    /* Readback the frame header, up to the address field */
+    e_Ret = adf7030_1__ReadDataBlock( pSPIDevInfo, &sBlock);
+    if ( e_Ret || !_addr_match(&p_Data[u8_Offset], p_Addr, u8_AddrSz) )
+    {
+        return e_Ret;
+    }
+    *pb_Match = 1;
+    if (frame_len > head_len)
+    {
+        /* Readback the remaining */
+        sBlock.Addr += head_len;
+        sBlock.pData = &p_Data[head_len];
+        sBlock.Size = frame_len - head_len;
+        e_Ret = adf7030_1__ReadDataBlock( pSPIDevInfo, &sBlock);
+    }
+    return e_Ret;
+}
+
 /*!
  * @brief This function measure the noise
  *
@@ -1007,9 +1240,10 @@ uint8_t adf7030_1_Setup(
 {
     adf7030_1_spi_info_t* pSPIDevInfo = NULL;
 
-    if ( pDevice != NULL) {
+    if ( (pDevice != NULL) && (pDevice->u8InstId < ADF7030_1_NUM_DEV) ) {
         pSPIDevInfo = &(pDevice->SPIInfo);
         pSPIDevInfo->hSPIDevice = NULL;
+        pSPIDevInfo->nDevId = pDevice->u8InstId;
         pSPIDevInfo->eXferResult = ADF7030_1_SUCCESS;
 
         pSPIDevInfo->nStatus.VALUE = 0;
@@ -1033,10 +1267,19 @@ uint8_t adf7030_1_Setup(
     	pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM0_ADDR]  = 0x20000000;
     	pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM1_ADDR]  = 0x20000000;
     	pSPIDevInfo->PHY_PNTR[PNTR_CUSTOM2_ADDR]  = 0x20000000;
+    	// No valid user pointers cache yet
+    	pSPIDevInfo->bPntrCacheValid = 0;
+    	pSPIDevInfo->nPntrCacheCnt = 0;
+    	pSPIDevInfo->nPntrCacheHit = 0;
+    	pSPIDevInfo->nPntrCacheMiss = 0;
+    	pSPIDevInfo->nPntrCacheBad = 0;
+    	// Pointer allocator starts from scratch
+    	memset(pSPIDevInfo->nPntrUse, 0, sizeof(pSPIDevInfo->nPntrUse));
+    	pSPIDevInfo->nPntrAllocCnt = 0;
 
         /* Set the SPI TX and RX buffer */
-        pSPIDevInfo->pSPI_TX_BUFF = a_SpiTxBuf;
-        pSPIDevInfo->pSPI_RX_BUFF = a_SpiRxBuf;
+        pSPIDevInfo->pSPI_TX_BUFF = a_SpiTxBuf[pSPIDevInfo->nDevId];
+        pSPIDevInfo->pSPI_RX_BUFF = a_SpiRxBuf[pSPIDevInfo->nDevId];
         /* Initialise underlying GPIO service information structure for IRQs */
         if (pINTDevInfo)
         {
@@ -132,45 +132,80 @@ uint8_t PHY_CONV_Signed11ToRssi(uint16_t u16_Signed11)
 }
 
 /*!
- * @brief  This function convert a ADF7030 (signed 11 bits) RSSI to float.
+ * @brief  This function convert a ADF7030 (signed 11 bits) RSSI to 1/4 dBm.
  *
- * @param [in]  iu16_Signed11 The ADF7030 (signed 11 bits) RSSI value.
+ * @param [in]  u16_Signed11 The ADF7030 (signed 11 bits) RSSI value.
  *
- * @return The float representation of RSSI
+ * @return The RSSI in 1/4 dBm unit
  */
 inline __attribute__((always_inline))
-float PHY_CONV_Signed11ToFloat(uint16_t u16_Signed11)
+int16_t PHY_CONV_Signed11ToQdBm(uint16_t u16_Signed11)
 {
-    float Rssi;
-
-	int16_t i16_Tmp = ( (int16_t)(u16_Signed11 << 5) ) /128;
-	uint8_t u8DecPart = ( ( ( u16_Signed11^0x7FF ) +1 )& 0x3) * 25;
-
-	Rssi = (float)(i16_Tmp) ;
-	if (i16_Tmp < 0)
-	{
-		Rssi -= (float)(u8DecPart)/100 ;
-	}
-	else
-	{
-		Rssi += (float)(u8DecPart)/100 ;
-	}
-	return Rssi;
+	// sign extend the 11 bits value
+	return ( (int16_t)(u16_Signed11 << 5) ) >> 5;
 }
 
 /*!
- * @brief  This function convert a ADF7030 AFC frequency error to float.
+ * @brief  This function convert a ADF7030 AFC frequency error to Hz.
+ *
+ * @details The AFC frequency error unit is 26 MHz / 2^22, that is
+ *          203125 / 2^15 Hz.
  *
- * @param [in]  i16AfcFreqErr The ADF7030 (signed 11 bits) AFC frequency error value.
+ * @param [in]  i16AfcFreqErr The ADF7030 AFC frequency error value.
  *
- * @return The float representation of AFC frequency error
+ * @return The AFC frequency error in Hz (rounded)
  */
 inline __attribute__((always_inline))
-float PHY_CONV_AfcFreqErrToFloat(int16_t i16AfcFreqErr)
+int32_t PHY_CONV_AfcFreqErrToHz(int16_t i16AfcFreqErr)
+{
+	return (int32_t)( ( (int64_t)i16AfcFreqErr * 203125 + (1 << 14) ) >> 15 );
+}
+
+/*!
+ * @brief This table hold the decimal part (1/100 dB) of the 1/4 dB steps
+ */
+static const char * const aQuarterDecStr[4] = { ".00", ".25", ".50", ".75" };
+
+/*!
+ * @brief  This function format a 1/4 dBm value into a string (e.g. "-97.25").
+ *
+ * @param [in]  i16_QdBm  The value in 1/4 dBm unit.
+ * @param [out] pStr      Buffer to hold the string (at least PHY_CONV_QDBM_STR_SZ bytes).
+ *
+ * @return The string length
+ */
+uint8_t PHY_CONV_QdBmToStr(int16_t i16_QdBm, char *pStr)
 {
-    float FreqErr;
-	FreqErr = ((float)i16AfcFreqErr)* 26000000.00 / 4194304.00;
-	return FreqErr;
+	char aTmp[6];
+	uint16_t u16Abs;
+	uint16_t u16Int;
+	uint8_t u8Frac;
+	uint8_t u8Len = 0;
+	uint8_t u8i = 0;
+
+	// magnitude computed on 32 bits (-INT16_MIN doesn't fit in an int16_t)
+	u16Abs = (uint16_t)( (i16_QdBm < 0)?( -(int32_t)i16_QdBm ):( i16_QdBm ) );
+	if (i16_QdBm < 0)
+	{
+		pStr[u8Len++] = '-';
+	}
+	u16Int = u16Abs >> 2;
+	u8Frac = (uint8_t)(u16Abs & 0x3);
+	// integer part, reverse order
+	do {
+		aTmp[u8i++] = '0' + (u16Int % 10);
+		u16Int /= 10;
+	} while (u16Int);
+
+	while (u8i) {
+		pStr[u8Len++] = aTmp[--u8i];
+	}
+	// decimal part
+	for (u8i = 0; u8i < 3; u8i++) {
+		pStr[u8Len++] = aQuarterDecStr[u8Frac][u8i];
+	}
+	pStr[u8Len] = '\0';
+	return u8Len;
 }
 
 #ifdef __cplusplus
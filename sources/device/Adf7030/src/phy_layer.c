@@ -119,6 +119,18 @@ phy_power_t aPhyPower[PHY_NB_PWR] __attribute__(( weak )) =
 	[PHY_PMAX_minus_12db] = {.coarse = 6, .fine =  3, .micro = 0}, // -12 dBm
 };
 
+/*!
+ * @brief This table hold the sniff (smart wake receive) setup of each modulation
+ *
+ * @note The transmitter wake-up preamble must last more than the period.
+ */
+phy_sniff_t aPhySniff[PHY_NB_MOD] __attribute__(( weak )) =
+{
+	[PHY_WM2400] = {.u16Period = 1000, .u8DetectDwell = 32, .u8QualDwell = 32, .u8SyncDwell = 64},
+	[PHY_WM4800] = {.u16Period = 1000, .u8DetectDwell = 32, .u8QualDwell = 32, .u8SyncDwell = 64},
+	[PHY_WM6400] = {.u16Period = 1000, .u8DetectDwell = 32, .u8QualDwell = 32, .u8SyncDwell = 64},
+};
+
 #ifdef PHY_USE_POWER_RAMP
 pa_ramp_rate_e pa_ramp_rate __attribute__(( weak )) = RAMP_OFF;
 #endif
@@ -146,47 +158,57 @@ int16_t i16RssiOffsetCal __attribute__(( weak )) = 0;
  * @brief This table hold the WM2400 modulation configuration
  */
 static const uint8_t RF_CFG_WM2400[] = {
+#if (ADF7030_1_CFG_PACKED == 1)
+    #include "WM2400_small.cfz"
+#else
     #include "WM2400_small.cfg"
+#endif
 };
 
 /*!
  * @brief This table hold the WM4800 modulation configuration
  */
 static const uint8_t RF_CFG_WM4800[] = {
+#if (ADF7030_1_CFG_PACKED == 1)
+    #include "WM4800_small.cfz"
+#else
     #include "WM4800_small.cfg"
+#endif
 };
 
 /*!
  * @brief This table hold the WM6400 modulation configuration
  */
 static const uint8_t RF_CFG_WM6400[] = {
+#if (ADF7030_1_CFG_PACKED == 1)
+    #include "WM6400_small.cfz"
+#else
     #include "WM6400_small.cfg"
+#endif
 };
 
 /*!
  * @brief This table hold the calibration configuration
  */
 static const uint8_t RF_CAL_CFG[] = {
+#if (ADF7030_1_CFG_PACKED == 1)
+	#include "OfflineCalibrations.cfz"
+#else
 	#include "OfflineCalibrations.cfg"
+#endif
 };
 
 /*!
  * @brief This table hold the basis configuration
  */
 static const uint8_t RF_BASE_CFG[] = {
+#if (ADF7030_1_CFG_PACKED == 1)
+    #include "WM_base.cfz"
+#else
     #include "WM_base.cfg"
+#endif
 };
 
-/*!
- * @brief This table hold the radio calibration result
- */
-static uint8_t RF_RADIO_CAL[RADIO_CAL_SZ];
-
-/*!
- * @brief This table hold the vco calibration result
- */
-static uint8_t RF_VCO_CAL[VCO_CAL_SZ];
-
 /*!
  * @brief This table hidden rf config
  */
@@ -229,9 +251,7 @@ static const cfg_t RF_CFG[PHY_NB_CFG] = {
     [PHY_WM6400]    = RF_CFG_SETUP( RF_CFG_WM6400 ),
 	// hidden config
 	[PHY_BASE_CFG]  = RF_CFG_SETUP( RF_BASE_CFG ),
-	//
-	[PHY_RADIO_CAL] = RF_CFG_SETUP( RF_RADIO_CAL ),
-	[PHY_VCO_CAL]   = RF_CFG_SETUP( RF_VCO_CAL ),
+	// PHY_RADIO_CAL and PHY_VCO_CAL results are held by each instance (see phy_inst_t)
 	[PHY_CAL_CFG]   = RF_CFG_SETUP( RF_CAL_CFG ),
 	[PHY_HIDDEN]    = RF_CFG_SETUP( RF_HIDDEN ),
 };
@@ -258,6 +278,101 @@ mem_cfg_desc_t sConfig =
 };
 #endif
 
+/*!
+ * @brief This structure hold the received frame records ring
+ */
+typedef struct {
+	phy_rx_frame_t   aFrame[PHY_RX_RING_NB]; /*!< Frame records */
+	volatile uint8_t u8WrIdx;                /*!< Write index (free running) */
+	volatile uint8_t u8RdIdx;                /*!< Read index (free running) */
+	volatile uint8_t bRearmed;               /*!< RX has been re-armed by the PHY itself */
+	volatile uint32_t u32Overflow;           /*!< Number of frames lost on full ring */
+} rx_ring_t;
+
+#define RX_RING_MSK (PHY_RX_RING_NB - 1)
+#define RX_RING_CNT(pInst) ( (uint8_t)((pInst)->sRxRing.u8WrIdx - (pInst)->sRxRing.u8RdIdx) )
+
+/*!
+ * @brief This structure hold the received frame address filter
+ */
+typedef struct {
+	uint8_t           aAddr[PHY_ADDR_FILT_SZ]; /*!< Address to match (M-field then A-field) */
+	volatile uint8_t  bEnable;                 /*!< The filter is enabled */
+	volatile uint32_t u32Filtered;             /*!< Number of dropped frames */
+} addr_filt_t;
+
+/*!
+ * @brief This structure hold the radio CRC offload
+ */
+typedef struct {
+	uint8_t           bEnable;   /*!< The CRC is computed and checked by the radio */
+	uint8_t           bLastOk;   /*!< The last frame given by _get_recv has been verified by the radio */
+	volatile uint8_t  bChk;      /*!< Latched "CRC correct" of the current received frame */
+	volatile uint32_t u32Errors; /*!< Number of frames dropped on bad CRC */
+} crc_ofl_t;
+
+/*!
+ * @brief This structure hold the scheduled transmission
+ */
+typedef struct {
+	phydev_t          *pPhydev; /*!< Phy device instance to trigger */
+	uint32_t          u32Armed; /*!< Time spent to pre-arm, i.e. the timer start from the request (µs) */
+	uint32_t          u32Freq;  /*!< Timer kernel clock frequency (Hz) */
+	uint32_t          u32Cmp;   /*!< Timer compare value */
+	uint8_t           u8Presc;  /*!< Timer prescaler (power of 2) */
+	uint8_t           bTrigOn;  /*!< The trigger pin is enabled on the radio */
+	volatile uint8_t  bArmed;   /*!< The radio is waiting for the trigger */
+	volatile uint32_t u32Cnt;   /*!< Timer counter when the trigger has been pulsed, 0 : not yet */
+} txat_t;
+
+/*!
+ * @brief This structure hold the multi-channel listen (scan)
+ */
+typedef struct {
+	phydev_t          *pPhydev;  /*!< Phy device instance to retune */
+	uint8_t           u8ChMsk;   /*!< Channels to listen on */
+	uint16_t          u16Dwell;  /*!< Listen time on each channel (ms) */
+	uint16_t          u16Lock;   /*!< Additional listen time on preamble detection (ms) */
+	uint8_t           bLockExt;  /*!< The listen time has already been extended on this channel */
+	volatile uint8_t  bLock;     /*!< A preamble has been detected on this channel */
+	volatile uint8_t  bOn;       /*!< The scan is running */
+	phy_scan_stats_t  sStats;    /*!< Statistics */
+} scan_t;
+
+/*!
+ * @brief This structure hold the state of one Phy device instance (i.e. one radio)
+ */
+typedef struct {
+	adf7030_1_device_t *pDevice;                /*!< Device context of the instance (NULL : free) */
+	spi_dev_t          *pSpiDev;                /*!< SPI device (bus and chip select) of the radio */
+	uint8_t            bPwrOn;                  /*!< The radio is powered */
+	uint32_t           u32PntrCacheKey;         /*!< Key (base configuration hash) of the memory map pointers cache */
+	rx_ring_t          sRxRing;                 /*!< Received frame records ring */
+	noise_meas_t       sNoiseMeas;              /*!< Last noise measurement */
+	addr_filt_t        sAddrFilt;               /*!< Received frame address filter */
+	crc_ofl_t          sCrcOfl;                 /*!< Radio CRC offload */
+	uint8_t            aRadioCal[RADIO_CAL_SZ]; /*!< Radio calibration result */
+	uint8_t            aVcoCal[VCO_CAL_SZ];     /*!< VCO calibration result */
+	txat_t             sTxAt;                   /*!< Scheduled transmission */
+	scan_t             sScan;                   /*!< Multi-channel listen (scan) */
+} phy_inst_t;
+
+/*!
+ * @brief This hold the Phy device instances
+ */
+static phy_inst_t aPhyInst[PHY_NB_INST];
+
+/*!
+ * @brief Convenient macro to get the instance of a Phy device
+ */
+#define PHY_INST(pPhydev) ( &aPhyInst[((adf7030_1_device_t*)((pPhydev)->pCxt))->u8InstId] )
+
+/*!
+ * @brief This hold the instance owning the low power timer, i.e. its scheduled
+ *        transmission or its scan (one timer, so one at a time). NULL : free
+ */
+static phy_inst_t *pTimInst;
+
 // Private function (mapped to interface)
 static int32_t _init(phydev_t *pPhydev);
 static int32_t _uninit(phydev_t *pPhydev);
@@ -289,22 +404,27 @@ static const phy_if_t _phy_if = {
 	.pfIoctl         = _ioctl
 };
 
-extern spi_dev_t spi_ADF7030;
-
 /*!
  * @brief  This function prepare the Phy device with constant configuration
  *
+ * Each call with a new device context takes one of the PHY_NB_INST instances.
+ * Instances must not share their SPI bus, because the frame interrupt of one
+ * could access it while the other is transferring.
+ *
  * @param [in]  pPhydev Pointer
+ * @param [in]  pCtx    Pointer on the device context of the radio
+ * @param [in]  pSpiDev Pointer on the SPI device (bus and chip select) of the radio
  *
  * @return      Status
  * - PHY_STATUS_OK     Function has been successfully executed
  * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
- * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure), or no free instance
  *
  */
 int32_t Phy_adf7030_setup(
     phydev_t *pPhydev,
     adf7030_1_device_t *pCtx,
+    spi_dev_t *pSpiDev,
     adf7030_1_gpio_int_info_t*   const pINTDevInfo,
     adf7030_1_gpio_trig_info_t*  const pTRIGDevInfo,
     adf7030_1_gpio_reset_info_t* const pRESETDevInfo,
@@ -313,8 +433,28 @@ int32_t Phy_adf7030_setup(
     )
 {
     int32_t i32Ret = PHY_STATUS_ERROR;
-    if (pPhydev && pCtx)
+    uint8_t u8Id;
+    if (pPhydev && pCtx && pSpiDev)
     {
+        // take the instance of this context, otherwise a free one
+        for (u8Id = 0; u8Id < PHY_NB_INST; u8Id++)
+        {
+        	if (aPhyInst[u8Id].pDevice == pCtx) { break; }
+        }
+        if (u8Id == PHY_NB_INST)
+        {
+            for (u8Id = 0; u8Id < PHY_NB_INST; u8Id++)
+            {
+            	if (aPhyInst[u8Id].pDevice == NULL) { break; }
+            }
+            if (u8Id == PHY_NB_INST)
+            {
+            	return PHY_STATUS_ERROR;
+            }
+        }
+        aPhyInst[u8Id].pDevice = pCtx;
+        aPhyInst[u8Id].pSpiDev = pSpiDev;
+        pCtx->u8InstId = u8Id;
         pPhydev->pIf = &_phy_if;
         pPhydev->pCxt = pCtx;
         if ( !(adf7030_1_Setup(
@@ -446,32 +586,84 @@ int32_t Phy_GetPowerEntry(phydev_t *pPhydev, phy_power_e eEntryId, phy_power_t *
 	return eStatus;
 }
 
+/*!
+ * @brief  This function set/change entry in sniff table
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eModulation The modulation (entry id in the sniff table)
+ * @param [in]  sSniffEntry The sniff setup
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  The modulation is unknown
+ */
+int32_t Phy_SetSniffEntry(phydev_t *pPhydev, phy_mod_e eModulation, phy_sniff_t sSniffEntry)
+{
+    int32_t eStatus = PHY_STATUS_BUSY;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    if (eModulation >= PHY_NB_MOD)
+    {
+    	return PHY_STATUS_ERROR;
+    }
+	if ( !(pDevice->eState & ADF7030_1_STATE_BUSY) )
+	{
+		aPhySniff[eModulation] = sSniffEntry;
+		eStatus = PHY_STATUS_OK;
+	}
+	return eStatus;
+}
+
+/*!
+ * @brief  This function get entry in sniff table
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eModulation The modulation (entry id in the sniff table)
+ * @param [out] sSniffEntry The sniff setup
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_ERROR  The modulation is unknown
+ */
+int32_t Phy_GetSniffEntry(phydev_t *pPhydev, phy_mod_e eModulation, phy_sniff_t *sSniffEntry)
+{
+    (void)pPhydev;
+    if (eModulation >= PHY_NB_MOD)
+    {
+    	return PHY_STATUS_ERROR;
+    }
+	*sSniffEntry = aPhySniff[eModulation];
+	return PHY_STATUS_OK;
+}
+
 /*!
  * @brief  This function Get the radio and vco calibration data
  *
- * @param [in]  pBuf Pointer to write in the calibration data
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pBuf    Pointer to write in the calibration data
  *
  * @return      Status
  * - PHY_STATUS_OK     Requested sequence has been successfully executed
  * - PHY_STATUS_ERROR  The internal calibration data are not valid
  *
  */
-int32_t Phy_GetCal(uint8_t *pBuf)
+int32_t Phy_GetCal(phydev_t *pPhydev, uint8_t *pBuf)
 {
 	int32_t eStatus = PHY_STATUS_ERROR;
+    phy_inst_t *pInst = PHY_INST(pPhydev);
     uint8_t *p = pBuf;
     if (p)
     {
-    	if ( *(uint64_t*)(RF_CFG[PHY_RADIO_CAL].cf) == RADIO_CAL_HEADER_BE)
+    	if ( *(uint64_t*)(pInst->aRadioCal) == RADIO_CAL_HEADER_BE)
     	{
 			// Get RADIO Calibration from local buffer
-			memcpy(p, RF_CFG[PHY_RADIO_CAL].cf, RF_CFG[PHY_RADIO_CAL].size );
-			p += RF_CFG[PHY_RADIO_CAL].size;
+			memcpy(p, pInst->aRadioCal, RADIO_CAL_SZ );
+			p += RADIO_CAL_SZ;
 
-	    	if ( *(uint64_t*)(RF_CFG[PHY_RADIO_CAL].cf) == VCO_CAL_HEADER_BE)
+	    	if ( *(uint64_t*)(pInst->aVcoCal) == VCO_CAL_HEADER_BE)
 	    	{
 				// Get VCO Calibration from local buffer
-				memcpy(p, RF_CFG[PHY_VCO_CAL].cf, RF_CFG[PHY_VCO_CAL].size );
+				memcpy(p, pInst->aVcoCal, VCO_CAL_SZ );
 				eStatus = PHY_STATUS_OK;
 	    	}
     	}
@@ -482,16 +674,18 @@ int32_t Phy_GetCal(uint8_t *pBuf)
 /*!
  * @brief  This function Set the radio and vco calibration data
  *
- * @param [in]  pBuf Pointer on the calibration data to set
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pBuf    Pointer on the calibration data to set
  *
  * @return      Status
  * - PHY_STATUS_OK     Requested sequence has been successfully executed
  * - PHY_STATUS_ERROR  The given calibration data are not valid
  *
  */
-int32_t Phy_SetCal(uint8_t *pBuf)
+int32_t Phy_SetCal(phydev_t *pPhydev, uint8_t *pBuf)
 {
 	int32_t eStatus = PHY_STATUS_ERROR;
+    phy_inst_t *pInst = PHY_INST(pPhydev);
     uint8_t *p = pBuf;
     if (p)
     {
@@ -499,15 +693,15 @@ int32_t Phy_SetCal(uint8_t *pBuf)
     	if ( *(uint64_t*)(p) == RADIO_CAL_HEADER_BE )
     	{
     		// Set RADIO Calibration to local buffer
-    		memcpy(RF_CFG[PHY_RADIO_CAL].cf, p, RF_CFG[PHY_RADIO_CAL].size );
+    		memcpy(pInst->aRadioCal, p, RADIO_CAL_SZ );
 
-    		p += RF_CFG[PHY_RADIO_CAL].size;
+    		p += RADIO_CAL_SZ;
 
     		// check if vco calibration data is (seems) valid
         	if ( *(uint64_t*)(p) == VCO_CAL_HEADER_BE )
         	{
         		// Set VCO Calibration to local buffer
-        		memcpy(RF_CFG[PHY_VCO_CAL].cf, p, RF_CFG[PHY_VCO_CAL].size );
+        		memcpy(pInst->aVcoCal, p, VCO_CAL_SZ );
         		eStatus = PHY_STATUS_OK;
         	}
     	}
@@ -518,14 +712,17 @@ int32_t Phy_SetCal(uint8_t *pBuf)
 /*!
  * @brief  This function clear the radio and vco calibration data
  *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
  * @return           Status
  * - PHY_STATUS_OK   Requested sequence has been successfully executed
  *
  */
-inline int32_t Phy_ClrCal(void)
+inline int32_t Phy_ClrCal(phydev_t *pPhydev)
 {
-	*(uint64_t*)(RF_CFG[PHY_RADIO_CAL].cf) = 0x0;
-	*(uint64_t*)(RF_CFG[PHY_VCO_CAL].cf) = 0x0;
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	*(uint64_t*)(pInst->aRadioCal) = 0x0;
+	*(uint64_t*)(pInst->aVcoCal) = 0x0;
 	return PHY_STATUS_OK;
 }
 
@@ -542,13 +739,46 @@ inline int32_t Phy_ClrCal(void)
  */
 int32_t Phy_AutoCalibrate(phydev_t *pPhydev)
 {
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    return Phy_AutoCalibrateStages(pPhydev, pDevice->CalCfg.RADIO_CAL_CFG0);
+}
+
+/*!
+ * @brief  This function implement the (partial) calibration sequence
+ *
+ * @details The offline calibration image is uploaded only if it is not resident
+ *          (powered off or SRAM lost since the last upload). Otherwise, its
+ *          patch sequences are read back and checked, and only its
+ *          configuration sequences (if any) are sent again.
+ *          Stages not requested keep their current results. On exit, the
+ *          calibration patch is disabled and the profile fields it changed are
+ *          restored, so the modulation configuration is kept (no reset, no
+ *          full configuration on the next READY).
+ *
+ * @param [in]  pPhydev   Pointer on the Phy device instance
+ * @param [in]  u32Stages Calibrations to run (see adf7030_1_radio_cal_e)
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+int32_t Phy_AutoCalibrateStages(phydev_t *pPhydev, uint32_t u32Stages)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
 	int32_t eStatus = PHY_STATUS_ERROR;
 	uint8_t eRet = 0;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
     adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
     data_blck_desc_t sBlock;
+    uint32_t u32CalCfg0;
 
-    eStatus = _ioctl(pPhydev, PHY_CTL_CMD_RESET, 0);
+    eStatus = PHY_STATUS_OK;
+    if ( !pDevice->bCalResident )
+    {
+    	eStatus = _ioctl(pPhydev, PHY_CTL_CMD_RESET, 0);
+    }
     if (eStatus == PHY_STATUS_OK )
     {
     	eStatus = _ioctl(pPhydev, PHY_CTL_CMD_READY, 0);
@@ -557,11 +787,41 @@ int32_t Phy_AutoCalibrate(phydev_t *pPhydev)
 	// It must be set to READY before
 	if(pDevice->eState & ADF7030_1_STATE_READY)
 	{
+		// OK only once the calibration succeeded and its results have been read
+		eStatus = PHY_STATUS_ERROR;
 		// device must be in PHY_OFF state
 		eRet |= adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, PHY_OFF, PHY_OFF );
 
-		// Transfers Offline calibration patch to the PHY Radio
-	    eRet |= adf7030_1_Configure(pDevice, RF_CFG[PHY_CAL_CFG].cf, RF_CFG[PHY_CAL_CFG].size);
+		if ( pDevice->bCalResident )
+		{
+			// Is the patch still there ?
+			if ( adf7030_1__VerifyConfiguration( pSPIDevInfo, RF_CFG[PHY_CAL_CFG].cf, RF_CFG[PHY_CAL_CFG].size, ADF7030_1_CFG_SEQ_PATCH) )
+			{
+				pDevice->bCalResident = 0;
+			}
+			else
+			{
+				// yes, just send the configuration part
+				eRet |= adf7030_1__SendConfigurationPart( pSPIDevInfo, RF_CFG[PHY_CAL_CFG].cf, RF_CFG[PHY_CAL_CFG].size, ADF7030_1_CFG_SEQ_CFG);
+			}
+		}
+		if ( !pDevice->bCalResident )
+		{
+			// Transfers Offline calibration patch to the PHY Radio
+			eRet |= adf7030_1_Configure(pDevice, RF_CFG[PHY_CAL_CFG].cf, RF_CFG[PHY_CAL_CFG].size);
+		}
+		pDevice->bCalResident = (eRet)?(0):(1);
+
+		// Start from the current results, so not requested stages are kept
+		if ( (*(uint64_t*)(pInst->aRadioCal) == RADIO_CAL_HEADER_BE) &&
+			 (*(uint64_t*)(pInst->aVcoCal) == VCO_CAL_HEADER_BE) )
+		{
+			eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, pInst->aRadioCal, RADIO_CAL_SZ);
+			eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, pInst->aVcoCal, VCO_CAL_SZ);
+		}
+
+		// Keep the configured stages, to restore them after
+		u32CalCfg0 = adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_RADIO_CAL_CFG0_Addr);
 
 		// Change frequency to mid of the band
 		adf7030_1__SPI_SetMem32( pSPIDevInfo, PROFILE_CH_FREQ_Addr, (uint32_t)(PHY_FREQUENCY_CH(PHY_CH120) + PHY_CHANNEL_WIDTH/2));
@@ -572,7 +832,7 @@ int32_t Phy_AutoCalibrate(phydev_t *pPhydev)
 	    eRet |= adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, PHY_ON, PHY_ON );
 
 		// Setup "module" to calibrate
-	    adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_RADIO_CAL_CFG0_Addr, pDevice->CalCfg.RADIO_CAL_CFG0);
+	    adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_RADIO_CAL_CFG0_Addr, u32Stages);
 		// Start the calibration
 	    eRet |= adf7030_1__STATE_PhyCMD( pSPIDevInfo, DO_CAL );
 	    if (!eRet)
@@ -580,31 +840,49 @@ int32_t Phy_AutoCalibrate(phydev_t *pPhydev)
 			// Wait for calibration done
 			eRet = adf7030_1__STATE_WaitStateReady(pSPIDevInfo, PHY_ON, 0);
 			// ---> Calibration finished, should be PHY_ON idle now
-			if ( adf7030_1__READ_FIELD(PROFILE_RADIO_CAL_CFG1_CAL_SUCCESS) )
+			// On failure (CAL_SUCCESS == 0), the previous results are kept
+			if ( !eRet && adf7030_1__READ_FIELD(PROFILE_RADIO_CAL_CFG1_CAL_SUCCESS) )
 			{
 				pDevice->eState |= ADF7030_1_STATE_CALIBRATED;
 
+				// not valid until fully read back
+				*(uint64_t*)(pInst->aRadioCal) = 0;
+				*(uint64_t*)(pInst->aVcoCal) = 0;
+
 				sBlock.WordXfer = 0;
 				// Get Radio Calibration result
 				sBlock.Addr = PROFILE_RADIO_CAL_RESULTS0_Addr;
-				sBlock.pData = &(RF_CFG[PHY_RADIO_CAL].cf[8]);
+				sBlock.pData = &(pInst->aRadioCal[8]);
 				sBlock.Size  = sizeof(radio_cal_results_t);
 				eRet = adf7030_1__ReadDataBlock( pSPIDevInfo, &(sBlock) );
 
 				// Get VCO Calibration result
 				sBlock.Addr = VCO_CAL_RESULTS_DATA0_Addr;
-				sBlock.pData = &(RF_CFG[PHY_VCO_CAL].cf[8]);
+				sBlock.pData = &(pInst->aVcoCal[8]);
 				sBlock.Size  = sizeof(vco_cal_results_t);
 				eRet |= adf7030_1__ReadDataBlock( pSPIDevInfo, &(sBlock) );
 
 				if(!eRet)
 				{
-					*(uint64_t*)(RF_CFG[PHY_RADIO_CAL].cf) = RADIO_CAL_HEADER_BE;
-					*(uint64_t*)(RF_CFG[PHY_VCO_CAL].cf) = VCO_CAL_HEADER_BE;
+					*(uint64_t*)(pInst->aRadioCal) = RADIO_CAL_HEADER_BE;
+					*(uint64_t*)(pInst->aVcoCal) = VCO_CAL_HEADER_BE;
 					eStatus = PHY_STATUS_OK;
 				}
 			}
-			// TODO : case when PROFILE_RADIO_CAL_CFG1_CAL_SUCCESS == 0
+	    }
+	    // Restore : the patch is only in program RAM, so the modulation
+	    // configuration is still there, just disable the calibration patch
+	    // and apply the (new) results. Channel frequency is set on each TX/RX.
+	    eRet = adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, PHY_OFF, PHY_OFF );
+	    eRet |= adf7030_1__SetupPatch(pSPIDevInfo, SM_DATA_CAL_DISABLE_key, 1);
+	    adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_RADIO_CAL_CFG0_Addr, u32CalCfg0);
+	    eRet |= adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, CFG_DEV, PHY_OFF );
+	    eRet |= adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, PHY_ON, PHY_ON );
+	    if (eRet)
+	    {
+	    	// Normal configuration will be fully restored on next READY
+	    	pDevice->bCfgDone = 0;
+	    	pDevice->eState &= ~ADF7030_1_STATE_READY;
 	    }
 	}
 	else {
@@ -691,445 +969,1883 @@ int32_t Phy_RssiCalibrate(phydev_t *pPhydev, int8_t i8RssiRefLevel)
     return eStatus;
 }
 
-
-/******************************************************************************/
-/******************************************************************************/
-#define PHY_PCK_TX_BUFF_BASE_OFFSET 0x2BC          // (x4) 0xAF0
-#define PHY_PCK_TX_BUFF_OFFSET (PHY_PCK_TX_BUFF_BASE_OFFSET + 0x04) // (x4) 0xB00
-#define PHY_PCK_TX_BUFF_ADDR PARAM_ADF7030_1_SRAM_BASE | ( PHY_PCK_TX_BUFF_OFFSET << 2 )
-
-// Internal private function
-static int32_t _ready_seq(phydev_t *pPhydev);
-static int32_t _sleep_seq(phydev_t *pPhydev);
-static int32_t _trx_seq(phydev_t *pPhydev);
-static int32_t _test_seq(phydev_t *pPhydev, test_modes_tx_e eTxMode);
-static int32_t _do_cmd(phydev_t *pPhydev, uint8_t eCmd);
-static void _frame_it(void *p_CbParam, void *p_Arg);
-
-
 /*!
- * @static
- * @brief  This function initialize the Phy device
+ * @brief  This function get (and remove) the oldest received frame record
  *
  * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [out] pFrame  Pointer on the frame record to fill
  *
  * @return      Status
  * - PHY_STATUS_OK     Function has been successfully executed
- * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
- * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ * - PHY_STATUS_ERROR  No frame available
  *
  */
-static int32_t _init(phydev_t *pPhydev)
+int32_t Phy_GetRxFrame(phydev_t *pPhydev, phy_rx_frame_t *pFrame)
 {
-    int32_t i32Ret = PHY_STATUS_ERROR;
-    uint8_t u8i;
-    adf7030_1_device_t* pDevice = pPhydev->pCxt;
-    adf7030_1_gpio_int_info_t *pIntGPIOInfo = pDevice->IntGPIOInfo;
-    if(pPhydev)
-    {
-		// private parameters
-    	pDevice->bCfgDone = 0;
-    	pDevice->bCrcOn = 0;
-    	pDevice->bTxPwrDone = 0;
-    	pDevice->u8PendTXBuffSize = 0;
-		if( !(adf7030_1_Init( pDevice, &spi_ADF7030 )) )
+	phy_inst_t *pInst;
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	phy_rx_frame_t *pRec;
+	if (pPhydev && pFrame)
+	{
+		pInst = PHY_INST(pPhydev);
+		if ( RX_RING_CNT(pInst) )
 		{
-			// set default parameters
-			pPhydev->i16TxFreqOffset = DEFAULT_TX_FREQ_OFFSET;
-			pPhydev->eModulation = DEFAULT_MOD;
-			pPhydev->eTxPower = DEFAULT_TX_POWER;
-			pPhydev->eChannel = DEFAULT_CH;
-			pPhydev->pfEvtCb = NULL;
-			pPhydev->pCbParam = NULL;
-			pPhydev->bPreSyncOn = 0;
-			pPhydev->bCrcOn = 0;
-
-			pPhydev->eTestMode = PHY_TST_MODE_NONE;
-
-			pDevice->CalCfg.RADIO_CAL_CFG0 = DEFAULT_CAL_CFG;
-			// FIXME : set the CAL headers
-			*(uint64_t*)(RF_CFG[PHY_RADIO_CAL].cf) = 0x0;
-			*(uint64_t*)(RF_CFG[PHY_VCO_CAL].cf) = 0x0;
-
-			pIntGPIOInfo[ADF7030_1_INTPIN0].pfIntCb = &_frame_it;
-			pIntGPIOInfo[ADF7030_1_INTPIN1].pfIntCb = NULL; //&_instrum_it;
+			pRec = &(pInst->sRxRing.aFrame[pInst->sRxRing.u8RdIdx & RX_RING_MSK]);
+			pFrame->u64Timestamp = pRec->u64Timestamp;
+			pFrame->u16Rssi = pRec->u16Rssi;
+			pFrame->u16Ferr = pRec->u16Ferr;
+			pFrame->u8Len = pRec->u8Len;
+			pFrame->bCrcOk = pRec->bCrcOk;
+			memcpy(pFrame->aPayload, pRec->aPayload, pRec->u8Len);
+			pInst->sRxRing.u8RdIdx++;
 			i32Ret = PHY_STATUS_OK;
-			for (u8i =0; u8i < 2; u8i++)
-			{
-				pIntGPIOInfo[u8i].pIntCbParam = (void*)pPhydev;
-				if (adf7030_1_HostGPIOIrq_Init( pDevice,
-							pIntGPIOInfo[u8i].u32Port,
-							pIntGPIOInfo[u8i].u16Pin,
-							GPIO_IRQ_RISING_EDGE,
-							pIntGPIOInfo[u8i].pfIntCb,
-							pIntGPIOInfo[u8i].pIntCbParam ) )
-				{
-					i32Ret = PHY_STATUS_ERROR;
-					break;
-				}
-			}
-			if (i32Ret != PHY_STATUS_ERROR) {
-				//i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
-				i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_PWR_ON);
-
-				adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN0, 0xFFFFFFFF);
-				adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN1, 0xFFFFFFFF);
-
-				adf7030_1__IRQ_GetMap(pDevice, ADF7030_1_INTPIN0);
-				adf7030_1__IRQ_GetMap(pDevice, ADF7030_1_INTPIN1);
-			}
 		}
-    }
-    return i32Ret;
+	}
+	return i32Ret;
 }
 
 /*!
- * @static
- * @brief  This function un-initialize the Phy device. (Power OFF and Reset released)
+ * @brief  This function get the number of pending received frame records
  *
  * @param [in]  pPhydev Pointer on the Phy device instance
  *
- * @return      Status
- * - PHY_STATUS_OK     Function has been successfully executed
- * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
- * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ * @return      The number of pending frame records
  *
  */
-static int32_t _uninit(phydev_t *pPhydev)
+uint8_t Phy_GetRxFrameNb(phydev_t *pPhydev)
 {
-    int32_t i32Ret = PHY_STATUS_ERROR;
-    adf7030_1_device_t* pDevice = pPhydev->pCxt;
-    uint8_t u8i;
-    if(pPhydev)
-    {
-		 /* Clear and disable adf7030 interrupt */
-		for (u8i = 0; u8i < ADF7030_1_NUM_INT_PIN; u8i++)
-		{
-			i32Ret |= adf7030_1_SetupInt( pDevice, u8i, 0);
-		}
-		if (!i32Ret) {
-			i32Ret = adf7030_1_UnInit( pPhydev->pCxt );
-		}
-
-		// Power off the PHY
-		i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_PWR_OFF);
-		// Release the Reset pin
-		BSP_Gpio_SetLow(pDevice->ResetGPIOInfo.u32Port, pDevice->ResetGPIOInfo.u16Pin);
-
-		if (!i32Ret) {
-			pDevice->bCfgDone = 0;
-			pDevice->bCrcOn = 0;
-			pDevice->bTxPwrDone = 0;
-			pDevice->u8PendTXBuffSize = 0;
-		}
-    }
-    return i32Ret;
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	return RX_RING_CNT(pInst);
 }
 
-/******************************************************************************/
-/******************************************************************************/
 /*!
- * @static
- * @brief  This function implement the ready sequence
+ * @brief  This function get the number of received frames lost because the ring was full
  *
  * @param [in]  pPhydev Pointer on the Phy device instance
  *
- * @return      Status
- * - PHY_STATUS_OK     Requested sequence has been successfully executed
- * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
- * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ * @return      The number of lost frames
  *
  */
-static int32_t _ready_seq(phydev_t *pPhydev)
+uint32_t Phy_GetRxOverflowNb(phydev_t *pPhydev)
 {
-	int32_t eStatus = PHY_STATUS_OK;
-	uint8_t eRet = 0;
-    adf7030_1_device_t* pDevice = pPhydev->pCxt;
-    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	return pInst->sRxRing.u32Overflow;
+}
+
+/*!
+ * @brief  This function set the address filter of the received frames
+ *
+ * Frames whose M-field and A-field don't match the given address (received 0xF
+ * nibbles are wildcards, so broadcast frames pass) are dropped on RX complete : only their header is read, they don't go into the ring and
+ * no event is notified. The RX goes on as if nothing was received.
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pAddr   Pointer on the address (M-field then A-field), NULL to disable the filter
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested command has been successfully executed
+ * - PHY_STATUS_ERROR  Invalid parameter
+ *
+ */
+int32_t Phy_SetAddrFilt(phydev_t *pPhydev, const uint8_t *pAddr)
+{
+	phy_inst_t *pInst;
+	if (pPhydev == NULL)
+	{
+		return PHY_STATUS_ERROR;
+	}
+	pInst = PHY_INST(pPhydev);
+	// disabled while updating, so the RX complete never see a partial address
+	pInst->sAddrFilt.bEnable = 0;
+	if (pAddr)
+	{
+		memcpy(pInst->sAddrFilt.aAddr, pAddr, PHY_ADDR_FILT_SZ);
+		pInst->sAddrFilt.bEnable = 1;
+	}
+	return PHY_STATUS_OK;
+}
+
+/*!
+ * @brief  This function get the address filter of the received frames
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [out] pAddr   Pointer on the address (M-field then A-field) to fill, if enabled (can be NULL)
+ *
+ * @return      1 if the filter is enabled, 0 otherwise
+ *
+ */
+uint8_t Phy_GetAddrFilt(phydev_t *pPhydev, uint8_t *pAddr)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	if (!pInst->sAddrFilt.bEnable)
+	{
+		return 0;
+	}
+	if (pAddr)
+	{
+		memcpy(pAddr, pInst->sAddrFilt.aAddr, PHY_ADDR_FILT_SZ);
+	}
+	return 1;
+}
+
+/*!
+ * @brief  This function get the number of received frames dropped by the address filter
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      The number of dropped frames
+ *
+ */
+uint32_t Phy_GetAddrFiltNb(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	return pInst->sAddrFilt.u32Filtered;
+}
+
+/*!
+ * @brief  This function enable/disable the radio CRC offload
+ *
+ * The radio packet handler computes the CRC on TX and checks it on RX, with the
+ * EN13757-4 CRC16 (polynomial, seed and final xor are set in the base CFG file).
+ * Frames keep their CRC field, so the upper layer is unchanged :
+ * - on TX, the radio sends its own CRC in place of the given one (not uploaded),
+ * - on RX, frames with a bad CRC are dropped before being read, the others are
+ *   flagged as verified (see Phy_GetRxCrcOk).
+ * WM6400 is sent in raw mode, so the CRC stays in software for this modulation.
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  bEnable 1 : enable, 0 : disable
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested command has been successfully executed
+ * - PHY_STATUS_ERROR  Invalid parameter
+ *
+ */
+int32_t Phy_SetCrcOffload(phydev_t *pPhydev, uint8_t bEnable)
+{
+	phy_inst_t *pInst;
+	if (pPhydev == NULL)
+	{
+		return PHY_STATUS_ERROR;
+	}
+	pInst = PHY_INST(pPhydev);
+	// applied on the next TX/RX
+	pInst->sCrcOfl.bEnable = (bEnable)?(1):(0);
+	return PHY_STATUS_OK;
+}
+
+/*!
+ * @brief  This function tell if the radio CRC offload is enabled
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      1 if enabled, 0 otherwise
+ *
+ */
+uint8_t Phy_GetCrcOffload(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	return pInst->sCrcOfl.bEnable;
+}
+
+/*!
+ * @brief  This function tell if the CRC of the last received frame has been verified by the radio
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      1 if verified (so the software check can be skipped), 0 otherwise
+ *
+ */
+uint8_t Phy_GetRxCrcOk(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	return pInst->sCrcOfl.bLastOk;
+}
+
+/*!
+ * @brief  This function get the number of received frames dropped on bad CRC
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      The number of dropped frames
+ *
+ */
+uint32_t Phy_GetCrcErrNb(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	return pInst->sCrcOfl.u32Errors;
+}
+
+/*!
+ * @brief  This function tell if the radio is in use
+ *
+ * The radio is in use while transmitting, receiving (sniff included) or
+ * measuring the noise, and while a scheduled transmission or a scan is pending.
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      1 if in use, 0 otherwise
+ *
+ */
+uint8_t Phy_IsBusy(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	adf7030_1_device_t *pDevice = pPhydev->pCxt;
+	return ( (pDevice->eState & ADF7030_1_STATE_BUSY) || pDevice->bSniffOn
+		|| pInst->sTxAt.bArmed || pInst->sScan.bOn )?(1):(0);
+}
+
+/*!
+ * @brief  This function get the last wake-up (from sleep) to ready time
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      The wake-up time in µs
+ *
+ */
+uint32_t Phy_GetWakeUpTime(phydev_t *pPhydev)
+{
+	uint32_t u32Time = 0;
+	if (pPhydev)
+	{
+		u32Time = ((adf7030_1_device_t*)pPhydev->pCxt)->u32WakeUpTime;
+	}
+	return u32Time;
+}
+
+/*!
+ * @brief  This function get the last power-on (or reset) sequence time
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      The power-on time in µs
+ *
+ */
+uint32_t Phy_GetPwrOnTime(phydev_t *pPhydev)
+{
+	uint32_t u32Time = 0;
+	if (pPhydev)
+	{
+		u32Time = ((adf7030_1_device_t*)pPhydev->pCxt)->u32PwrOnTime;
+	}
+	return u32Time;
+}
+
+/*!
+ * @brief  This function get the last noise measurement details
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [out] pMeas   Pointer on the noise measurement to fill
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Function has been successfully executed
+ * - PHY_STATUS_ERROR  No valid measurement available
+ *
+ */
+int32_t Phy_GetNoiseMeas(phydev_t *pPhydev, noise_meas_t *pMeas)
+{
+	phy_inst_t *pInst;
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	if (pPhydev && pMeas)
+	{
+		pInst = PHY_INST(pPhydev);
+		*pMeas = pInst->sNoiseMeas;
+		if (pInst->sNoiseMeas.u16NbMeas)
+		{
+			i32Ret = PHY_STATUS_OK;
+		}
+	}
+	return i32Ret;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+#define PHY_PCK_TX_BUFF_BASE_OFFSET 0x2BC          // (x4) 0xAF0
+#define PHY_PCK_TX_BUFF_OFFSET (PHY_PCK_TX_BUFF_BASE_OFFSET + 0x04) // (x4) 0xB00
+#define PHY_PCK_TX_BUFF_ADDR PARAM_ADF7030_1_SRAM_BASE | ( PHY_PCK_TX_BUFF_OFFSET << 2 )
+#define PHY_PCK_RX_BUFF_OFFSET 0x33C               // (x4) 0xCF0
+
+// WM6400 (raw mode) : the preamble and sync. word are staged once in front of the TX buffer
+#define PHY_PCK_TX_PREFIX_ADDR PARAM_ADF7030_1_SRAM_BASE | ( PHY_PCK_TX_BUFF_BASE_OFFSET << 2 )
+#define PHY_WM6400_PREFIX_SZ ( (PHY_WM6400_PREAMBLE_SIZE/8) + (PHY_WM6400_SYNC_WORD_SIZE/8) )
+#if ( ( (PHY_PCK_TX_BUFF_OFFSET - PHY_PCK_TX_BUFF_BASE_OFFSET) << 2 ) != PHY_WM6400_PREFIX_SZ )
+#error "The WM6400 preamble and sync. word must end on the TX buffer"
+#endif
+
+// The TX buffer is split in two slots, so the next frame can be uploaded while the current one is on air
+#define PHY_PCK_TX_SLOT_SZ_W ( (PHY_PCK_RX_BUFF_OFFSET - PHY_PCK_TX_BUFF_OFFSET) >> 1 ) // (x4) 0xF8
+#define PHY_PCK_TX_SLOT_SZ ( PHY_PCK_TX_SLOT_SZ_W << 2 )
+#define PHY_PCK_TX_SLOT_OFFSET(slot) ( PHY_PCK_TX_BUFF_OFFSET + ((slot) & 0x1) * PHY_PCK_TX_SLOT_SZ_W )
+#define PHY_PCK_TX_SLOT_ADDR(slot) ( PARAM_ADF7030_1_SRAM_BASE | ( PHY_PCK_TX_SLOT_OFFSET(slot) << 2 ) )
+
+// Internal private function
+static int32_t _ready_seq(phydev_t *pPhydev);
+static int32_t _sleep_seq(phydev_t *pPhydev);
+static int32_t _trx_seq(phydev_t *pPhydev);
+static int32_t _test_seq(phydev_t *pPhydev, test_modes_tx_e eTxMode);
+static int32_t _do_cmd(phydev_t *pPhydev, uint8_t eCmd);
+static void _frame_it(void *p_CbParam, void *p_Arg);
+static uint8_t _rx_drain(phydev_t *pPhydev);
+static void _rx_rearm_cancel(phydev_t *pPhydev);
+static void _tx_prepare(phydev_t *pPhydev, uint8_t u8Slot, uint8_t u8Len);
+static void _it_mask(phydev_t *pPhydev, uint8_t bMask);
+static uint8_t _crc_ofl(phydev_t *pPhydev);
+static uint8_t _tx_prefix_stage(phydev_t *pPhydev);
+static uint8_t _tx_prefix_chk(phydev_t *pPhydev);
+static uint8_t _sniff_exit(phydev_t *pPhydev);
+static void _txat_fire(void);
+static void _txat_disarm(phydev_t *pPhydev);
+static uint32_t _txat_to_us(const txat_t *pTxAt, uint32_t u32Cnt);
+static void _scan_hop(void);
+static void _scan_stop(phydev_t *pPhydev);
+static uint32_t _cfg_hash(const uint8_t *pCfg, uint32_t u32Size);
+
+
+/*!
+ * @static
+ * @brief  This function initialize the Phy device
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Function has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+static int32_t _init(phydev_t *pPhydev)
+{
+    phy_inst_t *pInst = PHY_INST(pPhydev);
+    int32_t i32Ret = PHY_STATUS_ERROR;
+    uint8_t u8i;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    adf7030_1_gpio_int_info_t *pIntGPIOInfo = pDevice->IntGPIOInfo;
+    if(pPhydev)
+    {
+		// private parameters
+    	pDevice->bCfgDone = 0;
+    	pDevice->bCrcOn = 0;
+    	pDevice->bTxPwrDone = 0;
+    	pDevice->u8PendTXBuffSize = 0;
+    	pDevice->u8StagedTXBuffSize = 0;
+    	pDevice->u8OnAirTXBuffSize = 0;
+    	pDevice->u8TxSlot = 0;
+    	pDevice->bTxChained = 0;
+    	pDevice->bRetained = 0;
+    	pDevice->bCalResident = 0;
+    	pDevice->bSniffOn = 0;
+    	pDevice->bTxPrefixOn = 0;
+    	pDevice->u32WakeUpTime = 0;
+    	pDevice->u32PwrOnTime = 0;
+    	// The memory map pointers depend on the radio firmware and base configuration
+    	pInst->u32PntrCacheKey = _cfg_hash(RF_CFG[PHY_BASE_CFG].cf, RF_CFG[PHY_BASE_CFG].size);
+    	pInst->sRxRing.u8WrIdx = 0;
+    	pInst->sRxRing.u8RdIdx = 0;
+    	pInst->sRxRing.bRearmed = 0;
+		if( !(adf7030_1_Init( pDevice, pInst->pSpiDev )) )
+		{
+			// set default parameters
+			pPhydev->i16TxFreqOffset = DEFAULT_TX_FREQ_OFFSET;
+			pPhydev->eModulation = DEFAULT_MOD;
+			pPhydev->eTxPower = DEFAULT_TX_POWER;
+			pPhydev->eChannel = DEFAULT_CH;
+			pPhydev->pfEvtCb = NULL;
+			pPhydev->pCbParam = NULL;
+			pPhydev->bPreSyncOn = 0;
+			pPhydev->bCrcOn = 0;
+
+			pPhydev->eTestMode = PHY_TST_MODE_NONE;
+
+			pDevice->CalCfg.RADIO_CAL_CFG0 = DEFAULT_CAL_CFG;
+			// FIXME : set the CAL headers
+			*(uint64_t*)(pInst->aRadioCal) = 0x0;
+			*(uint64_t*)(pInst->aVcoCal) = 0x0;
+
+			pIntGPIOInfo[ADF7030_1_INTPIN0].pfIntCb = &_frame_it;
+			pIntGPIOInfo[ADF7030_1_INTPIN1].pfIntCb = NULL; //&_instrum_it;
+			i32Ret = PHY_STATUS_OK;
+			for (u8i =0; u8i < 2; u8i++)
+			{
+				pIntGPIOInfo[u8i].pIntCbParam = (void*)pPhydev;
+				if (adf7030_1_HostGPIOIrq_Init( pDevice,
+							pIntGPIOInfo[u8i].u32Port,
+							pIntGPIOInfo[u8i].u16Pin,
+							GPIO_IRQ_RISING_EDGE,
+							pIntGPIOInfo[u8i].pfIntCb,
+							pIntGPIOInfo[u8i].pIntCbParam ) )
+				{
+					i32Ret = PHY_STATUS_ERROR;
+					break;
+				}
+			}
+			if (i32Ret != PHY_STATUS_ERROR) {
+				//i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+				i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_PWR_ON);
+
+				adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN0, 0xFFFFFFFF);
+				adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN1, 0xFFFFFFFF);
+
+				adf7030_1__IRQ_GetMap(pDevice, ADF7030_1_INTPIN0);
+				adf7030_1__IRQ_GetMap(pDevice, ADF7030_1_INTPIN1);
+			}
+		}
+    }
+    return i32Ret;
+}
+
+/*!
+ * @static
+ * @brief  This function un-initialize the Phy device. (Power OFF and Reset released)
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Function has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+static int32_t _uninit(phydev_t *pPhydev)
+{
+    int32_t i32Ret = PHY_STATUS_ERROR;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    uint8_t u8i;
+    if(pPhydev)
+    {
+		 /* Clear and disable adf7030 interrupt */
+		for (u8i = 0; u8i < ADF7030_1_NUM_INT_PIN; u8i++)
+		{
+			i32Ret |= adf7030_1_SetupInt( pDevice, u8i, 0);
+		}
+		if (!i32Ret) {
+			i32Ret = adf7030_1_UnInit( pPhydev->pCxt );
+		}
+
+		// Power off the PHY
+		i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_PWR_OFF);
+		// Release the Reset pin
+		BSP_Gpio_SetLow(pDevice->ResetGPIOInfo.u32Port, pDevice->ResetGPIOInfo.u16Pin);
+
+		if (!i32Ret) {
+			pDevice->bCfgDone = 0;
+			pDevice->bCrcOn = 0;
+			pDevice->bTxPwrDone = 0;
+			pDevice->u8PendTXBuffSize = 0;
+		}
+    }
+    return i32Ret;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/*!
+ * @static
+ * @brief  This function implement the ready sequence
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+static int32_t _ready_seq(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	int32_t eStatus = PHY_STATUS_OK;
+	uint8_t eRet = 0;
+	uint8_t bWakeUp = 0;
+	uint32_t u32Start = 0;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+
+	pInst->sRxRing.bRearmed = 0;
+	// abort the current TX, if any, so drop the staged one
+	pDevice->u8StagedTXBuffSize = 0;
+	pDevice->bTxChained = 0;
+	pDevice->eState &= ~ADF7030_1_STATE_READY;
+	pDevice->eState &= ~(ADF7030_1_STATE_BUSY);
+	switch (pSPIDevInfo->nPhyState)
+	{
+		// abort the current state, if required
+		case PHY_TX:
+		case PHY_RX:
+			// abort --> EOF interrupt
+			// So: disable interrupt
+			eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)0x0);
+		case CCA:
+		case DO_CAL:
+		case MON:
+			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
+			if(eRet)
+			{
+				break;
+			}
+		// still in ready state
+		case PHY_ON:
+			// does it need full configuration ?
+			if ( pDevice->bCfgDone == 0 )
+			{
+				// yes, switch to PHY_OFF state
+				eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_OFF, PHY_OFF);
+			}
+			break;
+		case PHY_OFF:
+		case CFG_DEV :
+			break;
+		default: // unexpected state
+			break;
+	}
+
+	switch (pSPIDevInfo->nPhyState)
+	{
+		case PHY_SLEEP:
+			bWakeUp = 1;
+			u32Start = cycles();
+			// will wake-up, so need to CFG_DEV
+			pDevice->eState &= ~ADF7030_1_STATE_CONFIGURED;
+			// Wake up
+			eRet |= adf7030_1_PulseWakup(pDevice);
+			if ( !pDevice->bRetained )
+			{
+				// reinitialize the PNTR pointers
+				eRet |= adf7030_1__SPI_RestoreMMapPointers(pSPIDevInfo, pInst->u32PntrCacheKey);
+			}
+			// switch to PHY_OFF
+			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_OFF, PHY_OFF);
+			if ( !pDevice->bRetained )
+			{
+				//eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_BASE_CFG].cf, RF_CFG[PHY_BASE_CFG].size);
+				eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_HIDDEN].cf, RF_CFG[PHY_HIDDEN].size);
+				// SRAM is lost
+				pDevice->bCalResident = 0;
+				pDevice->bTxPrefixOn = 0;
+			}
+			// SRAM content is used (or lost), retention is not relevant anymore
+			pDevice->bRetained = 0;
+			if(eRet)
+			{
+				break;
+			}
+		case PHY_OFF:
+			// Does it need a full configuration ?
+			if ( pDevice->bCfgDone == 0 )
+			{
+				// Yes, load the configuration file
+				eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[pPhydev->eModulation].cf, RF_CFG[pPhydev->eModulation].size);
+				if (!eRet)
+				{
+					pDevice->eState &= ~ADF7030_1_STATE_CONFIGURED;
+				}
+
+				// Check if calibration data are set or not
+				if (*(uint64_t*)(pInst->aRadioCal) != 0x0 )
+				{
+					// send calibration RADIO and VCO
+					if ( !(adf7030_1__SendConfiguration( pSPIDevInfo, pInst->aRadioCal, RADIO_CAL_SZ)) )
+					{
+						if ( !(adf7030_1__SendConfiguration( pSPIDevInfo, pInst->aVcoCal, VCO_CAL_SZ)) )
+						{
+							pDevice->eState |= ADF7030_1_STATE_CALIBRATED;
+						}
+					}
+				}
+				//else { /* Default radio calibration are send with base_cfg*/ }
+			}
+			// Does it need a CFG_DEV state, case of : full configuration or from wake-up
+			if ( !(pDevice->eState & ADF7030_1_STATE_CONFIGURED) )
+			{
+				// yes, switch to CFG_DEV, then PHY_OFF (automatic goes back)
+				eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, CFG_DEV, PHY_OFF);
+				if (!eRet)
+				{
+					pDevice->bCfgDone = 1;
+					pDevice->eState |= ADF7030_1_STATE_CONFIGURED;
+				}
+			}
+			// switch to PHY_ON, ...it is ready
+			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
+		case PHY_ON : // CFG_DEV or PHY_ON without requiring full configuration
+		case CFG_DEV :
+			break;
+		default: // unexpected state
+			eRet = 1;
+			break;
+	}
+
+	// WM6400 : stage the preamble and sync. word, if not already in packet RAM
+	if ( !eRet && (pPhydev->eModulation == PHY_WM6400) && !(pDevice->bTxPrefixOn) )
+	{
+		eRet |= _tx_prefix_stage(pPhydev);
+	}
+
+	if(!eRet)
+	{
+		pDevice->eState |= ADF7030_1_STATE_READY;
+		if (bWakeUp)
+		{
+			pDevice->u32WakeUpTime = cycles_to_us(cycles() - u32Start);
+		}
+	}
+	else
+	{
+		// enable to communicate with the PHY
+		eStatus = PHY_STATUS_ERROR;
+		/* Notice that, at this point :
+		 *  - pDevice->eState has ADF7030_1_STATE_READY not set
+		 *  - pDevice->eState could has ADF7030_1_STATE_CONFIGURED not set
+		 *  - pDevice->bCfgDone could be 0
+		 */
+	}
+	return eStatus;
+}
+
+/*!
+ * @static
+ * @brief  This function implement the sleep sequence
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+static int32_t _sleep_seq(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	int32_t eStatus = PHY_STATUS_OK;
+	uint8_t eRet = 0;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+
+    pInst->sRxRing.bRearmed = 0;
+    pDevice->u8StagedTXBuffSize = 0;
+    pDevice->bTxChained = 0;
+    eRet = adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)0x0);
+	switch (pSPIDevInfo->nPhyState)
+	{
+		// stop the current state, if required
+		case PHY_TX:
+		case PHY_RX:
+		case CCA:
+		case DO_CAL:
+		case MON:
+			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
+		case PHY_OFF:
+		case PHY_ON:
+			// of course, not ready anymore
+			pDevice->eState &= ~ADF7030_1_STATE_READY;
+			// nor configured
+			pDevice->eState &= ~ADF7030_1_STATE_CONFIGURED;
+#if PHY_USE_RETENTION
+			// Keep the SRAM (configuration and calibration) while sleeping
+			eRet |= adf7030_1__SetupLPM(pSPIDevInfo, 1);
+#endif
+			pSPIDevInfo->nPhyNextState = PHY_SLEEP;
+			eRet |= adf7030_1__STATE_PhyCMD( pSPIDevInfo, pSPIDevInfo->nPhyNextState );
+			if (!eRet)
+			{
+				pSPIDevInfo->nPhyState = PHY_SLEEP;
+#if PHY_USE_RETENTION
+				pDevice->bRetained = pDevice->bCfgDone;
+#endif
+			}
+		default:
+			break;
+	}
+	if(eRet)
+	{
+		eStatus = PHY_STATUS_ERROR;
+	}
+	return eStatus;
+}
+
+/*!
+ * @static
+ * @brief  This function implement the transmission/reception sequence
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+static int32_t _trx_seq(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	int32_t eStatus = PHY_STATUS_OK;
+	uint8_t eRet = 0;
+	uint8_t u8CrcOn;
+	uint32_t u32IrqMap;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+	// It must be set to READY before
+	if(pDevice->eState & ADF7030_1_STATE_READY)
+	{
+		if( ! (pDevice->eState & ADF7030_1_STATE_BUSY) )
+		{
+			// Need to update CRC ?
+			u8CrcOn = (pPhydev->bCrcOn || _crc_ofl(pPhydev))?(1):(0);
+			if ( pDevice->bCrcOn != u8CrcOn )
+			{
+				// Configure CRC
+				frame_cfg0_t frame_cfg0;
+				frame_cfg0 = (frame_cfg0_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, GENERIC_PKT_FRAME_CFG0_Addr));
+				frame_cfg0.FRAME_CFG0_b.CRC_LEN = u8CrcOn*16;
+				adf7030_1__SPI_SetMem32(pSPIDevInfo, GENERIC_PKT_FRAME_CFG0_Addr, frame_cfg0.FRAME_CFG0);
+				pDevice->bCrcOn = u8CrcOn;
+			}
+
+			// Need to update TX Power ?
+			if ( !(pDevice->bTxPwrDone) )
+			{
+				// Change TX Power
+				// PA_Coarse in {1 to 6}
+				// PA_Fine in {0, 3 to 127}
+				// PA_Micro in {1 to 31}
+				radio_dig_tx_cfg0_t tx_cfg0;
+				tx_cfg0 = (radio_dig_tx_cfg0_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG0_Addr));
+				// Setup PA1 power
+				tx_cfg0.RADIO_DIG_TX_CFG0_b.PA_COARSE = aPhyPower[pPhydev->eTxPower].coarse;
+				tx_cfg0.RADIO_DIG_TX_CFG0_b.PA_FINE = aPhyPower[pPhydev->eTxPower].fine;
+				tx_cfg0.RADIO_DIG_TX_CFG0_b.PA_MICRO = aPhyPower[pPhydev->eTxPower].micro;
+				adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG0_Addr, tx_cfg0.RADIO_DIG_TX_CFG0);
+				// Change TX power ramp
+#ifdef PHY_USE_POWER_RAMP
+				radio_dig_tx_cfg1_t tx_cfg1;
+				tx_cfg1 = (radio_dig_tx_cfg1_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG1_Addr));
+				tx_cfg1.RADIO_DIG_TX_CFG1_b.PA_RAMP_RATE = pa_ramp_rate;
+				adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG1_Addr, tx_cfg1.RADIO_DIG_TX_CFG1);
+#endif
+				pDevice->bTxPwrDone = 1;
+			}
+
+			// Change frequency
+			uint32_t u32_Freq = PHY_FREQUENCY_CH(pPhydev->eChannel);
+			// only for TX
+			u32_Freq += pPhydev->i16TxFreqOffset;
+			adf7030_1__SPI_SetMem32( pSPIDevInfo, PROFILE_CH_FREQ_Addr, u32_Freq);
+
+			// Enable / Disable interrupt
+			if (pPhydev->eTestMode == PHY_TST_MODE_NONE)
+			{
+				// The radio CRC check result is required on RX
+				u32IrqMap = (pDevice->bCrcOn)?(CRC_CHK_IRQn_Msk):(0);
+				pInst->sCrcOfl.bChk = 0;
+				// The preamble detection lock the scan on the channel
+				if ( pInst->sScan.u8ChMsk )
+				{
+					u32IrqMap |= PREAMBLE_IRQn_Msk;
+				}
+				// Need to update interrupt on PREMBLE and SYNC ?
+				if(pPhydev->bPreSyncOn)
+				{
+					// if not set
+					//if( !(pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntMap & (PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk)) )
+					{
+						eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)(PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk | EOF_IRQn_Msk) | u32IrqMap);
+						eRet |= adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN0, 0xFFFFFFFF);
+					}
+					// else, already set
+				}
+				else {
+					// if set
+					//if( (pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntMap & (PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk)) )
+					{
+						eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)EOF_IRQn_Msk | u32IrqMap);
+						eRet |= adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN0, 0xFFFFFFFF);
+					}
+					// else, already unset
+				}
+			}
+			else
+			{
+				// disable interrupt
+				eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)0x0);
+			}
+#ifdef PHY_DEBUG_SPE
+			eRet = adf7030_1__ReadDataBlock(pSPIDevInfo, &(sConfig.BLOCKS[0]));
+			eRet = adf7030_1__ReadDataBlock(pSPIDevInfo, &(sConfig.BLOCKS[1]));
+#endif
+			if(eRet)
+			{
+				eStatus = PHY_STATUS_ERROR;
+			}
+		}
+		else {
+			eStatus = PHY_STATUS_BUSY;
+		}
+	}
+	else {
+		eStatus = PHY_STATUS_ERROR;
+		pSPIDevInfo->eXferResult = ADF7030_1_INVALID_OPERATION;
+	}
+	return eStatus;
+}
+
+/*!
+ * @brief  This function change the PHY to test mode
+ *
+ * @param [in]  pPhydev       Pointer on the Phy device instance
+ * @param [in]  eTxMode       TX test mode (see @link test_modes_tx_e @endlink)
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Requested command has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+static int32_t _test_seq(phydev_t *pPhydev, test_modes_tx_e eTxMode)
+{
+    int32_t eStatus = PHY_STATUS_ERROR;
+	uint8_t eRet = 0;
+	phy_ctl_e eCmd;
+
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+
+	// TX power reconfiguration
+	pDevice->bTxPwrDone = 0;
+	// full reconfiguration
+	pDevice->bCfgDone = 0;
+
+    // Set to ready
+    eStatus = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+
+	// It must be set to READY before
+	if(eStatus == PHY_STATUS_OK )
+	{
+		test_modes1_t test_modes1;
+		test_modes0_t test_modes0;
+		test_modes0 = (test_modes0_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, GENERIC_PKT_TEST_MODES0_Addr));
+	    //
+		if (pPhydev->eTestMode == PHY_TST_MODE_NONE)
+		{
+			eCmd = PHY_CTL_CMD_READY;
+			// Unset test mode
+			test_modes0.TEST_MODES0_b.PER_EN = 0;
+			test_modes0.TEST_MODES0_b.PER_IRQ_SELF_CLEAR = 0;
+			test_modes0.TEST_MODES0_b.TX_TEST = 0;
+			pDevice->bTxPwrDone = 0;
+			pDevice->bCfgDone = 0;
+		}
+		else
+		{
+			// Set to test mode
+			test_modes0.TEST_MODES0_b.PER_EN = 1;
+			test_modes0.TEST_MODES0_b.PER_IRQ_SELF_CLEAR = 1;
+
+			if (pPhydev->eTestMode < PHY_TST_MODE_TX )
+			{
+				// RX test mode
+				eCmd = PHY_CMD_RX;
+				test_modes1.TEST_MODES1_b.PACKET_CNT = 100;
+				test_modes1.TEST_MODES1_b.CURRENT_CNT = 0;
+				adf7030_1__SPI_SetMem32(pSPIDevInfo, GENERIC_PKT_TEST_MODES1_Addr, test_modes1.TEST_MODES1);
+
+				if (pPhydev->eTestMode == PHY_TST_MODE_PER_RX)
+				{
+					eCmd = PHY_CMD_CCA;
+					// Disable AFC
+					config_t afc_config;
+					afc_config = (config_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, AFC_CONFIG_Addr));
+					afc_config.CONFIG_b.MODE = 0;
+					adf7030_1__SPI_SetMem32(pSPIDevInfo, AFC_CONFIG_Addr, afc_config.CONFIG);
+
+					// Set TICK_RATE to 1 and DETECTION_TIME to 0
+					cca_cfg_t cca_cfg;
+					cca_cfg = (cca_cfg_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_CCA_CFG_Addr));
+					cca_cfg.CCA_CFG_b.TICK_RATE = 1;
+					cca_cfg.CCA_CFG_b.DETECTION_TIME = 0;
+					adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_CCA_CFG_Addr, cca_cfg.CCA_CFG);
+				}
+			}
+			else
+			{
+				// TX test mode
+				eCmd = PHY_CMD_TX;
+				// check if require deviation of +/- 2 fdev
+				if (eTxMode == TMODE_TX_FDEV_MAXNEG || eTxMode == TMODE_TX_FDEV_MAXPOS)
+				{
+					radio_modes_t radio_modes;
+					radio_modes = (radio_modes_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_RADIO_MODES_Addr));
+					// check if current modulation is 4FSK (required for +/- 2fdev test
+					if (radio_modes.RADIO_MODES_b.TX_MOD_TYPE != MOD_4FSK)
+					{
+						eTxMode--;
+					}
+				}
+				test_modes0.TEST_MODES0_b.TX_TEST = eTxMode;
+			}
+		}
+		adf7030_1__SPI_SetMem32(pSPIDevInfo, GENERIC_PKT_TEST_MODES0_Addr, test_modes0.TEST_MODES0);
+		eStatus = _do_cmd(pPhydev, eCmd);
+	}
+    return eStatus;
+}
+
+/*!
+ * @brief  This is the main FSM.
+ *
+ * @details This function ensure that transition between state are respected.
+ * ... :
+ * - Wake-up, (re)configuration,
+ *
+ * @param [in] pPhydev    Pointer on the Phy device instance
+ * @param [in] eCmd       Requested command to execute
+ *
+ * @return             Status
+ * - PHY_STATUS_OK     Requested command has been successfully executed
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ */
+static int32_t _do_cmd(phydev_t *pPhydev, uint8_t eCmd)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	int32_t eStatus = PHY_STATUS_OK;
+	uint8_t eRet = 0;
+	uint8_t u8Id;
+	uint32_t u32Start;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+
+	// Leave the multi-channel listen, so the timer doesn't retune behind this command
+	if ( pInst->sScan.bOn )
+	{
+		_scan_stop(pPhydev);
+	}
+
+	if ( eCmd < PHY_CTL_CMD_READY)
+	{
+		// Power supply command
+		pDevice->eState &= ADF7030_1_STATE_OPENED; // clear all except OPEN
+        pSPIDevInfo->eXferResult = ADF7030_1_SUCCESS;
+        pSPIDevInfo->nStatus.VALUE = 0;
+        pSPIDevInfo->nPhyState = PHY_SLEEP;
+        pSPIDevInfo->nPhyNextState = PHY_SLEEP;
+
+		pPhydev->bCrcOn = 0;
+		pPhydev->bPreSyncOn = 0;
+
+		pDevice->bCfgDone = 0;
+		pDevice->bCrcOn = 0;
+		pDevice->bTxPwrDone = 0;
+		pDevice->u8PendTXBuffSize = 0;
+		pDevice->u8StagedTXBuffSize = 0;
+		pDevice->u8OnAirTXBuffSize = 0;
+		pDevice->u8TxSlot = 0;
+		pDevice->bTxChained = 0;
+		pDevice->bRetained = 0;
+		pDevice->bSniffOn = 0;
+		pDevice->bTxPrefixOn = 0;
+
+		pPhydev->u16_Noise = 0;
+		pPhydev->u16_Rssi  = 0;
+		pPhydev->u16_Ferr  = 0;
+		pPhydev->eTestMode = PHY_TST_MODE_NONE;
+
+		pInst->sRxRing.u8WrIdx = 0;
+		pInst->sRxRing.u8RdIdx = 0;
+		pInst->sRxRing.bRearmed = 0;
+
+		if (pInst->sTxAt.bArmed)
+		{
+			BSP_LpTimer_Stop(PHY_TXAT_LPTIM_ID);
+			pInst->sTxAt.bArmed = 0;
+		}
+		// the trigger pin setup doesn't survive, so the timer is free
+		pInst->sTxAt.bTrigOn = 0;
+		if (pTimInst == pInst)
+		{
+			pTimInst = NULL;
+		}
+
+		switch(eCmd)
+		{
+			case PHY_CTL_CMD_PWR_OFF:
+				pInst->bPwrOn = 0;
+				// SRAM is lost (a reset keeps it, Phy_AutoCalibrate checks it)
+				pDevice->bCalResident = 0;
+				// the power line is shared, keep it while another radio is on
+				for (u8Id = 0; u8Id < PHY_NB_INST; u8Id++)
+				{
+					if (aPhyInst[u8Id].bPwrOn) { break; }
+				}
+				if (u8Id == PHY_NB_INST)
+				{
+					BSP_PwrLine_Clr(RF_EN_MSK);
+				}
+				break;
+			case PHY_CTL_CMD_PWR_ON:
+				pInst->bPwrOn = 1;
+				pDevice->bCalResident = 0;
+				// sleep for x µS or mS
+				BSP_PwrLine_Set(RF_EN_MSK);
+				// TODO : add micro-sleep to ensure power "propagating"
+			case PHY_CTL_CMD_RESET:
+			default:
+				u32Start = cycles();
+				adf7030_1_PulseReset(pDevice);
+				eRet |= adf7030_1__SPI_RestoreMMapPointers(pSPIDevInfo, pInst->u32PntrCacheKey);
+				eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_BASE_CFG].cf, RF_CFG[PHY_BASE_CFG].size);
+				eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, CFG_DEV, PHY_OFF);
+				if (eRet)
+				{
+					// don't trust the cache anymore
+					adf7030_1__SPI_InvalidMMapPointers(pSPIDevInfo);
+					eStatus = PHY_STATUS_ERROR;
+				}
+				else
+				{
+					pDevice->eState |= ADF7030_1_STATE_INITIALIZED;
+					pDevice->u32PwrOnTime = cycles_to_us(cycles() - u32Start);
+				}
+				break;
+		}
+	}
+    else
+    {
+    	// It must be Opened and Initialized
+		if (pDevice->eState & (ADF7030_1_STATE_OPENED | ADF7030_1_STATE_INITIALIZED) )
+		{
+		    misc_fw_t misc_fw;
+
+		    // Leave the smart wake receive (failure will show up in the following sequence)
+		    if ( pDevice->bSniffOn && (eCmd != PHY_CMD_RX) )
+		    {
+		    	_sniff_exit(pPhydev);
+		    }
+
+		    // Release the trigger pin of the scheduled TX
+		    if ( pInst->sTxAt.bTrigOn )
+		    {
+		    	_txat_disarm(pPhydev);
+		    }
+
+		    if (pSPIDevInfo->nPhyState != PHY_SLEEP)
+		    {
+		    	misc_fw.FW = adf7030_1__GetMiscFwStatus(pSPIDevInfo);
+		    	pSPIDevInfo->nPhyState =  misc_fw.FW_b.CURR_STATE;
+		    	pSPIDevInfo->ePhyError =  misc_fw.FW_b.ERR_CODE;
+		    }
+
+			switch (eCmd)
+			{
+				case PHY_CTL_CMD_READY:
+					eStatus = _ready_seq(pPhydev);
+					break;
+				//case PHY_CMD_TEST_MODE:
+				//	eStatus = _test_seq(pPhydev);
+				//	break;
+				case PHY_CTL_CMD_SLEEP:
+					eStatus = _sleep_seq(pPhydev);
+					break;
+				case PHY_CMD_RX:
+				case PHY_CMD_CCA:
+				case PHY_CMD_TX:
+					eStatus = _trx_seq(pPhydev);
+					if (eStatus == PHY_STATUS_OK)
+					{
+						if ( eCmd == PHY_CMD_RX)
+						{
+							pSPIDevInfo->nPhyNextState = PHY_RX;
+							pDevice->eState |= ADF7030_1_STATE_RECEIVING;
+						}
+						else if (eCmd == PHY_CMD_CCA)
+						{
+							pSPIDevInfo->nPhyNextState = CCA;
+							pDevice->eState |= ADF7030_1_STATE_NOISE_MEAS;
+						}
+						else { // PHY_CMD_TX
+							pSPIDevInfo->nPhyNextState = PHY_TX;
+							pDevice->eState |= ADF7030_1_STATE_TRANSMITTING;
+						}
+
+						//eRet = adf7030_1__STATE_PhyCMD( pSPIDevInfo, pSPIDevInfo->nPhyNextState );
+						eRet = adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, pSPIDevInfo->nPhyNextState, pSPIDevInfo->nPhyNextState );
+						if(eRet)
+						{
+							eStatus = PHY_STATUS_ERROR;
+						}
+					}
+					break;
+				default:
+					break;
+			}
+		}
+		else {
+			eStatus = PHY_STATUS_ERROR;
+			pSPIDevInfo->eXferResult = ADF7030_1_INVALID_OPERATION;
+		}
+    }
+    return eStatus;
+}
+
+/*!
+ * @brief  Interruption handler to treat the frame event
+ *
+ * @param [in] p_CbParam Pointer on call-back parameter
+ * @param [in] p_Arg     Pointer on call-back argument
+ *
+ * @return None
+ */
+static void _frame_it(void *p_CbParam, void *p_Arg)
+{
+	phydev_t *pPhydev = (phydev_t *) p_CbParam;
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    misc_fw_t misc_fw;
+    uint32_t eEvt = PHYDEV_EVT_NONE;
+    uint32_t u32IrqStatus;
+    uint8_t u8Drain;
+    uint8_t bCrcChk;
+
+    u32IrqStatus = adf7030_1__GetIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN0);
+	misc_fw.FW = adf7030_1__GetMiscFwStatus(pSPIDevInfo);
+	pSPIDevInfo->nPhyState =  misc_fw.FW_b.CURR_STATE;
+	pSPIDevInfo->ePhyError =  misc_fw.FW_b.ERR_CODE;
+
+	if( pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntMap & (PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk ) )
+	{
+		if (pDevice->eState & ADF7030_1_STATE_RECEIVING)
+		{
+			if(u32IrqStatus & PREAMBLE_IRQn_Msk )
+			{
+				pDevice->bDetected = 1;
+				if ( pInst->sScan.bOn )
+				{
+					// stay on this channel, a frame may follow
+					pInst->sScan.bLock = 1;
+					pInst->sScan.sStats.aCh[pPhydev->eChannel].u32NbDetect++;
+				}
+			}
+			if(u32IrqStatus & SYNCWORD_IRQn_Msk )
+			{
+				if ( pDevice->bDetected )
+				{
+					pDevice->bDetected = 0;
+					pPhydev->u16_Ferr = adf7030_1__GetRawAfcFreqErr(&(pDevice->SPIInfo));
+					eEvt = PHYDEV_EVT_RX_STARTED;
+				}
+			}
+		}
+	}
+	if(u32IrqStatus & CRC_CHK_IRQn_Msk )
+	{
+		// could be notified before the EOF, so latch it
+		pInst->sCrcOfl.bChk = 1;
+	}
+	if(u32IrqStatus & EOF_IRQn_Msk )
+	{
+		bCrcChk = pInst->sCrcOfl.bChk;
+		pInst->sCrcOfl.bChk = 0;
+		if (pDevice->eState & ADF7030_1_STATE_TRANSMITTING)
+		{
+			eEvt = PHYDEV_EVT_TX_COMPLETE;
+			pDevice->eState &= ~ADF7030_1_STATE_TRANSMITTING;
+			if (pDevice->u8StagedTXBuffSize)
+			{
+				// the staged frame becomes the pending one
+				pDevice->u8TxSlot ^= 1;
+				pDevice->u8PendTXBuffSize = pDevice->u8StagedTXBuffSize;
+				pDevice->u8StagedTXBuffSize = 0;
+				if (pDevice->bTxChained)
+				{
+					// already requested, so launch it right now
+					pDevice->bTxChained = 0;
+					_tx_prepare(pPhydev, pDevice->u8TxSlot, pDevice->u8PendTXBuffSize);
+					pDevice->u8PendTXBuffSize = 0;
+					pSPIDevInfo->nPhyNextState = PHY_TX;
+					if ( !adf7030_1__STATE_PhyCMD( pSPIDevInfo, PHY_TX ) )
+					{
+						pDevice->eState |= ADF7030_1_STATE_TRANSMITTING;
+					}
+				}
+			}
+		}
+		else if (pDevice->eState & ADF7030_1_STATE_RECEIVING)
+		{
+			eEvt = PHYDEV_EVT_RX_COMPLETE;
+			pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+			pInst->sRxRing.bRearmed = 0;
+			// drain the packet RAM into the ring, then listen again
+			if ( _crc_ofl(pPhydev) && !bCrcChk )
+			{
+				// bad CRC, don't even read it
+				pInst->sCrcOfl.u32Errors++;
+				u8Drain = 2;
+			}
+			else
+			{
+				u8Drain = _rx_drain(pPhydev);
+			}
+			if ( pInst->sScan.bOn )
+			{
+				if (u8Drain == 0)
+				{
+					pInst->sScan.sStats.aCh[pPhydev->eChannel].u32NbFrame++;
+				}
+				// done with this frame, the scan can go on
+				pInst->sScan.bLock = 0;
+				pDevice->bDetected = 0;
+			}
+			if (u8Drain == 2)
+			{
+				// not for us (or corrupted), so keep listening silently
+				eEvt = PHYDEV_EVT_NONE;
+			}
+			if ( (u8Drain != 1) && (RX_RING_CNT(pInst) < PHY_RX_RING_NB) )
+			{
+				if (pSPIDevInfo->nPhyState != PHY_RX)
+				{
+					pSPIDevInfo->nPhyNextState = PHY_RX;
+					if ( !adf7030_1__STATE_PhyCMD( pSPIDevInfo, PHY_RX ) )
+					{
+						pInst->sRxRing.bRearmed = 1;
+					}
+				}
+				else
+				{
+					pInst->sRxRing.bRearmed = 1;
+				}
+				if (pInst->sRxRing.bRearmed)
+				{
+					pDevice->eState |= ADF7030_1_STATE_RECEIVING;
+				}
+			}
+		}
+		else if (pDevice->eState & ADF7030_1_STATE_NOISE_MEAS)
+		{
+			pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
+		}
+		else // abort TX or RX ?
+		{}
+	}
+
+	if(u32IrqStatus == 0 )
+	{
+		eEvt = PHYDEV_EVT_ERROR;
+	}
+
+    // just to help debug
+    pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntStatus = u32IrqStatus;
+    // clear interrupt status
+    adf7030_1__ClrIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN0);
+    // event notification
+    if( (eEvt != PHYDEV_EVT_NONE) && pPhydev->pfEvtCb ) {
+		pPhydev->pfEvtCb(pPhydev->pCbParam, eEvt);
+	}
+}
+
+/*!
+ * @static
+ * @brief  This function copy the received frame from the packet RAM into the ring
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status
+ *  - 0 Success
+ *  - 1 The ring is full or the packet RAM read failed
+ *  - 2 The frame has been dropped by the address filter
+ */
+static uint8_t _rx_drain(phydev_t *pPhydev)
+{
+    phy_inst_t *pInst = PHY_INST(pPhydev);
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    phy_rx_frame_t *pRec;
+    uint8_t bMatch;
+
+    if ( RX_RING_CNT(pInst) >= PHY_RX_RING_NB )
+    {
+    	pInst->sRxRing.u32Overflow++;
+    	return 1;
+    }
+    pRec = &(pInst->sRxRing.aFrame[pInst->sRxRing.u8WrIdx & RX_RING_MSK]);
+    if (pInst->sAddrFilt.bEnable)
+    {
+    	if ( adf7030_1__GetRxPacketFilt( pSPIDevInfo, pRec->aPayload, &(pRec->u8Len),
+    			pInst->sAddrFilt.aAddr, PHY_ADDR_FILT_OFFSET, PHY_ADDR_FILT_SZ, &bMatch ) )
+    	{
+    		return 1;
+    	}
+    	if ( !bMatch )
+    	{
+    		pInst->sAddrFilt.u32Filtered++;
+    		return 2;
+    	}
+    }
+    else if ( adf7030_1__GetRxPacket( pSPIDevInfo, pRec->aPayload, &(pRec->u8Len) ) )
+    {
+    	return 1;
+    }
+    pRec->u16Rssi = adf7030_1__GetRawRSSI( pSPIDevInfo );
+    pRec->u16Ferr = pPhydev->u16_Ferr;
+    pRec->bCrcOk = pDevice->bCrcOn;
+    pRec->u64Timestamp = BSP_Rtc_Time_GetEpochMs();
+    pInst->sRxRing.u8WrIdx++;
+    return 0;
+}
+
+/*!
+ * @static
+ * @brief  This function cancel an RX which has been re-armed by the PHY itself
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      None
+ */
+static void _rx_rearm_cancel(phydev_t *pPhydev)
+{
+    phy_inst_t *pInst = PHY_INST(pPhydev);
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    if (pInst->sRxRing.bRearmed)
+    {
+    	// the upper layer didn't request it, so it is not busy
+    	pInst->sRxRing.bRearmed = 0;
+    	pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+    }
+}
+
+/*!
+ * @static
+ * @brief  This function select the TX slot and set the payload length, ready to issue PHY_TX
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  u8Slot  TX slot to send
+ * @param [in]  u8Len   Payload length
+ *
+ * @return      None
+ */
+static void _tx_prepare(phydev_t *pPhydev, uint8_t u8Slot, uint8_t u8Len)
+{
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    uint8_t u8Sz = 0;
+
+    if (pPhydev->eModulation == PHY_WM6400)
+    {
+		// from here, configuration for WM6400 has been done (set in CFG file)
+		// - raw mode is already selected
+		// - CRC is disable
+		// - PREAMBLE and SYNC word are staged in front of the TX packet buffer (see _tx_prefix_stage)
+		// So, to take into account PREAMBLE and SYNCHRO words :
+		// - point on the prefix (the payload follows it)
+		// - adjust the payload length
+    	adf7030_1__SPI_SetField(pSPIDevInfo,
+				GENERIC_PKT_BUFF_CFG0_PTR_TX_BASE_Addr,
+				GENERIC_PKT_BUFF_CFG0_PTR_TX_BASE_Pos,
+				GENERIC_PKT_BUFF_CFG0_PTR_TX_BASE_Size,
+				(uint32_t)PHY_PCK_TX_BUFF_BASE_OFFSET
+				);
+		u8Sz = PHY_WM6400_PREFIX_SZ;
+    }
+    else
+    {
+    	// point on the TX slot
+    	adf7030_1__SPI_SetField(pSPIDevInfo,
+				GENERIC_PKT_BUFF_CFG0_PTR_TX_BASE_Addr,
+				GENERIC_PKT_BUFF_CFG0_PTR_TX_BASE_Pos,
+				GENERIC_PKT_BUFF_CFG0_PTR_TX_BASE_Size,
+				(uint32_t)PHY_PCK_TX_SLOT_OFFSET(u8Slot)
+				);
+    }
+    pDevice->u8OnAirTXBuffSize = u8Len;
+    // the radio appends its own CRC, in place of the given one
+    if ( _crc_ofl(pPhydev) && !(pPhydev->bCrcOn) && (u8Len > PHY_CRC_SZ) )
+    {
+    	u8Len -= PHY_CRC_SZ;
+    }
+	// set payload length
+    adf7030_1__SPI_SetField(pSPIDevInfo,
+			GENERIC_PKT_FRAME_CFG1_PAYLOAD_SIZE_Addr,
+			GENERIC_PKT_FRAME_CFG1_PAYLOAD_SIZE_Pos,
+			GENERIC_PKT_FRAME_CFG1_PAYLOAD_SIZE_Size,
+			(uint32_t)(u8Len + u8Sz)
+			);
+}
+
+/*!
+ * @static
+ * @brief  This function mask/unmask the frame interrupt (the pending one is kept)
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  bMask   1 : mask, 0 : unmask
+ *
+ * @return      None
+ */
+static void _it_mask(phydev_t *pPhydev, uint8_t bMask)
+{
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    BSP_GpioIt_MaskLine(pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].u16Pin, bMask);
+}
+
+/*!
+ * @static
+ * @brief  This function tell if the CRC is offloaded to the radio for the current modulation
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      1 if offloaded, 0 otherwise
+ */
+static uint8_t _crc_ofl(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	// WM6400 is sent in raw mode, without the packet handler CRC
+	return ( pInst->sCrcOfl.bEnable && (pPhydev->eModulation != PHY_WM6400) )?(1):(0);
+}
 
-	pDevice->eState &= ~ADF7030_1_STATE_READY;
-	pDevice->eState &= ~(ADF7030_1_STATE_BUSY);
-	switch (pSPIDevInfo->nPhyState)
+/*!
+ * @brief This table hold the WM6400 preamble and sync. word, as sent on air (raw mode)
+ */
+static const uint8_t aWM6400Prefix[PHY_WM6400_PREFIX_SZ] = {
+	// PHY_WM6400_PREAMBLE_DATA
+	0xAD, 0xAD, 0xAD, 0xAD, 0xAD, 0xAD, 0xAD, 0xAD,
+	// PHY_WM6400_SYNC_WORD_DATA
+	0xDD, 0xDD, 0xAD, 0xDA, 0xAD, 0xDD, 0xAA, 0xDA,
+};
+
+/*!
+ * @static
+ * @brief  This function write the WM6400 preamble and sync. word in front of the TX buffer
+ *
+ * It is done once, then frames are uploaded in the TX buffer (slot 0) right
+ * after it. The prefix is kept until the packet RAM is lost (power, reset or
+ * sleep without retention).
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      0 on success, 1 otherwise
+ */
+static uint8_t _tx_prefix_stage(phydev_t *pPhydev)
+{
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    data_blck_desc_t sBlock;
+    uint8_t eRet;
+
+    sBlock.pData = (uint8_t*)aWM6400Prefix;
+    sBlock.Size  = PHY_WM6400_PREFIX_SZ;
+    sBlock.WordXfer = 0;
+    sBlock.Addr = PHY_PCK_TX_PREFIX_ADDR;
+    eRet = adf7030_1__WriteDataBlock( pSPIDevInfo, &sBlock);
+    eRet |= _tx_prefix_chk(pPhydev);
+    pDevice->bTxPrefixOn = (eRet)?(0):(1);
+    return eRet;
+}
+
+/*!
+ * @static
+ * @brief  This function check the WM6400 preamble and sync. word in packet RAM
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      0 if the prefix is in place, 1 otherwise
+ */
+static uint8_t _tx_prefix_chk(phydev_t *pPhydev)
+{
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    data_blck_desc_t sBlock;
+    uint8_t aPrefix[PHY_WM6400_PREFIX_SZ];
+
+    sBlock.pData = aPrefix;
+    sBlock.Size  = PHY_WM6400_PREFIX_SZ;
+    sBlock.WordXfer = 0;
+    sBlock.Addr = PHY_PCK_TX_PREFIX_ADDR;
+    if ( adf7030_1__ReadDataBlock( pSPIDevInfo, &sBlock) )
+    {
+    	return 1;
+    }
+    return ( memcmp(aPrefix, aWM6400Prefix, PHY_WM6400_PREFIX_SZ) )?(1):(0);
+}
+
+/*!
+ * @static
+ * @brief  This function leave the smart wake receive (sniff)
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      Status
+ *  - 0 Success
+ *  - 1 Failed to communicate with the device
+ */
+static uint8_t _sniff_exit(phydev_t *pPhydev)
+{
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    uint8_t eRet;
+
+    // The radio could be sleeping (SRAM retained) between two listens
+    adf7030_1_PulseWakup(pDevice);
+    eRet = adf7030_1__SetupSmartWake(pSPIDevInfo, 0, 0, 0);
+    pDevice->bSniffOn = 0;
+    // Awake now, so the caller will read back the current state
+    pSPIDevInfo->nPhyState = PHY_OFF;
+    // The LPM and RTC setup have to be (re)applied with CFG_DEV
+    pDevice->eState &= ~ADF7030_1_STATE_CONFIGURED;
+    pDevice->bCfgDone = 0;
+    return eRet;
+}
+
+/*!
+ * @static
+ * @brief  Interruption handler (timer compare) to fire the scheduled transmission
+ *
+ * @return None
+ */
+static void _txat_fire(void)
+{
+	phy_inst_t *pInst = pTimInst;
+	uint32_t u32Cnt;
+	if (pInst && pInst->sTxAt.bArmed)
 	{
-		// abort the current state, if required
-		case PHY_TX:
-		case PHY_RX:
-			// abort --> EOF interrupt
-			// So: disable interrupt
-			eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)0x0);
-		case CCA:
-		case DO_CAL:
-		case MON:
-			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
-			if(eRet)
-			{
-				break;
-			}
-		// still in ready state
-		case PHY_ON:
-			// does it need full configuration ?
-			if ( pDevice->bCfgDone == 0 )
-			{
-				// yes, switch to PHY_OFF state
-				eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_OFF, PHY_OFF);
-			}
-			break;
-		case PHY_OFF:
-		case CFG_DEV :
-			break;
-		default: // unexpected state
-			break;
+		adf7030_1_PulseTrigger((adf7030_1_device_t*)pInst->sTxAt.pPhydev->pCxt, PHY_TXAT_TRIGPIN);
+		u32Cnt = BSP_LpTimer_Stop(PHY_TXAT_LPTIM_ID);
+		pInst->sTxAt.u32Cnt = (u32Cnt)?(u32Cnt):(1);
+		pInst->sTxAt.bArmed = 0;
 	}
+	else
+	{
+		BSP_LpTimer_Stop(PHY_TXAT_LPTIM_ID);
+	}
+}
 
-	switch (pSPIDevInfo->nPhyState)
+/*!
+ * @static
+ * @brief  This function cancel the schedule (if any) and disable the trigger pin
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      None
+ */
+static void _txat_disarm(phydev_t *pPhydev)
+{
+    phy_inst_t *pInst = PHY_INST(pPhydev);
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    if (pInst->sTxAt.bArmed)
+    {
+    	BSP_LpTimer_Stop(PHY_TXAT_LPTIM_ID);
+    	pInst->sTxAt.bArmed = 0;
+    }
+    // Otherwise, a wake-up pulse (TRIG_AS_WAKE_UP) would start a TX
+    adf7030_1_SetupTrig(pDevice, PHY_TXAT_TRIGPIN, PHY_TX, 0);
+    pInst->sTxAt.bTrigOn = 0;
+    if (pTimInst == pInst)
+    {
+    	pTimInst = NULL;
+    }
+}
+
+/*!
+ * @static
+ * @brief  This function convert a schedule timer count into µs
+ *
+ * @param [in]  pTxAt  Pointer on the scheduled transmission
+ * @param [in]  u32Cnt Timer count
+ *
+ * @return      The elapsed time (µs)
+ */
+static uint32_t _txat_to_us(const txat_t *pTxAt, uint32_t u32Cnt)
+{
+	if (pTxAt->u32Freq == 0)
 	{
-		case PHY_SLEEP:
-			// will wake-up, so need to CFG_DEV
-			pDevice->eState &= ~ADF7030_1_STATE_CONFIGURED;
-			// Wake up
-			eRet |= adf7030_1_PulseWakup(pDevice);
-			// reinitialize the PNTR pointers
-			eRet |= adf7030_1__SPI_GetMMapPointers(pSPIDevInfo);
-			// switch to PHY_OFF
-			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_OFF, PHY_OFF);
-			//eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_BASE_CFG].cf, RF_CFG[PHY_BASE_CFG].size);
-			eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_HIDDEN].cf, RF_CFG[PHY_HIDDEN].size);
-			if(eRet)
-			{
-				break;
-			}
-		case PHY_OFF:
-			// Does it need a full configuration ?
-			if ( pDevice->bCfgDone == 0 )
-			{
-				// Yes, load the configuration file
-				eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[pPhydev->eModulation].cf, RF_CFG[pPhydev->eModulation].size);
-				if (!eRet)
-				{
-					pDevice->eState &= ~ADF7030_1_STATE_CONFIGURED;
-				}
+		return 0;
+	}
+	return (uint32_t)( ( ((uint64_t)u32Cnt << pTxAt->u8Presc) * 1000000 ) / pTxAt->u32Freq );
+}
 
-				// Check if calibration data are set or not
-				if (*(uint64_t*)(RF_CFG[PHY_RADIO_CAL].cf) != 0x0 )
-				{
-					// send calibration RADIO and VCO
-					if ( !(adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_RADIO_CAL].cf, RF_CFG[PHY_RADIO_CAL].size)) )
-					{
-						if ( !(adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_VCO_CAL].cf, RF_CFG[PHY_VCO_CAL].size)) )
-						{
-							pDevice->eState |= ADF7030_1_STATE_CALIBRATED;
-						}
-					}
-				}
-				//else { /* Default radio calibration are send with base_cfg*/ }
-			}
-			// Does it need a CFG_DEV state, case of : full configuration or from wake-up
-			if ( !(pDevice->eState & ADF7030_1_STATE_CONFIGURED) )
+/*!
+ * @static
+ * @brief  Interruption handler (timer compare) to go to the next channel of the scan
+ *
+ * The radio is only retuned : PHY_ON, channel frequency, then PHY_RX. Its
+ * priority is the same as the radio interrupt one, so they can't preempt each
+ * other while accessing the SPI.
+ *
+ * @return None
+ */
+static void _scan_hop(void)
+{
+	phy_inst_t *pInst = pTimInst;
+	scan_t *pScan;
+	phydev_t *pPhydev;
+    adf7030_1_device_t* pDevice;
+    adf7030_1_spi_info_t* pSPIDevInfo;
+    uint32_t u32Start, u32Time;
+    uint8_t eRet = 0;
+    uint8_t eCh;
+
+	BSP_LpTimer_Stop(PHY_TXAT_LPTIM_ID);
+	if ( !(pInst && pInst->sScan.bOn) )
+	{
+		return;
+	}
+	pScan = &pInst->sScan;
+	pPhydev = pScan->pPhydev;
+	pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+	pSPIDevInfo = &(pDevice->SPIInfo);
+	if ( !(pDevice->eState & ADF7030_1_STATE_RECEIVING) )
+	{
+		// not re-armed after a frame (ring full), so stay on this channel
+		_scan_stop(pPhydev);
+		return;
+	}
+	if ( pScan->bLock && !pScan->bLockExt )
+	{
+		pScan->bLockExt = 1;
+		BSP_LpTimer_Start(PHY_TXAT_LPTIM_ID, pScan->u16Lock);
+		return;
+	}
+	// no frame (or a false detection), go on
+	pScan->bLock = 0;
+	pScan->bLockExt = 0;
+	pDevice->bDetected = 0;
+
+	eCh = pPhydev->eChannel;
+	do {
+		eCh = ( (eCh + 1) < PHY_NB_CH )?(eCh + 1):(PHY_CH100);
+	} while ( !(pScan->u8ChMsk & (1 << eCh)) );
+
+	if (eCh != pPhydev->eChannel)
+	{
+		u32Start = cycles();
+		eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
+		adf7030_1__SPI_SetMem32( pSPIDevInfo, PROFILE_CH_FREQ_Addr,
+				PHY_FREQUENCY_CH(eCh) + pPhydev->i16TxFreqOffset );
+		pSPIDevInfo->nPhyNextState = PHY_RX;
+		eRet |= adf7030_1__STATE_PhyCMD( pSPIDevInfo, PHY_RX );
+		if (eRet)
+		{
+			_scan_stop(pPhydev);
+			pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+			if (pPhydev->pfEvtCb)
 			{
-				// yes, switch to CFG_DEV, then PHY_OFF (automatic goes back)
-				eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, CFG_DEV, PHY_OFF);
-				if (!eRet)
-				{
-					pDevice->bCfgDone = 1;
-					pDevice->eState |= ADF7030_1_STATE_CONFIGURED;
-				}
+				pPhydev->pfEvtCb(pPhydev->pCbParam, PHYDEV_EVT_ERROR);
 			}
-			// switch to PHY_ON, ...it is ready
-			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
-		case PHY_ON : // CFG_DEV or PHY_ON without requiring full configuration
-		case CFG_DEV :
-			break;
-		default: // unexpected state
-			eRet = 1;
-			break;
+			return;
+		}
+		pPhydev->eChannel = eCh;
+		u32Time = cycles_to_us(cycles() - u32Start);
+		if (u32Time > pScan->sStats.u32MaxRetune)
+		{
+			pScan->sStats.u32MaxRetune = u32Time;
+		}
+		pScan->sStats.u32NbHop++;
 	}
+	pScan->sStats.aCh[eCh].u32NbDwell++;
+	BSP_LpTimer_Start(PHY_TXAT_LPTIM_ID, pScan->u16Dwell);
+}
 
-	if(!eRet)
+/*!
+ * @static
+ * @brief  This function stop the scan timer (and release it), the radio stay as is
+ *
+ * @param [in]  pPhydev Pointer on the Phy device instance
+ *
+ * @return      None
+ */
+static void _scan_stop(phydev_t *pPhydev)
+{
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	// From here, the radio can't be retuned anymore
+	if (pTimInst == pInst)
 	{
-		pDevice->eState |= ADF7030_1_STATE_READY;
+		BSP_LpTimer_Stop(PHY_TXAT_LPTIM_ID);
+		pTimInst = NULL;
 	}
-	else
+	pInst->sScan.bOn = 0;
+	pInst->sScan.bLock = 0;
+	pInst->sScan.bLockExt = 0;
+	pInst->sScan.u8ChMsk = 0;
+	pInst->sScan.sStats.bOn = 0;
+}
+
+/*!
+ * @static
+ * @brief  This function compute a hash (FNV-1a) of a configuration image
+ *
+ * @param [in]  pCfg    Pointer on the configuration image
+ * @param [in]  u32Size Size of the configuration image
+ *
+ * @return      The hash value
+ */
+static uint32_t _cfg_hash(const uint8_t *pCfg, uint32_t u32Size)
+{
+	uint32_t u32Hash = 0x811C9DC5;
+	while (u32Size--)
 	{
-		// enable to communicate with the PHY
-		eStatus = PHY_STATUS_ERROR;
-		/* Notice that, at this point :
-		 *  - pDevice->eState has ADF7030_1_STATE_READY not set
-		 *  - pDevice->eState could has ADF7030_1_STATE_CONFIGURED not set
-		 *  - pDevice->bCfgDone could be 0
-		 */
+		u32Hash ^= *pCfg++;
+		u32Hash *= 0x01000193;
 	}
-	return eStatus;
+	return u32Hash;
+}
+
+/*!
+ * @brief  Interruption handler as an instrumentation
+ *
+ * @param [in] p_CbParam Pointer on call-back parameter
+ * @param [in] p_Arg     Pointer on call-back argument
+ *
+ * @return None
+ */
+static void _instrum_it(void *p_CbParam, void *p_Arg)
+{
+	phydev_t *pPhydev = (phydev_t *) p_CbParam;
+    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    uint32_t u32IrqStatus;
+
+    u32IrqStatus = adf7030_1__GetIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN1);
+    // just to help debug
+    pDevice->IntGPIOInfo[ADF7030_1_INTPIN1].nIntStatus = u32IrqStatus;
+    // clear interrupt status
+    adf7030_1__ClrIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN1);
 }
 
+/******************************************************************************/
+/******************************************************************************/
+
 /*!
  * @static
- * @brief  This function implement the sleep sequence
+ * @brief  This function execute a TX sequence
  *
- * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel use to TX
+ * @param [in]  eModulation Modulation use to TX
  *
  * @return      Status
- * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_OK     Requested command has been successfully executed
  * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
  * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
  */
-static int32_t _sleep_seq(phydev_t *pPhydev)
+static int32_t _do_TX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
 {
-	int32_t eStatus = PHY_STATUS_OK;
-	uint8_t eRet = 0;
+    int32_t i32Ret = PHY_STATUS_OK;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
-    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
-
-    eRet = adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)0x0);
-	switch (pSPIDevInfo->nPhyState)
+    _rx_rearm_cancel(pPhydev);
+    // A frame is staged while transmitting, on the same channel and modulation
+    if ( pDevice->u8StagedTXBuffSize && (eChannel == pPhydev->eChannel) && (eModulation == pPhydev->eModulation) )
+    {
+    	_it_mask(pPhydev, 1);
+    	if (pDevice->eState & ADF7030_1_STATE_TRANSMITTING)
+    	{
+    		// it will be sent on TX complete
+    		pDevice->bTxChained = 1;
+    		_it_mask(pPhydev, 0);
+    		return i32Ret;
+    	}
+    	_it_mask(pPhydev, 0);
+    }
+	if ( !(pDevice->eState & ADF7030_1_STATE_BUSY) )
 	{
-		// stop the current state, if required
-		case PHY_TX:
-		case PHY_RX:
-		case CCA:
-		case DO_CAL:
-		case MON:
-			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
-		case PHY_OFF:
-		case PHY_ON:
-			// of course, not ready anymore
-			pDevice->eState &= ~ADF7030_1_STATE_READY;
-			// nor configured
-			pDevice->eState &= ~ADF7030_1_STATE_CONFIGURED;
-			pSPIDevInfo->nPhyNextState = PHY_SLEEP;
-			eRet |= adf7030_1__STATE_PhyCMD( pSPIDevInfo, pSPIDevInfo->nPhyNextState );
-			if (!eRet)
+		// set modulation
+		if ( eModulation != pPhydev->eModulation)
+		{
+			pPhydev->eModulation = eModulation;
+			// full reconfiguration is required
+			pDevice->bCfgDone = 0;
+		}
+		// set the Channel
+		pPhydev->eChannel = eChannel;
+
+		i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+		if (i32Ret == PHY_STATUS_OK)
+		{
+			// WM6400 : preamble and sync. word are in front of the first slot
+			if (eModulation == PHY_WM6400)
 			{
-				pSPIDevInfo->nPhyState = PHY_SLEEP;
+				pDevice->u8TxSlot = 0;
 			}
-		default:
-			break;
+			// set TX slot and payload length
+			_tx_prepare(pPhydev, pDevice->u8TxSlot, pDevice->u8PendTXBuffSize);
+			pDevice->u8PendTXBuffSize = 0;
+			i32Ret = _do_cmd(pPhydev, PHY_CMD_TX);
+		}
 	}
-	if(eRet)
+	else
 	{
-		eStatus = PHY_STATUS_ERROR;
+		i32Ret = PHY_STATUS_BUSY;
 	}
-	return eStatus;
+    return i32Ret;
 }
 
 /*!
  * @static
- * @brief  This function implement the transmission/reception sequence
+ * @brief  This function execute an RX sequence
  *
- * @param [in]  pPhydev Pointer on the Phy device instance
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel use to RX
+ * @param [in]  eModulation Modulation use to RX
  *
  * @return      Status
- * - PHY_STATUS_OK     Requested sequence has been successfully executed
+ * - PHY_STATUS_OK     Requested command has been successfully executed
  * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
  * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
  */
-static int32_t _trx_seq(phydev_t *pPhydev)
+static int32_t _do_RX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
 {
-	int32_t eStatus = PHY_STATUS_OK;
-	uint8_t eRet = 0;
+    phy_inst_t *pInst = PHY_INST(pPhydev);
+    int32_t i32Ret = PHY_STATUS_OK;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
-    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
-	// It must be set to READY before
-	if(pDevice->eState & ADF7030_1_STATE_READY)
+    if ( pInst->sRxRing.bRearmed )
+    {
+    	// Already listening on the same channel and modulation
+    	if ( (eChannel == pPhydev->eChannel) && (eModulation == pPhydev->eModulation) )
+    	{
+    		pInst->sRxRing.bRearmed = 0;
+    		return i32Ret;
+    	}
+    	_rx_rearm_cancel(pPhydev);
+    }
+	if ( !(pDevice->eState & ADF7030_1_STATE_BUSY) )
 	{
-		if( ! (pDevice->eState & ADF7030_1_STATE_BUSY) )
+		if (eModulation > PHY_WM6400)
 		{
-			// Need to update CRC ?
-			if ( pDevice->bCrcOn != pPhydev->bCrcOn )
-			{
-				// Configure CRC
-				frame_cfg0_t frame_cfg0;
-				frame_cfg0 = (frame_cfg0_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, GENERIC_PKT_FRAME_CFG0_Addr));
-				frame_cfg0.FRAME_CFG0_b.CRC_LEN = pPhydev->bCrcOn*16;
-				adf7030_1__SPI_SetMem32(pSPIDevInfo, GENERIC_PKT_FRAME_CFG0_Addr, frame_cfg0.FRAME_CFG0);
-				pDevice->bCrcOn = pPhydev->bCrcOn;
-			}
-
-			// Need to update TX Power ?
-			if ( !(pDevice->bTxPwrDone) )
-			{
-				// Change TX Power
-				// PA_Coarse in {1 to 6}
-				// PA_Fine in {0, 3 to 127}
-				// PA_Micro in {1 to 31}
-				radio_dig_tx_cfg0_t tx_cfg0;
-				tx_cfg0 = (radio_dig_tx_cfg0_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG0_Addr));
-				// Setup PA1 power
-				tx_cfg0.RADIO_DIG_TX_CFG0_b.PA_COARSE = aPhyPower[pPhydev->eTxPower].coarse;
-				tx_cfg0.RADIO_DIG_TX_CFG0_b.PA_FINE = aPhyPower[pPhydev->eTxPower].fine;
-				tx_cfg0.RADIO_DIG_TX_CFG0_b.PA_MICRO = aPhyPower[pPhydev->eTxPower].micro;
-				adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG0_Addr, tx_cfg0.RADIO_DIG_TX_CFG0);
-				// Change TX power ramp
-#ifdef PHY_USE_POWER_RAMP
-				radio_dig_tx_cfg1_t tx_cfg1;
-				tx_cfg1 = (radio_dig_tx_cfg1_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG1_Addr));
-				tx_cfg1.RADIO_DIG_TX_CFG1_b.PA_RAMP_RATE = pa_ramp_rate;
-				adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_RADIO_DIG_TX_CFG1_Addr, tx_cfg1.RADIO_DIG_TX_CFG1);
-#endif
-				pDevice->bTxPwrDone = 1;
-			}
-
-			// Change frequency
-			uint32_t u32_Freq = PHY_FREQUENCY_CH(pPhydev->eChannel);
-			// only for TX
-			u32_Freq += pPhydev->i16TxFreqOffset;
-			adf7030_1__SPI_SetMem32( pSPIDevInfo, PROFILE_CH_FREQ_Addr, u32_Freq);
-
-			// Enable / Disable interrupt
-			if (pPhydev->eTestMode == PHY_TST_MODE_NONE)
-			{
-				// Need to update interrupt on PREMBLE and SYNC ?
-				if(pPhydev->bPreSyncOn)
-				{
-					// if not set
-					//if( !(pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntMap & (PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk)) )
-					{
-						eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)(PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk | EOF_IRQn_Msk));
-						eRet |= adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN0, 0xFFFFFFFF);
-					}
-					// else, already set
-				}
-				else {
-					// if set
-					//if( (pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntMap & (PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk)) )
-					{
-						eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)EOF_IRQn_Msk);
-						eRet |= adf7030_1__IRQ_ClrStatus(pDevice, ADF7030_1_INTPIN0, 0xFFFFFFFF);
-					}
-					// else, already unset
-				}
-			}
-			else
+			// modulation other than PHY_WM2400 and PHY_WM4800 are forbidden
+			pDevice->SPIInfo.eXferResult = ADF7030_1_INVALID_PHY_CONFIGURATION;
+			i32Ret = PHY_STATUS_ERROR;
+		}
+		else
+		{
+			// set modulation
+			if ( eModulation != pPhydev->eModulation)
 			{
-				// disable interrupt
-				eRet |= adf7030_1__IRQ_SetMap(pDevice, ADF7030_1_INTPIN0, (uint32_t)0x0);
+				pPhydev->eModulation = eModulation;
+				// full reconfiguration is required
+				pDevice->bCfgDone = 0;
 			}
-#ifdef PHY_DEBUG_SPE
-			eRet = adf7030_1__ReadDataBlock(pSPIDevInfo, &(sConfig.BLOCKS[0]));
-			eRet = adf7030_1__ReadDataBlock(pSPIDevInfo, &(sConfig.BLOCKS[1]));
-#endif
-			if(eRet)
+			// set the Channel
+			pPhydev->eChannel = eChannel;
+			i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+			if (i32Ret == PHY_STATUS_OK)
 			{
-				eStatus = PHY_STATUS_ERROR;
+				i32Ret = _do_cmd(pPhydev, PHY_CMD_RX);
 			}
 		}
-		else {
-			eStatus = PHY_STATUS_BUSY;
-		}
 	}
-	else {
-		eStatus = PHY_STATUS_ERROR;
-		pSPIDevInfo->eXferResult = ADF7030_1_INVALID_OPERATION;
+	else
+	{
+		i32Ret = PHY_STATUS_BUSY;
 	}
-	return eStatus;
+    return i32Ret;
 }
 
 /*!
- * @brief  This function change the PHY to test mode
+ * @static
+ * @brief  This function execute a Noise Measurement sequence
  *
- * @param [in]  pPhydev       Pointer on the Phy device instance
- * @param [in]  eTxMode       TX test mode (see @link test_modes_tx_e @endlink)
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel on which the Noise must be measured
+ * @param [in]  eModulation Modulation on which the Noise must be measured
  *
  * @return      Status
  * - PHY_STATUS_OK     Requested command has been successfully executed
@@ -1137,398 +2853,555 @@ static int32_t _trx_seq(phydev_t *pPhydev)
  * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
  */
-static int32_t _test_seq(phydev_t *pPhydev, test_modes_tx_e eTxMode)
+static int32_t _do_CCA(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
 {
-    int32_t eStatus = PHY_STATUS_ERROR;
-	uint8_t eRet = 0;
-	phy_ctl_e eCmd;
-
+    phy_inst_t *pInst = PHY_INST(pPhydev);
+    int32_t i32Ret = PHY_STATUS_OK;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
-    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
-
-	// TX power reconfiguration
-	pDevice->bTxPwrDone = 0;
-	// full reconfiguration
-	pDevice->bCfgDone = 0;
-
-    // Set to ready
-    eStatus = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
-
-	// It must be set to READY before
-	if(eStatus == PHY_STATUS_OK )
+    _rx_rearm_cancel(pPhydev);
+	if ( !(pDevice->eState & ADF7030_1_STATE_BUSY) )
 	{
-		test_modes1_t test_modes1;
-		test_modes0_t test_modes0;
-		test_modes0 = (test_modes0_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, GENERIC_PKT_TEST_MODES0_Addr));
-	    //
-		if (pPhydev->eTestMode == PHY_TST_MODE_NONE)
+		// set modulation
+		if ( eModulation != pPhydev->eModulation)
 		{
-			eCmd = PHY_CTL_CMD_READY;
-			// Unset test mode
-			test_modes0.TEST_MODES0_b.PER_EN = 0;
-			test_modes0.TEST_MODES0_b.PER_IRQ_SELF_CLEAR = 0;
-			test_modes0.TEST_MODES0_b.TX_TEST = 0;
-			pDevice->bTxPwrDone = 0;
+			pPhydev->eModulation = eModulation;
+			// full reconfiguration is required
 			pDevice->bCfgDone = 0;
 		}
-		else
-		{
-			// Set to test mode
-			test_modes0.TEST_MODES0_b.PER_EN = 1;
-			test_modes0.TEST_MODES0_b.PER_IRQ_SELF_CLEAR = 1;
-
-			if (pPhydev->eTestMode < PHY_TST_MODE_TX )
-			{
-				// RX test mode
-				eCmd = PHY_CMD_RX;
-				test_modes1.TEST_MODES1_b.PACKET_CNT = 100;
-				test_modes1.TEST_MODES1_b.CURRENT_CNT = 0;
-				adf7030_1__SPI_SetMem32(pSPIDevInfo, GENERIC_PKT_TEST_MODES1_Addr, test_modes1.TEST_MODES1);
-
-				if (pPhydev->eTestMode == PHY_TST_MODE_PER_RX)
-				{
-					eCmd = PHY_CMD_CCA;
-					// Disable AFC
-					config_t afc_config;
-					afc_config = (config_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, AFC_CONFIG_Addr));
-					afc_config.CONFIG_b.MODE = 0;
-					adf7030_1__SPI_SetMem32(pSPIDevInfo, AFC_CONFIG_Addr, afc_config.CONFIG);
-
-					// Set TICK_RATE to 1 and DETECTION_TIME to 0
-					cca_cfg_t cca_cfg;
-					cca_cfg = (cca_cfg_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_CCA_CFG_Addr));
-					cca_cfg.CCA_CFG_b.TICK_RATE = 1;
-					cca_cfg.CCA_CFG_b.DETECTION_TIME = 0;
-					adf7030_1__SPI_SetMem32(pSPIDevInfo, PROFILE_CCA_CFG_Addr, cca_cfg.CCA_CFG);
-				}
-			}
-			else
-			{
-				// TX test mode
-				eCmd = PHY_CMD_TX;
-				// check if require deviation of +/- 2 fdev
-				if (eTxMode == TMODE_TX_FDEV_MAXNEG || eTxMode == TMODE_TX_FDEV_MAXPOS)
-				{
-					radio_modes_t radio_modes;
-					radio_modes = (radio_modes_t)(adf7030_1__SPI_GetMem32(pSPIDevInfo, PROFILE_RADIO_MODES_Addr));
-					// check if current modulation is 4FSK (required for +/- 2fdev test
-					if (radio_modes.RADIO_MODES_b.TX_MOD_TYPE != MOD_4FSK)
-					{
-						eTxMode--;
-					}
-				}
-				test_modes0.TEST_MODES0_b.TX_TEST = eTxMode;
+		// set the Channel
+		pPhydev->eChannel = eChannel;
+
+		i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+		if (i32Ret == PHY_STATUS_OK)
+		{
+			i32Ret = _do_cmd(pPhydev, PHY_CMD_CCA);
+			if ( i32Ret == PHY_STATUS_OK)
+			{
+				adf7030_1__MeasureRawNoise( &(((adf7030_1_device_t*)pPhydev->pCxt)->SPIInfo), NOISE_MEAS_AVG_NB, NOISE_MEAS_TIME_BUDGET, &pInst->sNoiseMeas);
+				pPhydev->u16_Noise = pInst->sNoiseMeas.u16Noise;
+				i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+				pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
 			}
 		}
-		adf7030_1__SPI_SetMem32(pSPIDevInfo, GENERIC_PKT_TEST_MODES0_Addr, test_modes0.TEST_MODES0);
-		eStatus = _do_cmd(pPhydev, eCmd);
 	}
-    return eStatus;
+	else
+	{
+		i32Ret = PHY_STATUS_BUSY;
+	}
+    return i32Ret;
 }
 
 /*!
- * @brief  This is the main FSM.
+ * @brief  This function measure the noise level on all channels
  *
- * @details This function ensure that transition between state are respected.
- * ... :
- * - Wake-up, (re)configuration,
+ * The device stay in CCA/PHY_ON between channels, only the channel frequency
+ * is changed (no full READY and arming sequence for each channel).
  *
- * @param [in] pPhydev    Pointer on the Phy device instance
- * @param [in] eCmd       Requested command to execute
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eModulation Modulation on which the Noise must be measured
+ * @param [out] aNoise      Table that hold the noise level of each channel (same unit as PHY_CTL_GET_NOISE)
  *
- * @return             Status
- * - PHY_STATUS_OK     Requested command has been successfully executed
+ * @return      Status
+ * - PHY_STATUS_OK     Requested sequence has been successfully executed
  * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
  * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
  */
-static int32_t _do_cmd(phydev_t *pPhydev, uint8_t eCmd)
+int32_t Phy_NoiseSweep(phydev_t *pPhydev, phy_mod_e eModulation, uint8_t aNoise[PHY_NB_CH])
 {
-	int32_t eStatus = PHY_STATUS_OK;
-	uint8_t eRet = 0;
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	int32_t i32Ret = PHY_STATUS_ERROR;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
     adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    uint8_t eRet = 0;
+    uint8_t eCh;
 
-	if ( eCmd < PHY_CTL_CMD_READY)
+    if (aNoise == NULL || eModulation > PHY_WM6400)
+    {
+    	return i32Ret;
+    }
+    _rx_rearm_cancel(pPhydev);
+	if ( pDevice->eState & ADF7030_1_STATE_BUSY )
 	{
-		// Power supply command
-		pDevice->eState &= ADF7030_1_STATE_OPENED; // clear all except OPEN
-        pSPIDevInfo->eXferResult = ADF7030_1_SUCCESS;
-        pSPIDevInfo->nStatus.VALUE = 0;
-        pSPIDevInfo->nPhyState = PHY_SLEEP;
-        pSPIDevInfo->nPhyNextState = PHY_SLEEP;
-
-		pPhydev->bCrcOn = 0;
-		pPhydev->bPreSyncOn = 0;
-
+		return PHY_STATUS_BUSY;
+	}
+	// set modulation
+	if ( eModulation != pPhydev->eModulation)
+	{
+		pPhydev->eModulation = eModulation;
+		// full reconfiguration is required
 		pDevice->bCfgDone = 0;
-		pDevice->bCrcOn = 0;
-		pDevice->bTxPwrDone = 0;
-		pDevice->u8PendTXBuffSize = 0;
-
-		pPhydev->u16_Noise = 0;
-		pPhydev->u16_Rssi  = 0;
-		pPhydev->u16_Ferr  = 0;
-		pPhydev->eTestMode = PHY_TST_MODE_NONE;
-
-		switch(eCmd)
-		{
-			case PHY_CTL_CMD_PWR_OFF:
-				BSP_PwrLine_Clr(RF_EN_MSK);
-				break;
-			case PHY_CTL_CMD_PWR_ON:
-				// sleep for x µS or mS
-				BSP_PwrLine_Set(RF_EN_MSK);
-				// TODO : add micro-sleep to ensure power "propagating"
-			case PHY_CTL_CMD_RESET:
-			default:
-				adf7030_1_PulseReset(pDevice);
-				eRet |= adf7030_1__SPI_GetMMapPointers(pSPIDevInfo);
-				eRet |= adf7030_1__SendConfiguration( pSPIDevInfo, RF_CFG[PHY_BASE_CFG].cf, RF_CFG[PHY_BASE_CFG].size);
-				eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, CFG_DEV, PHY_OFF);
-				if (eRet)
-				{
-					eStatus = PHY_STATUS_ERROR;
-				}
-				else
-				{
-					pDevice->eState |= ADF7030_1_STATE_INITIALIZED;
-				}
-				break;
-		}
 	}
-    else
-    {
-    	// It must be Opened and Initialized
-		if (pDevice->eState & (ADF7030_1_STATE_OPENED | ADF7030_1_STATE_INITIALIZED) )
-		{
-		    misc_fw_t misc_fw;
-
-		    if (pSPIDevInfo->nPhyState != PHY_SLEEP)
-		    {
-		    	misc_fw.FW = adf7030_1__GetMiscFwStatus(pSPIDevInfo);
-		    	pSPIDevInfo->nPhyState =  misc_fw.FW_b.CURR_STATE;
-		    	pSPIDevInfo->ePhyError =  misc_fw.FW_b.ERR_CODE;
-		    }
+	// Full sequence on the first channel
+	pPhydev->eChannel = PHY_CH100;
+	i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+	if (i32Ret == PHY_STATUS_OK)
+	{
+		i32Ret = _do_cmd(pPhydev, PHY_CMD_CCA);
+	}
+	if (i32Ret != PHY_STATUS_OK)
+	{
+		pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
+		return i32Ret;
+	}
 
-			switch (eCmd)
+	for (eCh = PHY_CH100; eCh < PHY_NB_CH; eCh++)
+	{
+		if (eCh != PHY_CH100)
+		{
+			// Only retune, then go back in CCA
+			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
+			adf7030_1__SPI_SetMem32( pSPIDevInfo, PROFILE_CH_FREQ_Addr,
+					PHY_FREQUENCY_CH(eCh) + pPhydev->i16TxFreqOffset );
+			eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, CCA, CCA);
+			if (eRet)
 			{
-				case PHY_CTL_CMD_READY:
-					eStatus = _ready_seq(pPhydev);
-					break;
-				//case PHY_CMD_TEST_MODE:
-				//	eStatus = _test_seq(pPhydev);
-				//	break;
-				case PHY_CTL_CMD_SLEEP:
-					eStatus = _sleep_seq(pPhydev);
-					break;
-				case PHY_CMD_RX:
-				case PHY_CMD_CCA:
-				case PHY_CMD_TX:
-					eStatus = _trx_seq(pPhydev);
-					if (eStatus == PHY_STATUS_OK)
-					{
-						if ( eCmd == PHY_CMD_RX)
-						{
-							pSPIDevInfo->nPhyNextState = PHY_RX;
-							pDevice->eState |= ADF7030_1_STATE_RECEIVING;
-						}
-						else if (eCmd == PHY_CMD_CCA)
-						{
-							pSPIDevInfo->nPhyNextState = CCA;
-							pDevice->eState |= ADF7030_1_STATE_NOISE_MEAS;
-						}
-						else { // PHY_CMD_TX
-							pSPIDevInfo->nPhyNextState = PHY_TX;
-							pDevice->eState |= ADF7030_1_STATE_TRANSMITTING;
-						}
-
-						//eRet = adf7030_1__STATE_PhyCMD( pSPIDevInfo, pSPIDevInfo->nPhyNextState );
-						eRet = adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, pSPIDevInfo->nPhyNextState, pSPIDevInfo->nPhyNextState );
-						if(eRet)
-						{
-							eStatus = PHY_STATUS_ERROR;
-						}
-					}
-					break;
-				default:
-					break;
+				break;
 			}
 		}
-		else {
-			eStatus = PHY_STATUS_ERROR;
-			pSPIDevInfo->eXferResult = ADF7030_1_INVALID_OPERATION;
-		}
-    }
-    return eStatus;
+		adf7030_1__MeasureRawNoise( pSPIDevInfo, NOISE_MEAS_AVG_NB, NOISE_MEAS_TIME_BUDGET, &pInst->sNoiseMeas);
+		pPhydev->u16_Noise = pInst->sNoiseMeas.u16Noise;
+		aNoise[eCh] = PHY_CONV_Signed11ToRssi( pPhydev->u16_Noise );
+		pPhydev->eChannel = eCh;
+	}
+	i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+	pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
+	if (eRet)
+	{
+		i32Ret = PHY_STATUS_ERROR;
+	}
+	return i32Ret;
 }
 
 /*!
- * @brief  Interruption handler to treat the frame event
+ * @brief  This function send the pending frame if the channel is clear (listen before talk)
  *
- * @param [in] p_CbParam Pointer on call-back parameter
- * @param [in] p_Arg     Pointer on call-back argument
+ * The TX payload is armed first, then the noise is measured (CCA) and, if the
+ * channel is clear, the device goes straight from CCA to PHY_TX, without
+ * READY in between. So the channel can't change between the check and the
+ * transmission. Otherwise, the device goes back to PHY_ON and the frame is kept
+ * pending.
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel use to TX
+ * @param [in]  eModulation Modulation use to TX
+ * @param [in]  u8Threshold Maximum noise level for a clear channel (same unit as PHY_CTL_GET_NOISE)
+ * @param [out] pLbt        Pointer on the result (could be NULL)
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     The channel was clear and the TX is started
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving) or the channel is busy (see pLbt)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
- * @return None
  */
-static void _frame_it(void *p_CbParam, void *p_Arg)
+int32_t Phy_Lbt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint8_t u8Threshold, phy_lbt_t *pLbt)
 {
-	phydev_t *pPhydev = (phydev_t *) p_CbParam;
-    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+	int32_t i32Ret = PHY_STATUS_ERROR;
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
     adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
-    misc_fw_t misc_fw;
-    uint32_t eEvt = PHYDEV_EVT_NONE;
-    uint32_t u32IrqStatus;
+    uint32_t u32Start;
+    uint8_t u8Noise;
+    uint8_t eRet = 0;
 
-    u32IrqStatus = adf7030_1__GetIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN0);
-	misc_fw.FW = adf7030_1__GetMiscFwStatus(pSPIDevInfo);
-	pSPIDevInfo->nPhyState =  misc_fw.FW_b.CURR_STATE;
-	pSPIDevInfo->ePhyError =  misc_fw.FW_b.ERR_CODE;
+    if (pLbt)
+    {
+    	pLbt->u8Noise = 0;
+    	pLbt->bClear = 0;
+    	pLbt->u32Latency = 0;
+    }
+    if ( (eModulation > PHY_WM6400) || (pDevice->u8PendTXBuffSize == 0) )
+    {
+    	return i32Ret;
+    }
+    _rx_rearm_cancel(pPhydev);
+	if ( pDevice->eState & ADF7030_1_STATE_BUSY )
+	{
+		return PHY_STATUS_BUSY;
+	}
+	// set modulation
+	if ( eModulation != pPhydev->eModulation)
+	{
+		pPhydev->eModulation = eModulation;
+		// full reconfiguration is required
+		pDevice->bCfgDone = 0;
+	}
+	// set the Channel
+	pPhydev->eChannel = eChannel;
+	i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+	if (i32Ret != PHY_STATUS_OK)
+	{
+		return i32Ret;
+	}
+	// Arm the TX payload first
+	if (eModulation == PHY_WM6400)
+	{
+		pDevice->u8TxSlot = 0;
+	}
+	_tx_prepare(pPhydev, pDevice->u8TxSlot, pDevice->u8PendTXBuffSize);
 
-	if( pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntMap & (PREAMBLE_IRQn_Msk | SYNCWORD_IRQn_Msk ) )
+	// Then, measure in place
+	u32Start = cycles();
+	i32Ret = _do_cmd(pPhydev, PHY_CMD_CCA);
+	if (i32Ret == PHY_STATUS_OK)
 	{
-		if (pDevice->eState & ADF7030_1_STATE_RECEIVING)
+		eRet = adf7030_1__MeasureRawNoise( pSPIDevInfo, PHY_LBT_MEAS_NB, PHY_LBT_TIME_BUDGET, &pInst->sNoiseMeas);
+		pPhydev->u16_Noise = pInst->sNoiseMeas.u16Noise;
+		u8Noise = PHY_CONV_Signed11ToRssi( pPhydev->u16_Noise );
+		pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
+		if ( !eRet && (u8Noise <= u8Threshold) )
 		{
-			if(u32IrqStatus & PREAMBLE_IRQn_Msk )
-			{
-				pDevice->bDetected = 1;
-			}
-			if(u32IrqStatus & SYNCWORD_IRQn_Msk )
+			// clear, so from CCA straight to PHY_TX
+			pDevice->u8PendTXBuffSize = 0;
+			pDevice->eState |= ADF7030_1_STATE_TRANSMITTING;
+			pSPIDevInfo->nPhyNextState = PHY_TX;
+			eRet = adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, PHY_TX, PHY_TX );
+			if (eRet)
 			{
-				if ( pDevice->bDetected )
-				{
-					pDevice->bDetected = 0;
-					pPhydev->u16_Ferr = adf7030_1__GetRawAfcFreqErr(&(pDevice->SPIInfo));
-					eEvt = PHYDEV_EVT_RX_STARTED;
-				}
+				pDevice->eState &= ~ADF7030_1_STATE_TRANSMITTING;
+				i32Ret = PHY_STATUS_ERROR;
 			}
 		}
-	}
-	if(u32IrqStatus & EOF_IRQn_Msk )
-	{
-		if (pDevice->eState & ADF7030_1_STATE_TRANSMITTING)
-		{
-			eEvt = PHYDEV_EVT_TX_COMPLETE;
-			pDevice->eState &= ~ADF7030_1_STATE_TRANSMITTING;
-		}
-		else if (pDevice->eState & ADF7030_1_STATE_RECEIVING)
+		else
 		{
-			eEvt = PHYDEV_EVT_RX_COMPLETE;
-			pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+			// busy (or unable to measure), frame is kept pending
+			eRet = adf7030_1__STATE_PhyCMD_WaitReady( pSPIDevInfo, PHY_ON, PHY_ON );
+			i32Ret = (eRet)?(PHY_STATUS_ERROR):(PHY_STATUS_BUSY);
 		}
-		else if (pDevice->eState & ADF7030_1_STATE_NOISE_MEAS)
+		if (pLbt)
 		{
-			pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
+			pLbt->u8Noise = u8Noise;
+			pLbt->bClear = (i32Ret == PHY_STATUS_OK);
+			pLbt->u32Latency = cycles_to_us(cycles() - u32Start);
 		}
-		else // abort TX or RX ?
-		{}
+	}
+	else
+	{
+		pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
+	}
+	return i32Ret;
+}
+
+/*!
+ * @brief  This function schedule the transmission of the pending frame
+ *
+ * The radio is pre-armed (READY, TX slot, payload length, power, channel) and the
+ * trigger pin is set to start PHY_TX. Then, the low power timer pulse the trigger
+ * pin from its compare interrupt, so the TX start doesn't depend on the task
+ * scheduling nor on the SPI latency. The TX complete is notified as usual, and
+ * the trigger time is given by Phy_GetTxAt. On error, the trigger pin and the
+ * timer are released.
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eChannel    Channel use to TX
+ * @param [in]  eModulation Modulation use to TX
+ * @param [in]  u32Delay    TX start, from this request (µs)
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     The TX is scheduled
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving), or the timer is held by another instance
+ * - PHY_STATUS_ERROR  Enable to communicate with the device, or the pre-arm didn't leave enough time (PHY_TXAT_MARGIN)
+ *
+ */
+int32_t Phy_TxAt(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation, uint32_t u32Delay)
+{
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    uint32_t u32Start, u32Armed, u32Freq;
+    uint64_t u64Cyc;
+
+    u32Start = cycles();
+    if ( (eModulation > PHY_WM6400) || (pDevice->u8PendTXBuffSize == 0) )
+    {
+    	return i32Ret;
+    }
+    _rx_rearm_cancel(pPhydev);
+	if ( pDevice->eState & ADF7030_1_STATE_BUSY )
+	{
+		return PHY_STATUS_BUSY;
+	}
+	// the timer is held by another instance
+	if ( pTimInst && (pTimInst != pInst) )
+	{
+		return PHY_STATUS_BUSY;
+	}
+	// set modulation
+	if ( eModulation != pPhydev->eModulation)
+	{
+		pPhydev->eModulation = eModulation;
+		// full reconfiguration is required
+		pDevice->bCfgDone = 0;
+	}
+	// set the Channel
+	pPhydev->eChannel = eChannel;
+	i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+	if (i32Ret != PHY_STATUS_OK)
+	{
+		return i32Ret;
+	}
+	// Pre-arm : TX slot and payload length, then CRC, power and channel
+	if (eModulation == PHY_WM6400)
+	{
+		pDevice->u8TxSlot = 0;
+	}
+	_tx_prepare(pPhydev, pDevice->u8TxSlot, pDevice->u8PendTXBuffSize);
+	i32Ret = _trx_seq(pPhydev);
+	if (i32Ret != PHY_STATUS_OK)
+	{
+		return i32Ret;
+	}
+	pTimInst = pInst;
+	pInst->sTxAt.pPhydev = pPhydev;
+	pInst->sTxAt.bTrigOn = 1;
+	if ( adf7030_1_SetupTrig(pDevice, PHY_TXAT_TRIGPIN, PHY_TX, 1) )
+	{
+		_txat_disarm(pPhydev);
+		return PHY_STATUS_ERROR;
 	}
 
-	if(u32IrqStatus == 0 )
+	// Then, program the remaining delay
+	u32Armed = cycles_to_us(cycles() - u32Start);
+	u32Freq = BSP_LpTimer_GetFreq(PHY_TXAT_LPTIM_ID);
+	u64Cyc = ( (uint64_t)(u32Delay - u32Armed) * u32Freq ) / 1000000;
+	if ( (u32Armed + PHY_TXAT_MARGIN > u32Delay) || (u64Cyc == 0) || (u64Cyc > 0x007FFFFF) )
 	{
-		eEvt = PHYDEV_EVT_ERROR;
+		// too late (or too far), the frame is kept pending
+		_txat_disarm(pPhydev);
+		pSPIDevInfo->eXferResult = ADF7030_1_INVALID_OPERATION;
+		return PHY_STATUS_ERROR;
 	}
+	pInst->sTxAt.u32Armed = u32Armed;
+	pInst->sTxAt.u32Freq = u32Freq;
+	pInst->sTxAt.u32Cnt = 0;
+
+	pDevice->u8PendTXBuffSize = 0;
+	pSPIDevInfo->nPhyNextState = PHY_TX;
+	pDevice->eState |= ADF7030_1_STATE_TRANSMITTING;
+	pInst->sTxAt.bArmed = 1;
+	BSP_LpTimer_SetHandler(PHY_TXAT_LPTIM_ID, _txat_fire);
+	pInst->sTxAt.u32Cmp = BSP_LpTimer_StartCyc(PHY_TXAT_LPTIM_ID, (uint32_t)u64Cyc);
+	pInst->sTxAt.u8Presc = BSP_LpTimer_GetPrescaler(PHY_TXAT_LPTIM_ID);
+	return PHY_STATUS_OK;
+}
 
-    // just to help debug
-    pDevice->IntGPIOInfo[ADF7030_1_INTPIN0].nIntStatus = u32IrqStatus;
-    // clear interrupt status
-    adf7030_1__ClrIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN0);
-    // event notification
-    if( (eEvt != PHYDEV_EVT_NONE) && pPhydev->pfEvtCb ) {
-		pPhydev->pfEvtCb(pPhydev->pCbParam, eEvt);
+/*!
+ * @brief  This function cancel the scheduled transmission, the frame is kept pending
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     The TX has been canceled (or nothing was scheduled)
+ * - PHY_STATUS_BUSY   Too late, the TX is already started
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
+ *
+ */
+int32_t Phy_TxAtCancel(phydev_t *pPhydev)
+{
+    phy_inst_t *pInst = PHY_INST(pPhydev);
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
+
+    if ( (pTimInst != pInst) || !pInst->sTxAt.bTrigOn )
+    {
+    	// nothing scheduled on this instance
+    	return PHY_STATUS_OK;
+    }
+    // From here, the trigger can't be pulsed anymore
+    BSP_LpTimer_Stop(PHY_TXAT_LPTIM_ID);
+    if ( !pInst->sTxAt.bArmed )
+    {
+    	return (pInst->sTxAt.u32Cnt && (pDevice->eState & ADF7030_1_STATE_TRANSMITTING))?(PHY_STATUS_BUSY):(PHY_STATUS_OK);
+    }
+    pInst->sTxAt.bArmed = 0;
+    pDevice->eState &= ~ADF7030_1_STATE_TRANSMITTING;
+    pDevice->u8PendTXBuffSize = pDevice->u8OnAirTXBuffSize;
+    // release the trigger pin, then go back to READY
+	return _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+}
+
+/*!
+ * @brief  This function get the timing of the last scheduled transmission
+ *
+ * The start is the time the trigger pin has been pulsed, as read in the timer
+ * interrupt : the radio goes to PHY_TX on it, the frame is on air after the
+ * radio TX ramp up.
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [out] pTxAt       Pointer on the timing
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     The trigger has been pulsed (or nothing was scheduled)
+ * - PHY_STATUS_BUSY   The TX is still waiting for the trigger
+ * - PHY_STATUS_ERROR  Invalid parameter
+ *
+ */
+int32_t Phy_GetTxAt(phydev_t *pPhydev, phy_txat_t *pTxAt)
+{
+	phy_inst_t *pInst;
+	uint32_t u32Cnt;
+	if ( !(pPhydev && pTxAt) )
+	{
+		return PHY_STATUS_ERROR;
 	}
+	pInst = PHY_INST(pPhydev);
+	u32Cnt = pInst->sTxAt.u32Cnt;
+	pTxAt->u32Armed = pInst->sTxAt.u32Armed;
+	pTxAt->u32Target = pInst->sTxAt.u32Armed + _txat_to_us(&pInst->sTxAt, pInst->sTxAt.u32Cmp);
+	pTxAt->u32Start = (u32Cnt)?(pInst->sTxAt.u32Armed + _txat_to_us(&pInst->sTxAt, u32Cnt)):(0);
+	return (pInst->sTxAt.bArmed)?(PHY_STATUS_BUSY):(PHY_STATUS_OK);
 }
 
 /*!
- * @brief  Interruption handler as an instrumentation
+ * @brief  This function start a multi-channel listen (scan)
  *
- * @param [in] p_CbParam Pointer on call-back parameter
- * @param [in] p_Arg     Pointer on call-back argument
+ * The device is fully set in RX on the first channel of the set. Then, on each
+ * dwell time out, it is only retuned to the next one (see _scan_hop). When a
+ * preamble is detected, the dwell is extended once by the lock time, so it
+ * should cover the longest frame. Received frames go through the RX ring, as
+ * usual, and the scan goes on until Phy_ScanStop (or any other command). It
+ * also ends (on the current channel) when the RX ring is full.
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [in]  eModulation Modulation use to RX
+ * @param [in]  pScan       Pointer on the scan set point
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     The scan is started
+ * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving), or the timer is held (scheduled transmission, or another instance)
+ * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
- * @return None
  */
-static void _instrum_it(void *p_CbParam, void *p_Arg)
+int32_t Phy_Scan(phydev_t *pPhydev, phy_mod_e eModulation, const phy_scan_t *pScan)
 {
-	phydev_t *pPhydev = (phydev_t *) p_CbParam;
-    adf7030_1_device_t* pDevice = (adf7030_1_device_t*)pPhydev->pCxt;
+	int32_t i32Ret = PHY_STATUS_ERROR;
+	phy_inst_t *pInst = PHY_INST(pPhydev);
+    adf7030_1_device_t* pDevice = pPhydev->pCxt;
     adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
-    uint32_t u32IrqStatus;
+    uint8_t eCh;
 
-    u32IrqStatus = adf7030_1__GetIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN1);
-    // just to help debug
-    pDevice->IntGPIOInfo[ADF7030_1_INTPIN1].nIntStatus = u32IrqStatus;
-    // clear interrupt status
-    adf7030_1__ClrIrqStatus(pSPIDevInfo, ADF7030_1_INTPIN1);
-}
+    if ( (pScan == NULL) || (eModulation > PHY_WM6400) || (pScan->u16Dwell == 0)
+    		|| !(pScan->u8ChMsk & ((1 << PHY_NB_CH) - 1)) )
+    {
+    	pSPIDevInfo->eXferResult = ADF7030_1_INVALID_PHY_CONFIGURATION;
+    	return i32Ret;
+    }
+    _rx_rearm_cancel(pPhydev);
+	if ( pDevice->eState & ADF7030_1_STATE_BUSY )
+	{
+		return PHY_STATUS_BUSY;
+	}
+	// the timer is held by a scheduled TX, or by another instance
+	if ( pTimInst && ( (pTimInst != pInst) || pInst->sTxAt.bTrigOn ) )
+	{
+		return PHY_STATUS_BUSY;
+	}
+	// set modulation
+	if ( eModulation != pPhydev->eModulation)
+	{
+		pPhydev->eModulation = eModulation;
+		// full reconfiguration is required
+		pDevice->bCfgDone = 0;
+	}
+	// Full sequence on the first channel
+	for (eCh = PHY_CH100; eCh < PHY_NB_CH; eCh++)
+	{
+		if (pScan->u8ChMsk & (1 << eCh)) { break; }
+	}
+	pPhydev->eChannel = eCh;
+	memset(&pInst->sScan.sStats, 0, sizeof(phy_scan_stats_t));
+	pInst->sScan.pPhydev = pPhydev;
+	pInst->sScan.u16Dwell = pScan->u16Dwell;
+	pInst->sScan.u16Lock = pScan->u16Lock;
+	pInst->sScan.bLock = 0;
+	pInst->sScan.bLockExt = 0;
+	i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+	if (i32Ret == PHY_STATUS_OK)
+	{
+		// from here, the RX sequence enable the preamble detection (see _trx_seq)
+		pInst->sScan.u8ChMsk = pScan->u8ChMsk;
+		i32Ret = _do_cmd(pPhydev, PHY_CMD_RX);
+	}
+	if (i32Ret != PHY_STATUS_OK)
+	{
+		pInst->sScan.u8ChMsk = 0;
+		pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+		return i32Ret;
+	}
 
-/******************************************************************************/
-/******************************************************************************/
+	_it_mask(pPhydev, 1);
+	pDevice->bDetected = 0;
+	pInst->sScan.sStats.aCh[eCh].u32NbDwell = 1;
+	pInst->sScan.bOn = 1;
+	pInst->sScan.sStats.bOn = 1;
+	pTimInst = pInst;
+	BSP_LpTimer_SetHandler(PHY_TXAT_LPTIM_ID, _scan_hop);
+	BSP_LpTimer_Start(PHY_TXAT_LPTIM_ID, pInst->sScan.u16Dwell);
+	_it_mask(pPhydev, 0);
+	return PHY_STATUS_OK;
+}
 
 /*!
- * @static
- * @brief  This function execute a TX sequence
+ * @brief  This function stop the multi-channel listen (scan)
  *
  * @param [in]  pPhydev     Pointer on the Phy device instance
- * @param [in]  eChannel    Channel use to TX
- * @param [in]  eModulation Modulation use to TX
  *
  * @return      Status
  * - PHY_STATUS_OK     Requested command has been successfully executed
- * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
  * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
  */
-static int32_t _do_TX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+int32_t Phy_ScanStop(phydev_t *pPhydev)
 {
-    int32_t i32Ret = PHY_STATUS_OK;
+    phy_inst_t *pInst = PHY_INST(pPhydev);
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
-	if ( !(pDevice->eState & ADF7030_1_STATE_BUSY) )
-	{
-		// set modulation
-		if ( eModulation != pPhydev->eModulation)
-		{
-			pPhydev->eModulation = eModulation;
-			// full reconfiguration is required
-			pDevice->bCfgDone = 0;
-		}
-		// set the Channel
-		pPhydev->eChannel = eChannel;
 
-		i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
-		if (i32Ret == PHY_STATUS_OK)
-		{
-			uint8_t u8Sz = 0;
-			if (eModulation == PHY_WM6400)
-			{
-				// from here, configuration for WM6400 has been done (set in CFG file)
-				// - raw mode is already selected
-				// - CRC is disable
-				// - PREAMBLE and SYNC word are set in the TX packet buffer
-				// - adjust the TX buffer address (offset)
-				// So, to take into account PREAMBLE and SYNCHRO words :
-				// - adjust the payload length
-				u8Sz = (PHY_WM6400_PREAMBLE_SIZE/8) + (PHY_WM6400_SYNC_WORD_SIZE/8);
-			}
-			// set payload length
-			adf7030_1__SPI_SetField(&(pDevice->SPIInfo),
-					GENERIC_PKT_FRAME_CFG1_PAYLOAD_SIZE_Addr,
-					GENERIC_PKT_FRAME_CFG1_PAYLOAD_SIZE_Pos,
-					GENERIC_PKT_FRAME_CFG1_PAYLOAD_SIZE_Size,
-					(uint32_t)(pDevice->u8PendTXBuffSize + u8Sz)
-					);
-			pDevice->u8PendTXBuffSize = 0;
-			i32Ret = _do_cmd(pPhydev, PHY_CMD_TX);
-		}
-	}
-	else
+    if ( !pInst->sScan.bOn )
+    {
+    	return PHY_STATUS_OK;
+    }
+    _scan_stop(pPhydev);
+    _it_mask(pPhydev, 1);
+    pInst->sRxRing.bRearmed = 0;
+    pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+    _it_mask(pPhydev, 0);
+    // then go back to READY
+	return _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+}
+
+/*!
+ * @brief  This function get the multi-channel listen (scan) statistics
+ *
+ * The statistics are cleared on each scan start.
+ *
+ * @param [in]  pPhydev     Pointer on the Phy device instance
+ * @param [out] pStats      Pointer on the statistics
+ *
+ * @return      Status
+ * - PHY_STATUS_OK     Function has been successfully executed
+ * - PHY_STATUS_ERROR  Invalid parameter
+ *
+ */
+int32_t Phy_GetScanStats(phydev_t *pPhydev, phy_scan_stats_t *pStats)
+{
+	if ( !(pPhydev && pStats) )
 	{
-		i32Ret = PHY_STATUS_BUSY;
+		return PHY_STATUS_ERROR;
 	}
-    return i32Ret;
+	_it_mask(pPhydev, 1);
+	*pStats = PHY_INST(pPhydev)->sScan.sStats;
+	_it_mask(pPhydev, 0);
+	return PHY_STATUS_OK;
 }
 
 /*!
- * @static
- * @brief  This function execute an RX sequence
+ * @brief  This function start a smart wake (sniff) receive
+ *
+ * The radio RTC periodically wakes it up to listen, during the dwell times given
+ * by the sniff table for this modulation, then it goes back to sleep. The host
+ * is only interrupted when a frame is detected, so the MCU can stay in STOP2
+ * (tickless idle) in between. Received frames go through the RX ring, as usual,
+ * and the sniff goes on until Phy_SniffStop (or any READY, SLEEP, power command).
  *
  * @param [in]  pPhydev     Pointer on the Phy device instance
  * @param [in]  eChannel    Channel use to RX
@@ -1540,96 +3413,100 @@ static int32_t _do_TX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulat
  * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
  */
-static int32_t _do_RX(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+int32_t Phy_Sniff(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
 {
-    int32_t i32Ret = PHY_STATUS_OK;
+	int32_t i32Ret = PHY_STATUS_ERROR;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
-	if ( !(pDevice->eState & ADF7030_1_STATE_BUSY) )
+    adf7030_1_spi_info_t* pSPIDevInfo = &(pDevice->SPIInfo);
+    phy_sniff_t *pSniff;
+    lpm_cfg_t sDwell;
+    uint8_t eRet = 0;
+
+    if ( (eModulation > PHY_WM6400) || (aPhySniff[eModulation].u16Period == 0) )
+    {
+    	pSPIDevInfo->eXferResult = ADF7030_1_INVALID_PHY_CONFIGURATION;
+    	return i32Ret;
+    }
+    _rx_rearm_cancel(pPhydev);
+	if ( pDevice->eState & ADF7030_1_STATE_BUSY )
 	{
-		if (eModulation > PHY_WM6400)
-		{
-			// modulation other than PHY_WM2400 and PHY_WM4800 are forbidden
-			pDevice->SPIInfo.eXferResult = ADF7030_1_INVALID_PHY_CONFIGURATION;
-			i32Ret = PHY_STATUS_ERROR;
-		}
-		else
-		{
-			// set modulation
-			if ( eModulation != pPhydev->eModulation)
-			{
-				pPhydev->eModulation = eModulation;
-				// full reconfiguration is required
-				pDevice->bCfgDone = 0;
-			}
-			// set the Channel
-			pPhydev->eChannel = eChannel;
-			i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
-			if (i32Ret == PHY_STATUS_OK)
-			{
-				i32Ret = _do_cmd(pPhydev, PHY_CMD_RX);
-			}
-		}
+		return PHY_STATUS_BUSY;
 	}
-	else
+	// set modulation
+	if ( eModulation != pPhydev->eModulation)
 	{
-		i32Ret = PHY_STATUS_BUSY;
+		pPhydev->eModulation = eModulation;
+		// full reconfiguration is required
+		pDevice->bCfgDone = 0;
 	}
-    return i32Ret;
+	// set the Channel
+	pPhydev->eChannel = eChannel;
+	i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
+	if (i32Ret != PHY_STATUS_OK)
+	{
+		return i32Ret;
+	}
+
+	pSniff = &(aPhySniff[eModulation]);
+	sDwell.LPM_CFG = 0;
+	sDwell.LPM_CFG_b.PREAMBLE_DETECT_DWELL_TIME = pSniff->u8DetectDwell;
+	sDwell.LPM_CFG_b.PREAMBLE_QUAL_DWELL_TIME = pSniff->u8QualDwell;
+	sDwell.LPM_CFG_b.PREAMBLE_DWELL_TIME = pSniff->u8SyncDwell;
+	eRet |= adf7030_1__SetupSmartWake(pSPIDevInfo, 1, pSniff->u16Period, sDwell.LPM_CFG);
+
+	// RTC is setup on CFG_DEV
+	eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_OFF, PHY_OFF);
+	eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, CFG_DEV, PHY_OFF);
+	eRet |= adf7030_1__STATE_PhyCMD_WaitReady(pSPIDevInfo, PHY_ON, PHY_ON);
+	pDevice->bSniffOn = 1;
+	if (eRet)
+	{
+		_do_cmd(pPhydev, PHY_CTL_CMD_READY);
+		return PHY_STATUS_ERROR;
+	}
+	i32Ret = _do_cmd(pPhydev, PHY_CMD_RX);
+	if (i32Ret != PHY_STATUS_OK)
+	{
+		pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+		_do_cmd(pPhydev, PHY_CTL_CMD_READY);
+	}
+	return i32Ret;
 }
 
 /*!
- * @static
- * @brief  This function execute a Noise Measurement sequence
+ * @brief  This function stop the smart wake (sniff) receive
  *
  * @param [in]  pPhydev     Pointer on the Phy device instance
- * @param [in]  eChannel    Channel on which the Noise must be measured
- * @param [in]  eModulation Modulation on which the Noise must be measured
  *
  * @return      Status
  * - PHY_STATUS_OK     Requested command has been successfully executed
- * - PHY_STATUS_BUSY   The device is busy (transmitting or receiving)
  * - PHY_STATUS_ERROR  Enable to communicate with the device (communication or state failure)
  *
  */
-static int32_t _do_CCA(phydev_t *pPhydev, phy_chan_e eChannel, phy_mod_e eModulation)
+int32_t Phy_SniffStop(phydev_t *pPhydev)
 {
-    int32_t i32Ret = PHY_STATUS_OK;
+    phy_inst_t *pInst = PHY_INST(pPhydev);
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
-	if ( !(pDevice->eState & ADF7030_1_STATE_BUSY) )
-	{
-		// set modulation
-		if ( eModulation != pPhydev->eModulation)
-		{
-			pPhydev->eModulation = eModulation;
-			// full reconfiguration is required
-			pDevice->bCfgDone = 0;
-		}
-		// set the Channel
-		pPhydev->eChannel = eChannel;
 
-		i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
-		if (i32Ret == PHY_STATUS_OK)
-		{
-			i32Ret = _do_cmd(pPhydev, PHY_CMD_CCA);
-			if ( i32Ret == PHY_STATUS_OK)
-			{
-				pPhydev->u16_Noise = adf7030_1__GetRawNoise( &(((adf7030_1_device_t*)pPhydev->pCxt)->SPIInfo), NOISE_MEAS_AVG_NB );
-				i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
-				pDevice->eState &= ~ADF7030_1_STATE_NOISE_MEAS;
-			}
-		}
-	}
-	else
-	{
-		i32Ret = PHY_STATUS_BUSY;
-	}
-    return i32Ret;
+    if ( !pDevice->bSniffOn )
+    {
+    	return PHY_STATUS_OK;
+    }
+    _it_mask(pPhydev, 1);
+    pInst->sRxRing.bRearmed = 0;
+    pDevice->eState &= ~ADF7030_1_STATE_RECEIVING;
+    _it_mask(pPhydev, 0);
+    // leave the sniff, then go back to READY
+	return _do_cmd(pPhydev, PHY_CTL_CMD_READY);
 }
 
 /*!
  * @static
  * @brief  This function set the packet to send
  *
+ * While transmitting, the packet is staged into the other TX slot. Then, it will
+ * be sent on TX complete if TX is requested before (or as usual, after).
+ *
  * @param [in]  pPhydev Pointer on the Phy device instance
  * @param [in]  pBuf    Pointer to get data to send
  * @param [in]  u8Len   Reference on the data length to send
@@ -1644,10 +3521,46 @@ static int32_t _set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len)
 {
 	int32_t i32Ret = PHY_STATUS_ERROR;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
+    uint8_t u8UpLen = u8Len;
     if(pBuf && u8Len )
     {
-    	if (!(pDevice->eState & ADF7030_1_STATE_TRANSMITTING ))
+    	// the radio appends its own CRC, so don't upload the given one
+    	if ( _crc_ofl(pPhydev) && !(pPhydev->bCrcOn) && (u8Len > PHY_CRC_SZ) )
+    	{
+    		u8UpLen -= PHY_CRC_SZ;
+    	}
+    	_rx_rearm_cancel(pPhydev);
+    	_it_mask(pPhydev, 1);
+    	if (pDevice->eState & ADF7030_1_STATE_TRANSMITTING )
+    	{
+    		i32Ret = PHY_STATUS_BUSY;
+    		// Stage it in the other TX slot, if both frames fit in their slot
+    		if ( (pPhydev->eModulation != PHY_WM6400)
+    				&& (pDevice->u8StagedTXBuffSize == 0)
+    				&& (u8Len <= PHY_PCK_TX_SLOT_SZ)
+    				&& (pDevice->u8OnAirTXBuffSize <= PHY_PCK_TX_SLOT_SZ) )
+    		{
+				data_blck_desc_t sBlock;
+				sBlock.pData = pBuf;
+				sBlock.Size  = u8UpLen;
+				sBlock.WordXfer = 0;
+				sBlock.Addr = PHY_PCK_TX_SLOT_ADDR(pDevice->u8TxSlot ^ 1);
+
+				if( !( adf7030_1__WriteDataBlock( &(pDevice->SPIInfo), &sBlock) ) )
+				{
+					pDevice->u8StagedTXBuffSize = u8Len;
+					i32Ret = PHY_STATUS_OK;
+				}
+				else
+				{
+					i32Ret = PHY_STATUS_ERROR;
+				}
+    		}
+    		_it_mask(pPhydev, 0);
+    	}
+    	else
     	{
+    		_it_mask(pPhydev, 0);
 			if ( !(pDevice->eState & ADF7030_1_STATE_READY ) )
 			{
 				i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
@@ -1661,13 +3574,14 @@ static int32_t _set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len)
 			{
 				data_blck_desc_t sBlock;
 				sBlock.pData = pBuf;
-				sBlock.Size  = u8Len;
+				sBlock.Size  = u8UpLen;
 				sBlock.WordXfer = 0;
-				sBlock.Addr = PHY_PCK_TX_BUFF_ADDR;
+				sBlock.Addr = PHY_PCK_TX_SLOT_ADDR(0);
 
 				if( !( adf7030_1__WriteDataBlock( &(pDevice->SPIInfo), &sBlock) ) )
 				{
 					// set packet buffer len
+					pDevice->u8TxSlot = 0;
 					pDevice->u8PendTXBuffSize = u8Len;
 				}
 				else
@@ -1676,9 +3590,6 @@ static int32_t _set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len)
 				}
 			}
     	}
-    	else {
-    		i32Ret = PHY_STATUS_BUSY;
-    	}
     }
     return i32Ret;
 }
@@ -1699,34 +3610,26 @@ static int32_t _set_send(phydev_t *pPhydev, uint8_t *pBuf, uint8_t u8Len)
  */
 static int32_t _get_recv(phydev_t *pPhydev, uint8_t *pBuf, uint8_t* u8Len)
 {
+	phy_inst_t *pInst = PHY_INST(pPhydev);
 	int32_t i32Ret = PHY_STATUS_ERROR;
     adf7030_1_device_t* pDevice = pPhydev->pCxt;
+	phy_rx_frame_t *pRec;
     if(pBuf && u8Len )
     {
-    	if (!(pDevice->eState & ADF7030_1_STATE_RECEIVING ) )
-		{
-			if ( !(pDevice->eState & ADF7030_1_STATE_READY ) )
-			{
-				i32Ret = _do_cmd(pPhydev, PHY_CTL_CMD_READY);
-			}
-			else
-			{
-				i32Ret = PHY_STATUS_OK;
-			}
-
-			if (i32Ret == PHY_STATUS_OK)
-			{
-				if ( !(adf7030_1__GetRxPacket( &(pDevice->SPIInfo), pBuf, u8Len )) )
-				{
-					pPhydev->u16_Rssi = adf7030_1__GetRawRSSI( &(pDevice->SPIInfo));
-				}
-				else
-				{
-					i32Ret = PHY_STATUS_ERROR;
-				}
-			}
+    	// frames are drained into the ring on RX_COMPLETE, so just pop the oldest one
+    	if ( RX_RING_CNT(pInst) )
+    	{
+			pRec = &(pInst->sRxRing.aFrame[pInst->sRxRing.u8RdIdx & RX_RING_MSK]);
+			memcpy(pBuf, pRec->aPayload, pRec->u8Len);
+			*u8Len = pRec->u8Len;
+			pPhydev->u16_Rssi = pRec->u16Rssi;
+			pPhydev->u16_Ferr = pRec->u16Ferr;
+			pInst->sCrcOfl.bLastOk = pRec->bCrcOk;
+			pInst->sRxRing.u8RdIdx++;
+			i32Ret = PHY_STATUS_OK;
     	}
-    	else {
+    	else if (pDevice->eState & ADF7030_1_STATE_RECEIVING )
+    	{
     		i32Ret = PHY_STATUS_BUSY;
     	}
     }
@@ -1776,6 +3679,14 @@ static int32_t _ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args)
 			pPhydev->eModulation = ((test_mode_info_t)args).eModulation;
 			i32Ret = _test_seq(pPhydev, ((test_mode_info_t)args).eTxMode);
 		}
+		else if (eCtl == PHY_CMD_GET_RSSI_QDBM)
+		{
+			*(int16_t*)args = PHY_CONV_Signed11ToQdBm( pPhydev->u16_Rssi );
+		}
+		else if (eCtl == PHY_CMD_GET_FERR_HZ)
+		{
+			*(int32_t*)args = PHY_CONV_AfcFreqErrToHz( pPhydev->u16_Ferr );
+		}
 		else
 		{
 			i32Ret = _do_cmd(pPhydev, eCtl);
@@ -1818,7 +3729,8 @@ static int32_t _ioctl(phydev_t *pPhydev, uint32_t eCtl, uint32_t args)
 					*(uint8_t*)args = pPhydev->eTxPower;
 					break;
 				case PHY_CTL_GET_FREQ_ERR:
-					*(float*)args = PHY_CONV_AfcFreqErrToFloat( pPhydev->u16_Ferr );
+					// the stack takes a float (in Hz), see PHY_CMD_GET_FERR_HZ for the integer one
+					*(float*)args = (float)PHY_CONV_AfcFreqErrToHz( pPhydev->u16_Ferr );
 					break;
 				case PHY_CTL_GET_RSSI:
 					*(uint8_t*)args = PHY_CONV_Signed11ToRssi( pPhydev->u16_Rssi );
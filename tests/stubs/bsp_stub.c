@@ -0,0 +1,34 @@
+/*
+ * Host stand-in of the BSP functions used by the units under test
+ */
+#include <time.h>
+#include "bsp.h"
+
+/* Monotonic "cycles" : 1 cycle = 1 ns */
+uint32_t cycles(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+uint32_t cycles_to_us(uint32_t cycle)
+{
+	return cycle / 1000;
+}
+
+uint8_t BSP_Spi_SetBitrate (const p_spi_dev_t p_Device, const uint32_t u32_Hertz)
+{
+	(void)p_Device;
+	(void)u32_Hertz;
+	return DEV_SUCCESS;
+}
+
+/* weak, so a test can put its own (fake) radio behind the SPI */
+__attribute__((weak))
+uint8_t BSP_Spi_ReadWrite (const p_spi_dev_t p_Device, spi_transceiver_s* const p_Xfr)
+{
+	(void)p_Device;
+	(void)p_Xfr;
+	return DEV_SUCCESS;
+}
@@ -0,0 +1,14 @@
+/*
+ * Host stand-in of the newlib <machine/endian.h>
+ */
+#ifndef _HOST_MACHINE_ENDIAN_H_
+#define _HOST_MACHINE_ENDIAN_H_
+
+#include <endian.h>
+
+#define __htonl(x) __builtin_bswap32(x)
+#define __ntohl(x) __builtin_bswap32(x)
+#define __htons(x) __builtin_bswap16(x)
+#define __ntohs(x) __builtin_bswap16(x)
+
+#endif /* _HOST_MACHINE_ENDIAN_H_ */
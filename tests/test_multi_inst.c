@@ -0,0 +1,216 @@
+/**
+  * @file: test_multi_inst.c
+  * @brief: This file hold the adf7030-1 two devices (instances) tests.
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19[GBI]
+  * Initial version
+  *
+  *
+  */
+#include <string.h>
+#include "unity.h"
+#include "adf7030-1_phy.h"
+#include "adf7030-1__cfg.h"
+#include "adf7030-1__spi.h"
+
+#if (ADF7030_1_NUM_DEV < 2)
+#error "ADF7030_1_NUM_DEV must be at least 2"
+#endif
+
+/* Fake radio memory window */
+#define MEM_BASE  0x20000400UL
+#define MEM_SIZE  0x800
+/* Cfg images : sequences (address, number of words), as long as the cfg transfer buffer allows */
+#define SEQ_NB    3
+static const uint32_t aSeqAddr[SEQ_NB] = { MEM_BASE, MEM_BASE + 0x100, MEM_BASE + 0x200 };
+static const uint32_t aSeqWords[SEQ_NB] = { 8, 24, 64 };
+#define IMG_SZ    (SEQ_NB * 8 + (8 + 24 + 64) * 4)
+
+static uint8_t aMem[2][MEM_SIZE];
+static uint8_t aImg[2][IMG_SZ];
+static spi_dev_t aSpi[2] = { { .bus_id = 0 }, { .bus_id = 1 } };
+static adf7030_1_device_t aDev[2];
+
+/* Interrupt of the other radio, run once its SPI transfer is done (before its unstaging) */
+static void (*pfPreempt)(void);
+static uint32_t u32NbPreempt;
+
+/******************************************************************************/
+/* Fake radio : 32 bits address block read and write only */
+static uint32_t _be32_(const uint8_t *p)
+{
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+uint8_t BSP_Spi_ReadWrite (const p_spi_dev_t p_Device, spi_transceiver_s* const p_Xfr)
+{
+	uint8_t *pTx = p_Xfr->pTransmitter;
+	uint8_t *pRx = p_Xfr->pReceiver;
+	uint32_t nLen = p_Xfr->TransmitterBytes;
+	uint8_t *pMem = aMem[p_Device->bus_id];
+	uint32_t u32Addr = _be32_(pTx + 1);
+	void (*pfIt)(void);
+
+	memset(pRx, 0xA5, nLen);
+	switch (pTx[0] & 0x78)
+	{
+		// cmd, address, data
+		case ( ADF703x_SPI_MEM_WRITE | ADF703x_SPI_MEM_BLOCK | ADF703x_SPI_MEM_ADDRESS | ADF703x_SPI_MEM_LONG ):
+			TEST_ASSERT_TRUE( (u32Addr >= MEM_BASE) && (u32Addr - MEM_BASE + nLen - 5 <= MEM_SIZE) );
+			memcpy(pMem + (u32Addr - MEM_BASE), pTx + 5, nLen - 5);
+			break;
+		// cmd, address, 2 dummy bytes, data
+		case ( ADF703x_SPI_MEM_READ | ADF703x_SPI_MEM_BLOCK | ADF703x_SPI_MEM_ADDRESS | ADF703x_SPI_MEM_LONG ):
+			TEST_ASSERT_TRUE( (u32Addr >= MEM_BASE) && (u32Addr - MEM_BASE + nLen - 7 <= MEM_SIZE) );
+			memcpy(pRx + 7, pMem + (u32Addr - MEM_BASE), nLen - 7);
+			break;
+		default:
+			break;
+	}
+	if ( (p_Device->bus_id == 0) && pfPreempt )
+	{
+		pfIt = pfPreempt;
+		pfPreempt = NULL;
+		pfIt();
+		pfPreempt = pfIt;
+		u32NbPreempt++;
+	}
+	return DEV_SUCCESS;
+}
+
+/******************************************************************************/
+static void _build_img_(uint8_t *pImg, uint8_t seed)
+{
+	uint32_t s, i, len;
+	for (s = 0; s < SEQ_NB; s++)
+	{
+		len = 8 + aSeqWords[s] * 4;
+		*pImg++ = (uint8_t)(len >> 16);
+		*pImg++ = (uint8_t)(len >> 8);
+		*pImg++ = (uint8_t)(len);
+		*pImg++ = ADF703x_SPI_MEM_WRITE | ADF703x_SPI_MEM_BLOCK | ADF703x_SPI_MEM_ADDRESS | ADF703x_SPI_MEM_LONG;
+		*pImg++ = (uint8_t)(aSeqAddr[s] >> 24);
+		*pImg++ = (uint8_t)(aSeqAddr[s] >> 16);
+		*pImg++ = (uint8_t)(aSeqAddr[s] >> 8);
+		*pImg++ = (uint8_t)(aSeqAddr[s]);
+		for (i = 0; i < aSeqWords[s] * 4; i++)
+		{
+			*pImg++ = seed;
+			seed = seed * 37 + 11;
+		}
+	}
+}
+
+/* The other radio interrupt : read some of its memory, check it */
+static void _it_dev1_(void)
+{
+	uint32_t aRd[20];
+	uint32_t i;
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__SPI_rd_word_b_a(&aDev[1].SPIInfo, aSeqAddr[1], 20, aRd));
+	for (i = 0; i < 20; i++)
+	{
+		TEST_ASSERT_EQUAL_UINT32(_be32_(&aMem[1][0x100 + 4 * i]), aRd[i]);
+	}
+}
+
+/* The other radio interrupt : full verify of its configuration */
+static void _it_dev1_verify_(void)
+{
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__VerifyConfiguration(&aDev[1].SPIInfo, aImg[1], IMG_SZ, ADF7030_1_CFG_SEQ_ALL));
+}
+
+void setUp(void)
+{
+	uint8_t i;
+	pfPreempt = NULL;
+	u32NbPreempt = 0;
+	memset(aMem, 0, sizeof(aMem));
+	_build_img_(aImg[0], 1);
+	_build_img_(aImg[1], 2);
+	for (i = 0; i < 2; i++)
+	{
+		memset(&aDev[i], 0, sizeof(adf7030_1_device_t));
+		aDev[i].u8InstId = i;
+		TEST_ASSERT_EQUAL_UINT8(0, adf7030_1_Setup(&aDev[i], NULL, NULL, NULL, ADF7030_1_GPIO_NONE, ADF7030_1_GPIO_NONE));
+		aDev[i].SPIInfo.hSPIDevice = &aSpi[i];
+	}
+}
+void tearDown(void) {}
+
+/* Each device has its own SPI buffers, an out of range index is rejected */
+void test_setup_buffers(void)
+{
+	adf7030_1_device_t sDev;
+	TEST_ASSERT_EQUAL_UINT8(0, aDev[0].SPIInfo.nDevId);
+	TEST_ASSERT_EQUAL_UINT8(1, aDev[1].SPIInfo.nDevId);
+	TEST_ASSERT_TRUE(aDev[0].SPIInfo.pSPI_TX_BUFF != aDev[1].SPIInfo.pSPI_TX_BUFF);
+	TEST_ASSERT_TRUE(aDev[0].SPIInfo.pSPI_RX_BUFF != aDev[1].SPIInfo.pSPI_RX_BUFF);
+
+	memset(&sDev, 0, sizeof(sDev));
+	sDev.u8InstId = ADF7030_1_NUM_DEV;
+	TEST_ASSERT_EQUAL_UINT8(1, adf7030_1_Setup(&sDev, NULL, NULL, NULL, ADF7030_1_GPIO_NONE, ADF7030_1_GPIO_NONE));
+}
+
+/* Each device get its own configuration */
+void test_cfg_two_devices(void)
+{
+	uint8_t i;
+	for (i = 0; i < 2; i++)
+	{
+		TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__SendConfiguration(&aDev[i].SPIInfo, aImg[i], IMG_SZ));
+	}
+	TEST_ASSERT_EQUAL_MEMORY(&aImg[0][8], &aMem[0][0], 8 * 4);
+	TEST_ASSERT_EQUAL_MEMORY(&aImg[1][8], &aMem[1][0], 8 * 4);
+	for (i = 0; i < 2; i++)
+	{
+		TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__VerifyConfiguration(&aDev[i].SPIInfo, aImg[i], IMG_SZ, ADF7030_1_CFG_SEQ_ALL));
+		TEST_ASSERT_EQUAL_UINT8(1, adf7030_1__VerifyConfiguration(&aDev[i].SPIInfo, aImg[1 - i], IMG_SZ, ADF7030_1_CFG_SEQ_ALL));
+	}
+}
+
+/* The other radio interrupt between a transfer and its unstaging doesn't corrupt it */
+void test_preempted_xfer(void)
+{
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__SendConfiguration(&aDev[1].SPIInfo, aImg[1], IMG_SZ));
+
+	pfPreempt = _it_dev1_;
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__SendConfiguration(&aDev[0].SPIInfo, aImg[0], IMG_SZ));
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__VerifyConfiguration(&aDev[0].SPIInfo, aImg[0], IMG_SZ, ADF7030_1_CFG_SEQ_ALL));
+
+	// the other radio runs a whole cfg sequence meanwhile
+	pfPreempt = _it_dev1_verify_;
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__SendConfiguration(&aDev[0].SPIInfo, aImg[0], IMG_SZ));
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__VerifyConfiguration(&aDev[0].SPIInfo, aImg[0], IMG_SZ, ADF7030_1_CFG_SEQ_ALL));
+	pfPreempt = NULL;
+
+	TEST_ASSERT_TRUE(u32NbPreempt > 2 * SEQ_NB);
+	TEST_ASSERT_EQUAL_UINT8(0, adf7030_1__VerifyConfiguration(&aDev[1].SPIInfo, aImg[1], IMG_SZ, ADF7030_1_CFG_SEQ_ALL));
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_setup_buffers);
+	RUN_TEST(test_cfg_two_devices);
+	RUN_TEST(test_preempted_xfer);
+	return UNITY_END();
+}
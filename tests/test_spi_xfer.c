@@ -0,0 +1,256 @@
+/**
+  * @file: test_spi_xfer.c
+  * @brief: This file hold the adf7030-1 SPI buffer staging tests and benchmark.
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19[GBI]
+  * Initial version
+  *
+  *
+  */
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "adf7030-1__spi.h"
+
+/* Largest payload of one transfer (the SPI buffer less the command header) */
+#define XFER_MAX   ADF7030_1_SPI_MAX_TRX_SIZE
+/* Payload offsets, to cover unaligned buffers */
+#define XFER_OFF   4
+/* Benchmark repetitions per size */
+#define BENCH_LOOP 2000
+
+static uint8_t aSrc[XFER_MAX + XFER_OFF];
+static uint8_t aRef[XFER_MAX + XFER_OFF];
+static uint8_t aSpi[XFER_MAX + XFER_OFF];
+static uint8_t aSpiRef[XFER_MAX + XFER_OFF];
+static uint8_t aDest[XFER_MAX + XFER_OFF];
+static uint8_t aDestRef[XFER_MAX + XFER_OFF];
+
+/******************************************************************************/
+/* Reference : the former byte/word loops */
+static void _ref_write_(void* pDest, void* pSrc, uint32_t nBytes, uint32_t mode, uint32_t op)
+{
+	uint32_t nb_word = nBytes >> 2;
+	uint32_t nb_rem = (mode & 1)?(0):(nBytes & 3);
+	uint32_t i, word;
+	for (i = 0; i < nb_word; i++)
+	{
+		if (op)
+		{
+			word = 0xFFFFFFFF;
+		}
+		else
+		{
+			memcpy(&word, (uint8_t*)pSrc + 4*i, 4);
+			if (mode & 1) word = __ntohl(word);
+		}
+		memcpy((uint8_t*)pDest + 4*i, &word, 4);
+	}
+	for (i = 0; i < nb_rem; i++)
+	{
+		((uint8_t*)pDest)[4*nb_word + i] = (op)?(0xFF):(((uint8_t*)pSrc)[4*nb_word + i]);
+	}
+}
+
+static uint8_t _ref_read_(void* pDest, void* pSrc, void* pRef, uint32_t nBytes, uint32_t mode)
+{
+	uint32_t nb_word = nBytes >> 2;
+	uint32_t nb_rem = (mode & 1)?(0):(nBytes & 3);
+	uint32_t i, word, ref;
+	if ( (pDest == NULL) && (pRef == NULL) )
+	{
+		return 1;
+	}
+	for (i = 0; i < nb_word; i++)
+	{
+		memcpy(&word, (uint8_t*)pSrc + 4*i, 4);
+		if (mode & 1) word = __ntohl(word);
+		if (pRef)
+		{
+			memcpy(&ref, (uint8_t*)pRef + 4*i, 4);
+			if (ref != word) return 1;
+		}
+		if (pDest) memcpy((uint8_t*)pDest + 4*i, &word, 4);
+	}
+	for (i = 0; i < nb_rem; i++)
+	{
+		uint8_t byte = ((uint8_t*)pSrc)[4*nb_word + i];
+		if (pRef && (((uint8_t*)pRef)[4*nb_word + i] != byte)) return 1;
+		if (pDest) ((uint8_t*)pDest)[4*nb_word + i] = byte;
+	}
+	return 0;
+}
+
+/******************************************************************************/
+static void _fill_(uint8_t *p, uint32_t n, uint8_t seed)
+{
+	while (n--) { *p++ = seed; seed = seed * 37 + 11; }
+}
+
+void setUp(void)
+{
+	_fill_(aSrc, sizeof(aSrc), 1);
+	memset(aSpi, 0, sizeof(aSpi));
+	memset(aSpiRef, 0, sizeof(aSpiRef));
+	memset(aDest, 0, sizeof(aDest));
+	memset(aDestRef, 0, sizeof(aDestRef));
+}
+void tearDown(void) {}
+
+/* TX staging matches the former loops, for every size, mode and alignment */
+void test_write_all_sizes(void)
+{
+	uint32_t n, mode, op, off;
+	for (off = 0; off < XFER_OFF; off++)
+	for (op = 0; op < 2; op++)
+	for (mode = 0; mode < 2; mode++)
+	for (n = 0; n <= XFER_MAX; n++)
+	{
+		memset(aSpi, 0x5A, sizeof(aSpi));
+		memset(aSpiRef, 0x5A, sizeof(aSpiRef));
+		adf7030_1__SPI_Xfer_WriteBuff(aSpi + off, aSrc + off, n, mode, op);
+		_ref_write_(aSpiRef + off, aSrc + off, n, mode, op);
+		TEST_ASSERT_EQUAL_MEMORY(aSpiRef, aSpi, sizeof(aSpi));
+	}
+}
+
+/* RX unstaging and compare match the former loops */
+void test_read_all_sizes(void)
+{
+	uint32_t n, mode, off, bad;
+	uint8_t ret, retRef;
+	for (off = 0; off < XFER_OFF; off++)
+	for (mode = 0; mode < 2; mode++)
+	for (n = 0; n <= XFER_MAX; n++)
+	{
+		// copy only
+		_fill_(aSpi, sizeof(aSpi), (uint8_t)n);
+		memcpy(aSpiRef, aSpi, sizeof(aSpi));
+		memset(aDest, 0, sizeof(aDest));
+		memset(aDestRef, 0, sizeof(aDestRef));
+		ret = adf7030_1__SPI_Xfer_ReadBuff(aDest + off, aSpi + off, NULL, n, mode);
+		retRef = _ref_read_(aDestRef + off, aSpiRef + off, NULL, n, mode);
+		TEST_ASSERT_EQUAL_UINT8(retRef, ret);
+		TEST_ASSERT_EQUAL_MEMORY(aDestRef, aDest, sizeof(aDest));
+
+		// compare (with and without copy), matching then with one bad byte
+		for (bad = 0; bad < 2; bad++)
+		{
+			_fill_(aSpi, sizeof(aSpi), (uint8_t)n);
+			memcpy(aSpiRef, aSpi, sizeof(aSpi));
+			_ref_read_(aRef + off, aSpiRef + off, NULL, n, mode);
+			if (bad && n)
+			{
+				aRef[off + n / 2] ^= 0x01;
+			}
+			retRef = _ref_read_(NULL, aSpiRef + off, aRef + off, n, mode);
+			ret = adf7030_1__SPI_Xfer_ReadBuff(NULL, aSpi + off, aRef + off, n, mode);
+			TEST_ASSERT_EQUAL_UINT8(retRef, ret);
+
+			_fill_(aSpi, sizeof(aSpi), (uint8_t)n);
+			memset(aDest, 0, sizeof(aDest));
+			memset(aDestRef, 0, sizeof(aDestRef));
+			retRef = _ref_read_(aDestRef + off, aSpiRef + off, aRef + off, n, mode);
+			ret = adf7030_1__SPI_Xfer_ReadBuff(aDest + off, aSpi + off, aRef + off, n, mode);
+			TEST_ASSERT_EQUAL_UINT8(retRef, ret);
+			if (!ret)
+			{
+				TEST_ASSERT_EQUAL_MEMORY(aDestRef, aDest, sizeof(aDest));
+			}
+		}
+	}
+}
+
+/* In place and unaligned swap */
+void test_swap_in_place(void)
+{
+	uint8_t aBuf[9] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+	const uint8_t aExp[9] = { 0, 4, 3, 2, 1, 8, 7, 6, 5 };
+	adf7030_1__SPI_Xfer_Swap(aBuf + 1, aBuf + 1, 2);
+	TEST_ASSERT_EQUAL_MEMORY(aExp, aBuf, sizeof(aBuf));
+}
+
+/******************************************************************************/
+/* Benchmark : former loops versus current staging, for every transfer size */
+void test_bench_all_sizes(void)
+{
+	uint32_t n, mode, i, t0;
+	uint64_t aNew[2][2] = {{0}}, aOld[2][2] = {{0}};
+	volatile uint8_t ret = 0;
+
+	_fill_(aSpiRef, sizeof(aSpiRef), 3);
+	for (mode = 0; mode < 2; mode++)
+	{
+		for (n = 1; n <= XFER_MAX; n++)
+		{
+			t0 = cycles();
+			for (i = 0; i < BENCH_LOOP; i++)
+			{
+				_ref_write_(aSpi + 1, aSrc + 1, n, mode, 0);
+				ret |= _ref_read_(aDest + 1, aSpi + 1, NULL, n, mode);
+			}
+			aOld[mode][0] += cycles() - t0;
+
+			t0 = cycles();
+			for (i = 0; i < BENCH_LOOP; i++)
+			{
+				adf7030_1__SPI_Xfer_WriteBuff(aSpi + 1, aSrc + 1, n, mode, 0);
+				ret |= adf7030_1__SPI_Xfer_ReadBuff(aDest + 1, aSpi + 1, NULL, n, mode);
+			}
+			aNew[mode][0] += cycles() - t0;
+
+			// compare against the expected data, the RX buffer being reloaded
+			// each time (the word mode swaps it in place)
+			_ref_read_(aDest + 1, aSpiRef + 1, NULL, n, mode);
+			t0 = cycles();
+			for (i = 0; i < BENCH_LOOP; i++)
+			{
+				memcpy(aSpi, aSpiRef, n + 1);
+				ret |= _ref_read_(NULL, aSpi + 1, aDest + 1, n, mode);
+			}
+			aOld[mode][1] += cycles() - t0;
+
+			t0 = cycles();
+			for (i = 0; i < BENCH_LOOP; i++)
+			{
+				memcpy(aSpi, aSpiRef, n + 1);
+				ret |= adf7030_1__SPI_Xfer_ReadBuff(NULL, aSpi + 1, aDest + 1, n, mode);
+			}
+			aNew[mode][1] += cycles() - t0;
+		}
+		printf("%s 1..%u bytes x %u : copy old %llu ns, new %llu ns ; compare old %llu ns, new %llu ns\n",
+			(mode)?("word"):("byte"), (unsigned)XFER_MAX, BENCH_LOOP,
+			(unsigned long long)aOld[mode][0], (unsigned long long)aNew[mode][0],
+			(unsigned long long)aOld[mode][1], (unsigned long long)aNew[mode][1]);
+	}
+	TEST_ASSERT_EQUAL_UINT8(0, ret);
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_write_all_sizes);
+	RUN_TEST(test_read_all_sizes);
+	RUN_TEST(test_swap_in_place);
+	RUN_TEST(test_bench_all_sizes);
+	return UNITY_END();
+}
@@ -0,0 +1,111 @@
+/**
+  * @file: test_tickless.c
+  * @brief: This file hold the tickless idle time conversions unit tests.
+  *
+  *****************************************************************************
+  * @Copyright 2019, GRDF, Inc.  All rights reserved.
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted (subject to the limitations in the disclaimer
+  * below) provided that the following conditions are met:
+  *    - Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *    - Redistributions in binary form must reproduce the above copyright
+  *      notice, this list of conditions and the following disclaimer in the
+  *      documentation and/or other materials provided with the distribution.
+  *    - Neither the name of GRDF, Inc. nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  *****************************************************************************
+  *
+  * Revision history
+  * ----------------
+  * 1.0.0 : 2026/10/19[GBI]
+  * Initial version
+  *
+  *
+  */
+#include "unity.h"
+#include "tickless.h"
+
+#define LSE_HZ  32768
+#define TICK_HZ 1000
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/* One second of LPTIM cycles gives exactly 1000 ticks and no residual */
+void test_compensate_exact_second(void)
+{
+	uint32_t u32Res = 0;
+	TEST_ASSERT_EQUAL_UINT32(1000, Tickless_Compensate(LSE_HZ, 0, LSE_HZ, TICK_HZ, &u32Res));
+	TEST_ASSERT_EQUAL_UINT32(0, u32Res);
+}
+
+/* The SysTick fraction and the previous residual are added up */
+void test_compensate_frac_and_residual(void)
+{
+	uint32_t u32Res = LSE_HZ / 2;
+	// 32 cycles = 0.9765625 tick, + 0.5 (frac) + 0.5 (residual)
+	TEST_ASSERT_EQUAL_UINT32(1, Tickless_Compensate(32, LSE_HZ / 2, LSE_HZ, TICK_HZ, &u32Res));
+	TEST_ASSERT_EQUAL_UINT32(32 * TICK_HZ, u32Res);
+}
+
+/* Many short sleeps don't drift : the sum of ticks matches the total time */
+void test_compensate_no_drift(void)
+{
+	uint32_t u32Res = 0;
+	uint32_t u32Ticks = 0;
+	uint32_t i;
+	// 10000 sleeps of 7 cycles (~0.2136 ms each)
+	for (i = 0; i < 10000; i++)
+	{
+		u32Ticks += Tickless_Compensate(7, 0, LSE_HZ, TICK_HZ, &u32Res);
+	}
+	// 70000 cycles = 2136.23 ms
+	TEST_ASSERT_EQUAL_UINT32(2136, u32Ticks);
+	TEST_ASSERT_EQUAL_UINT64((uint64_t)70000 * TICK_HZ, (uint64_t)u32Ticks * LSE_HZ + u32Res);
+}
+
+/* The longest idle time (250 s at 32768 Hz) doesn't overflow */
+void test_compensate_long_idle(void)
+{
+	uint32_t u32Res = LSE_HZ - 1;
+	TEST_ASSERT_EQUAL_UINT32(250000, Tickless_Compensate(250 * LSE_HZ, 0, LSE_HZ, TICK_HZ, &u32Res));
+	TEST_ASSERT_EQUAL_UINT32(LSE_HZ - 1, u32Res);
+}
+
+/* The wake-up time is not truncated to a whole number of cycles per ms */
+void test_ticks_to_cyc(void)
+{
+	// 32768 / 1000 * 1000 would give 32000
+	TEST_ASSERT_EQUAL_UINT32(LSE_HZ, Tickless_TicksToCyc(1000, LSE_HZ, TICK_HZ));
+	TEST_ASSERT_EQUAL_UINT32(32, Tickless_TicksToCyc(1, LSE_HZ, TICK_HZ));
+	TEST_ASSERT_EQUAL_UINT32(8192000, Tickless_TicksToCyc(250000, LSE_HZ, TICK_HZ));
+}
+
+/* Converting the wake-up time back gives no more than the requested ticks */
+void test_round_trip(void)
+{
+	uint32_t u32Res = 0;
+	uint32_t u32Ticks;
+	for (u32Ticks = 1; u32Ticks < 2000; u32Ticks += 37)
+	{
+		u32Res = 0;
+		TEST_ASSERT_UINT32_WITHIN(1, u32Ticks,
+			Tickless_Compensate(Tickless_TicksToCyc(u32Ticks, LSE_HZ, TICK_HZ), 0, LSE_HZ, TICK_HZ, &u32Res) + 1);
+	}
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_compensate_exact_second);
+	RUN_TEST(test_compensate_frac_and_residual);
+	RUN_TEST(test_compensate_no_drift);
+	RUN_TEST(test_compensate_long_idle);
+	RUN_TEST(test_ticks_to_cyc);
+	RUN_TEST(test_round_trip);
+	return UNITY_END();
+}
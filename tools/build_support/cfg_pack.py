@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Pack an ADF7030-1 *.cfg image (C array body) into the compressed stream read
+by adf7030_1__SendConfiguration() when ADF7030_1_CFG_PACKED is set.
+
+Stream format :
+  - header (4 bytes) : magic (0x5A), version (0x83), raw size (16 bits, BE)
+  - LZSS bit stream (MSB first), 256 bytes window :
+      '0' + 8 bits            : literal byte
+      '1' + 8 bits + 3 bits   : copy (length - 2) bytes from (offset - 1)
+                                bytes back in the output
+
+Usage : cfg_pack.py <input.cfg> <output.cfz>
+"""
+import re
+import sys
+
+MAGIC = 0x5A
+VERSION = 0x83
+WIN_BITS = 8
+LEN_BITS = 3
+MIN_LEN = 2
+WIN_SZ = 1 << WIN_BITS
+MAX_LEN = (1 << LEN_BITS) - 1 + MIN_LEN
+
+
+def load(path):
+    with open(path, "r") as f:
+        txt = f.read()
+    txt = re.sub(r"/\*.*?\*/", "", txt, flags=re.S)
+    txt = re.sub(r"//[^\n]*", "", txt)
+    return bytes(int(x, 16) for x in re.findall(r"0x([0-9A-Fa-f]{1,2})", txt))
+
+
+def check_seq(raw):
+    pos = 0
+    while pos < len(raw):
+        length = (raw[pos] << 16) | (raw[pos + 1] << 8) | raw[pos + 2]
+        if length < 4 or length > 0xFFFF:
+            raise ValueError("bad sequence length %d at %d" % (length, pos))
+        pos += length
+    if pos != len(raw):
+        raise ValueError("truncated sequence")
+
+
+class BitWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.acc = 0
+        self.nb = 0
+
+    def put(self, val, nbits):
+        self.acc = (self.acc << nbits) | (val & ((1 << nbits) - 1))
+        self.nb += nbits
+        while self.nb >= 8:
+            self.nb -= 8
+            self.out.append((self.acc >> self.nb) & 0xFF)
+
+    def flush(self):
+        if self.nb:
+            self.out.append((self.acc << (8 - self.nb)) & 0xFF)
+            self.nb = 0
+        return bytes(self.out)
+
+
+def pack(raw):
+    bw = BitWriter()
+    i = 0
+    while i < len(raw):
+        best_len, best_off = 0, 0
+        for off in range(1, min(WIN_SZ, i) + 1):
+            k = 0
+            while i + k < len(raw) and k < MAX_LEN and raw[i + k - off] == raw[i + k]:
+                k += 1
+            if k > best_len:
+                best_len, best_off = k, off
+                if k == MAX_LEN:
+                    break
+        if best_len >= MIN_LEN:
+            bw.put(1, 1)
+            bw.put(best_off - 1, WIN_BITS)
+            bw.put(best_len - MIN_LEN, LEN_BITS)
+            i += best_len
+        else:
+            bw.put(0, 1)
+            bw.put(raw[i], 8)
+            i += 1
+    return bytes([MAGIC, VERSION, len(raw) >> 8, len(raw) & 0xFF]) + bw.flush()
+
+
+def unpack(packed):
+    size = (packed[2] << 8) | packed[3]
+    data = packed[4:]
+    out = bytearray()
+    bitpos = 0
+
+    def get(nbits):
+        nonlocal bitpos
+        val = 0
+        for _ in range(nbits):
+            val = (val << 1) | ((data[bitpos >> 3] >> (7 - (bitpos & 7))) & 1)
+            bitpos += 1
+        return val
+
+    while len(out) < size:
+        if get(1):
+            off = get(WIN_BITS) + 1
+            length = get(LEN_BITS) + MIN_LEN
+            for _ in range(length):
+                out.append(out[-off])
+        else:
+            out.append(get(8))
+    return bytes(out[:size])
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.stderr.write(__doc__)
+        return 1
+    raw = load(argv[1])
+    check_seq(raw)
+    if len(raw) > 0xFFFF:
+        raise ValueError("image too large")
+    packed = pack(raw)
+    if unpack(packed) != raw:
+        raise RuntimeError("pack/unpack mismatch")
+
+    with open(argv[2], "w") as f:
+        f.write("/*\n * %s packed from %s (%d -> %d bytes)\n*/\n"
+                % (argv[2].replace("\\", "/").split("/")[-1],
+                   argv[1].replace("\\", "/").split("/")[-1],
+                   len(raw), len(packed)))
+        for n in range(0, len(packed), 16):
+            f.write("\t\t" + " ".join("0x%02X," % b for b in packed[n:n + 16]) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -72,6 +72,13 @@ if(BUILD_OPENWIZE)
     add_subdirectory(third-party/libraries/OpenWize)
 endif(BUILD_OPENWIZE)
 
+# host unit tests
+if(BUILD_TEST)
+    message(STATUS "Add Tests Build ")
+    enable_testing()
+    add_subdirectory(${TOP_DIR}/tests ${CMAKE_BINARY_DIR}/tests)
+endif(BUILD_TEST)
+
 #################################################################################
 # distclean target
 set(cmake_generated ${CMAKE_BINARY_DIR}/CMakeCache.txt